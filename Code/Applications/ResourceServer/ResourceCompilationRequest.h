@@ -1,5 +1,6 @@
 #pragma once
 #include "System/Resource/ResourceID.h"
+#include "System/Resource/ResourceCompression.h"
 #include "System/Time/Time.h"
 #include "System/Types/UUID.h"
 #include "System/Time/Timestamp.h"
@@ -95,6 +96,7 @@ namespace EE::Resource
         FileSystem::Path                    m_sourceFile;
         FileSystem::Path                    m_destinationFile;
         String                              m_compilerArgs;
+        CompressionType                     m_compressionType = CompressionType::None;
 
         TimeStamp                           m_timeRequested;
         Nanoseconds                         m_compilationTimeStarted = 0;
@@ -4,9 +4,11 @@
 #include "Engine/Entity/EntityDescriptors.h"
 #include "Engine/Entity/EntitySerialization.h"
 #include "System/Resource/ResourceProviders/ResourceNetworkMessages.h"
+#include "System/Resource/ResourcePackage.h"
 #include "System/IniFile.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileSystemUtils.h"
+#include "System/Log.h"
 
 #include <sstream>
 
@@ -240,6 +242,7 @@ namespace EE::Resource
         {
             if ( m_completedPackagingRequests.size() == m_resourcesToBePackaged.size() )
             {
+                WriteResourcePackage();
                 m_resourcesToBePackaged.clear();
                 m_completedPackagingRequests.clear();
                 m_isPackaging = false;
@@ -365,6 +368,10 @@ namespace EE::Resource
                     pRequest->m_log.sprintf( "Error: No compiler found for resource type (%s)!", pRequest->m_resourceID.ToString().c_str() );
                     pRequest->m_status = CompilationRequest::Status::Failed;
                 }
+                else
+                {
+                    pRequest->m_compressionType = pCompiler->GetCompressionType();
+                }
 
                 // File Validity check
                 bool sourceFileExists = false;
@@ -772,6 +779,42 @@ namespace EE::Resource
         m_mapsToBePackaged.erase_first_unsorted( mapResourceID );
     }
 
+    void ResourceServer::WriteResourcePackage()
+    {
+        ResourcePackageWriter packageWriter;
+        for ( auto const& resourceID : m_resourcesToBePackaged )
+        {
+            // Virtual resources have no compiled data
+            if ( m_pCompilerRegistry->IsVirtualResourceType( resourceID.GetResourceTypeID() ) )
+            {
+                continue;
+            }
+
+            FileSystem::Path const compiledFilePath = ResourcePath::ToFileSystemPath( m_settings.m_packagedBuildCompiledResourcePath, resourceID.GetResourcePath() );
+            if ( !FileSystem::Exists( compiledFilePath ) )
+            {
+                EE_LOG_ERROR( "Resource", "Packaging", "Compiled resource missing, it will not be added to the package: %s", resourceID.c_str() );
+                continue;
+            }
+
+            packageWriter.AddResource( resourceID, compiledFilePath );
+        }
+
+        //-------------------------------------------------------------------------
+
+        FileSystem::Path const packagePath = m_settings.m_packagedBuildCompiledResourcePath + ResourcePackage::s_defaultFilename;
+
+        String errorLog;
+        if ( packageWriter.Write( packagePath, errorLog ) )
+        {
+            EE_LOG_MESSAGE( "Resource", "Packaging", "Wrote resource package with %d resources: %s", packageWriter.GetNumResources(), packagePath.c_str() );
+        }
+        else
+        {
+            EE_LOG_ERROR( "Resource", "Packaging", "Failed to write resource package: %s", errorLog.c_str() );
+        }
+    }
+
     void ResourceServer::EnqueueResourceForPackaging( ResourceID const& resourceID )
     {
         auto pCompiler = m_pCompilerRegistry->GetCompilerForResourceType( resourceID.GetResourceTypeID() );
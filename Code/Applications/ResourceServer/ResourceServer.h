@@ -133,6 +133,9 @@ namespace EE::Resource
 
         void EnqueueResourceForPackaging( ResourceID const& resourceID );
 
+        // Combine all the packaged compiled resources into a single resource package
+        void WriteResourcePackage();
+
     private:
 
         TypeSystem::TypeRegistry                m_typeRegistry;
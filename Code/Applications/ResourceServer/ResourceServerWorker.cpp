@@ -1,4 +1,7 @@
 #include "ResourceServerWorker.h"
+#include "System/Resource/ResourceHeader.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/FileStreams.h"
 
 //-------------------------------------------------------------------------
 
@@ -107,10 +110,101 @@ namespace EE::Resource
             m_pRequest->m_log += readBuffer;
         }
 
+        // Compress compiled resource
+        //-------------------------------------------------------------------------
+
+        if ( m_pRequest->HasSucceeded() && m_pRequest->m_compressionType != CompressionType::None )
+        {
+            if ( !CompressCompiledResource() )
+            {
+                m_pRequest->m_status = CompilationRequest::Status::Failed;
+            }
+        }
+
         m_status = Status::Complete;
 
         //-------------------------------------------------------------------------
 
         subprocess_destroy( &m_subProcess );
     }
+
+    bool ResourceServerWorker::CompressCompiledResource()
+    {
+        FileSystem::Path const& filePath = m_pRequest->m_destinationFile;
+
+        Blob fileData;
+        if ( !FileSystem::LoadFile( filePath, fileData ) )
+        {
+            m_pRequest->m_log.append_sprintf( "\nError: Failed to read compiled resource for compression (%s)", filePath.c_str() );
+            return false;
+        }
+
+        Serialization::BinaryInputArchive archive;
+        archive.ReadFromBlob( fileData );
+
+        ResourceHeader header;
+        archive << header;
+
+        if ( header.IsCompressed() )
+        {
+            return true;
+        }
+
+        // The binary format is deterministic, so re-serializing the header tells us where the resource data starts
+        //-------------------------------------------------------------------------
+
+        Serialization::BinaryOutputArchive uncompressedHeaderArchive;
+        uncompressedHeaderArchive << header;
+        size_t const headerSize = uncompressedHeaderArchive.GetBinaryDataSize();
+        if ( headerSize > fileData.size() || memcmp( uncompressedHeaderArchive.GetBinaryData(), fileData.data(), headerSize ) != 0 )
+        {
+            m_pRequest->m_log.append_sprintf( "\nError: Failed to read compiled resource header for compression (%s)", filePath.c_str() );
+            return false;
+        }
+
+        uint8_t const* pResourceData = fileData.data() + headerSize;
+        size_t const resourceDataSize = fileData.size() - headerSize;
+
+        Blob compressedData;
+        Compression::Compress( m_pRequest->m_compressionType, pResourceData, resourceDataSize, compressedData );
+
+        // Leave the resource as is if compression doesnt save anything
+        if ( compressedData.size() >= resourceDataSize )
+        {
+            return true;
+        }
+
+        // Ensure that the compressed data round trips before we overwrite the compiled resource
+        Blob decompressedData;
+        decompressedData.resize( resourceDataSize );
+        if ( !Compression::Decompress( compressedData.data(), compressedData.size(), decompressedData.data(), decompressedData.size() ) || memcmp( decompressedData.data(), pResourceData, resourceDataSize ) != 0 )
+        {
+            m_pRequest->m_log.append_sprintf( "\nError: Compressed resource data doesnt match the compiled data after decompression (%s)", filePath.c_str() );
+            return false;
+        }
+
+        // Write compressed resource
+        //-------------------------------------------------------------------------
+
+        header.m_compressionType = m_pRequest->m_compressionType;
+        header.m_compressedSize = (uint32_t) compressedData.size();
+        header.m_uncompressedSize = (uint32_t) resourceDataSize;
+
+        Serialization::BinaryOutputArchive compressedHeaderArchive;
+        compressedHeaderArchive << header;
+
+        FileSystem::OutputFileStream file( filePath );
+        if ( !file.IsValid() )
+        {
+            m_pRequest->m_log.append_sprintf( "\nError: Failed to write compressed resource (%s)", filePath.c_str() );
+            return false;
+        }
+
+        file.Write( compressedHeaderArchive.GetBinaryData(), compressedHeaderArchive.GetBinaryDataSize() );
+        file.Write( compressedData.data(), compressedData.size() );
+        file.Close();
+
+        m_pRequest->m_log.append_sprintf( "\nCompressed resource (%s): %.2fKB -> %.2fKB", Compression::GetCompressionTypeName( header.m_compressionType ), resourceDataSize / 1024.0f, compressedData.size() / 1024.0f );
+        return true;
+    }
 }
\ No newline at end of file
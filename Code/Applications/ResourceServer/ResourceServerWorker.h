@@ -61,6 +61,9 @@ namespace EE::Resource
 
         virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final;
 
+        // Compress the compiled resource in place, according to the compression type of the request
+        bool CompressCompiledResource();
+
     private:
 
         TaskSystem*                             m_pTaskSystem = nullptr;
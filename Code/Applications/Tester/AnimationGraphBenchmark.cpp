@@ -0,0 +1,596 @@
+#include "AnimationGraphBenchmark.h"
+#include "Engine/Animation/ResourceLoaders/AnimationSkeletonLoader.h"
+#include "Engine/Animation/ResourceLoaders/AnimationBoneMaskLoader.h"
+#include "Engine/Animation/ResourceLoaders/AnimationClipLoader.h"
+#include "Engine/Animation/ResourceLoaders/AnimationGraphLoader.h"
+#include "Engine/Animation/ResourceLoaders/AnimationMotionDatabaseLoader.h"
+#include "Engine/Animation/Graph/Animation_RuntimeGraph_Instance.h"
+#include "Engine/Animation/AnimationBlender.h"
+#include "Engine/Animation/AnimationClip.h"
+#include "Engine/Animation/AnimationPose.h"
+#include "System/Resource/ResourceProviders/PackagedResourceProvider.h"
+#include "System/Resource/ResourceSettings.h"
+#include "System/Resource/ResourceSystem.h"
+#include "System/Threading/TaskSystem.h"
+#include "System/Time/Timers.h"
+#include "System/Log.h"
+#include <eastl/sort.h>
+#include <iostream>
+
+//-------------------------------------------------------------------------
+
+namespace EE
+{
+    // The SIMD decoding performs the same operations as the scalar decoding so we expect identical results,
+    // this tolerance only exists to absorb differences in instruction selection (e.g. FMA contraction) between the two paths
+    static float const g_decodeErrorTolerance = 1.0e-5f;
+
+    static bool IsBitExact( Transform const& a, Transform const& b )
+    {
+        Float4 const aRotation = a.GetRotation().ToVector().ToFloat4();
+        Float4 const bRotation = b.GetRotation().ToVector().ToFloat4();
+        Float3 const aTranslation = a.GetTranslation().ToFloat3();
+        Float3 const bTranslation = b.GetTranslation().ToFloat3();
+        float const aScale = a.GetScale();
+        float const bScale = b.GetScale();
+
+        return memcmp( &aRotation, &bRotation, sizeof( Float4 ) ) == 0 && memcmp( &aTranslation, &bTranslation, sizeof( Float3 ) ) == 0 && memcmp( &aScale, &bScale, sizeof( float ) ) == 0;
+    }
+
+    static float GetMaxComponentError( Transform const& a, Transform const& b )
+    {
+        Vector const rotationError = ( a.GetRotation().ToVector() - b.GetRotation().ToVector() ).Abs();
+        Vector const translationError = ( a.GetTranslation() - b.GetTranslation() ).Abs();
+        float const scaleError = Math::Abs( a.GetScale() - b.GetScale() );
+
+        float maxError = scaleError;
+        maxError = Math::Max( maxError, Math::Max( Math::Max( rotationError.GetX(), rotationError.GetY() ), Math::Max( rotationError.GetZ(), rotationError.GetW() ) ) );
+        maxError = Math::Max( maxError, Math::Max( Math::Max( translationError.GetX(), translationError.GetY() ), translationError.GetZ() ) );
+        return maxError;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AnimationGraphBenchmark::StageTimings::WriteStats( Serialization::JsonWriter& writer, char const* pName ) const
+    {
+        EE_ASSERT( !m_samples.empty() );
+
+        TVector<Microseconds> sortedSamples = m_samples;
+        eastl::sort( sortedSamples.begin(), sortedSamples.end() );
+
+        float total = 0.0f;
+        for ( auto const& sample : sortedSamples )
+        {
+            total += sample.ToFloat();
+        }
+
+        int32_t const numSamples = (int32_t) sortedSamples.size();
+        int32_t const p95Idx = Math::Min( (int32_t) ( numSamples * 0.95f ), numSamples - 1 );
+
+        writer.Key( pName );
+        writer.StartObject();
+        writer.Key( "Mean" );
+        writer.Double( total / numSamples );
+        writer.Key( "Min" );
+        writer.Double( sortedSamples.front().ToFloat() );
+        writer.Key( "Max" );
+        writer.Double( sortedSamples.back().ToFloat() );
+        writer.Key( "P95" );
+        writer.Double( sortedSamples[p95Idx].ToFloat() );
+        writer.EndObject();
+    }
+
+    //-------------------------------------------------------------------------
+
+    AnimationGraphBenchmark::AnimationGraphBenchmark( TypeSystem::TypeRegistry const& typeRegistry, Settings const& settings )
+        : m_typeRegistry( typeRegistry )
+        , m_settings( settings )
+        , m_rng( settings.m_seed )
+    {
+        EE_ASSERT( m_settings.m_graphVariationID.IsValid() );
+        EE_ASSERT( m_settings.m_numInstances > 0 && m_settings.m_numFrames > 0 && m_settings.m_numWarmupFrames >= 0 );
+        EE_ASSERT( m_settings.m_parameterRandomizationPeriod > 0 && m_settings.m_numBlendIterations > 0 );
+    }
+
+    bool AnimationGraphBenchmark::Run()
+    {
+        TaskSystem taskSystem;
+        taskSystem.Initialize();
+        m_pTaskSystem = m_settings.m_useTaskSystem ? &taskSystem : nullptr;
+
+        // Create the resource system, only the animation resources are loadable
+        //-------------------------------------------------------------------------
+
+        Resource::ResourceSettings resourceSettings;
+        resourceSettings.m_compiledResourcePath = m_settings.m_compiledResourcePath;
+
+        Resource::PackagedResourceProvider resourceProvider( resourceSettings );
+        Resource::ResourceProvider* pResourceProvider = &resourceProvider;
+        pResourceProvider->Initialize();
+
+        Resource::ResourceSystem resourceSystem( taskSystem );
+        resourceSystem.Initialize( pResourceProvider );
+
+        Animation::SkeletonLoader skeletonLoader;
+        Animation::BoneMaskLoader boneMaskLoader;
+        Animation::AnimationClipLoader animationClipLoader;
+        Animation::GraphLoader graphLoader;
+        Animation::MotionDatabaseLoader motionDatabaseLoader;
+
+        animationClipLoader.SetTypeRegistryPtr( &m_typeRegistry );
+        graphLoader.SetTypeRegistryPtr( &m_typeRegistry );
+
+        resourceSystem.RegisterResourceLoader( &skeletonLoader );
+        resourceSystem.RegisterResourceLoader( &boneMaskLoader );
+        resourceSystem.RegisterResourceLoader( &animationClipLoader );
+        resourceSystem.RegisterResourceLoader( &graphLoader );
+        resourceSystem.RegisterResourceLoader( &motionDatabaseLoader );
+
+        // Load the graph and run the benchmark
+        //-------------------------------------------------------------------------
+
+        TResourcePtr<Animation::GraphVariation> graphVariation( m_settings.m_graphVariationID );
+        resourceSystem.LoadResource( graphVariation );
+        resourceSystem.WaitForAllRequestsToComplete();
+
+        bool result = graphVariation.IsLoaded();
+        if ( result )
+        {
+            Animation::GraphVariation const* pGraphVariation = graphVariation.GetPtr();
+
+            m_graphInstances.reserve( m_settings.m_numInstances );
+            for ( int32_t i = 0; i < m_settings.m_numInstances; i++ )
+            {
+                auto pGraphInstance = m_graphInstances.emplace_back( EE::New<Animation::GraphInstance>( pGraphVariation, uint64_t( i ) ) );
+                RandomizeControlParameters( pGraphInstance );
+            }
+
+            m_pScratchPose = EE::New<Animation::Pose>( pGraphVariation->GetSkeleton() );
+
+            //-------------------------------------------------------------------------
+
+            for ( int32_t i = 0; i < m_settings.m_numWarmupFrames; i++ )
+            {
+                RunFrame( false );
+            }
+
+            m_graphUpdateTimings.Reset( m_settings.m_numFrames );
+            m_taskExecutionTimings.Reset( m_settings.m_numFrames );
+            m_globalTransformTimings.Reset( m_settings.m_numFrames );
+            m_frameTimings.Reset( m_settings.m_numFrames );
+            m_allocationsPerFrame.clear();
+            m_allocationsPerFrame.reserve( m_settings.m_numFrames );
+
+            #if EE_DEVELOPMENT_TOOLS
+            bool const wasAllocationTrackingEnabled = Memory::IsAllocationTrackingEnabled();
+            Memory::SetAllocationTrackingEnabled( true );
+            #endif
+
+            for ( int32_t i = 0; i < m_settings.m_numFrames; i++ )
+            {
+                RunFrame( true );
+            }
+
+            #if EE_DEVELOPMENT_TOOLS
+            Memory::SetAllocationTrackingEnabled( wasAllocationTrackingEnabled );
+            #endif
+
+            RunBlendBenchmarks( pGraphVariation );
+            bool const decodeResult = RunClipDecodeBenchmarks( pGraphVariation );
+            result = WriteResults( pGraphVariation ) && decodeResult;
+
+            //-------------------------------------------------------------------------
+
+            EE::Delete( m_pScratchPose );
+
+            for ( auto& pGraphInstance : m_graphInstances )
+            {
+                EE::Delete( pGraphInstance );
+            }
+            m_graphInstances.clear();
+        }
+        else
+        {
+            EE_LOG_ERROR( "Animation", "Graph Benchmark", "Failed to load graph variation: %s", m_settings.m_graphVariationID.c_str() );
+        }
+
+        // Shutdown
+        //-------------------------------------------------------------------------
+
+        resourceSystem.UnloadResource( graphVariation );
+        resourceSystem.WaitForAllRequestsToComplete();
+
+        resourceSystem.UnregisterResourceLoader( &motionDatabaseLoader );
+        resourceSystem.UnregisterResourceLoader( &graphLoader );
+        resourceSystem.UnregisterResourceLoader( &animationClipLoader );
+        resourceSystem.UnregisterResourceLoader( &boneMaskLoader );
+        resourceSystem.UnregisterResourceLoader( &skeletonLoader );
+
+        graphLoader.ClearTypeRegistryPtr();
+        animationClipLoader.ClearTypeRegistryPtr();
+
+        resourceSystem.Shutdown();
+        pResourceProvider->Shutdown();
+
+        m_pTaskSystem = nullptr;
+        taskSystem.Shutdown();
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AnimationGraphBenchmark::RandomizeControlParameters( Animation::GraphInstance* pGraphInstance )
+    {
+        int32_t const numParameters = pGraphInstance->GetNumControlParameters();
+        for ( int16_t i = 0; i < numParameters; i++ )
+        {
+            switch ( pGraphInstance->GetControlParameterType( i ) )
+            {
+                case Animation::GraphValueType::Bool:
+                {
+                    pGraphInstance->SetControlParameterValue<bool>( i, m_rng.GetUInt( 0, 1 ) == 1 );
+                }
+                break;
+
+                case Animation::GraphValueType::Int:
+                {
+                    pGraphInstance->SetControlParameterValue<int32_t>( i, (int32_t) m_rng.GetUInt( 0, 10 ) );
+                }
+                break;
+
+                case Animation::GraphValueType::Float:
+                {
+                    pGraphInstance->SetControlParameterValue<float>( i, m_rng.GetFloat( 0.0f, 1.0f ) );
+                }
+                break;
+
+                case Animation::GraphValueType::Vector:
+                {
+                    pGraphInstance->SetControlParameterValue<Vector>( i, Vector( m_rng.GetFloat( -1.0f, 1.0f ), m_rng.GetFloat( -1.0f, 1.0f ), 0.0f ) );
+                }
+                break;
+
+                // IDs, targets and bone masks are graph specific so we leave them at their default values
+                default:
+                break;
+            }
+        }
+    }
+
+    void AnimationGraphBenchmark::RunFrame( bool recordTimings )
+    {
+        if ( m_frameIdx > 0 && ( m_frameIdx % m_settings.m_parameterRandomizationPeriod ) == 0 )
+        {
+            for ( auto pGraphInstance : m_graphInstances )
+            {
+                RandomizeControlParameters( pGraphInstance );
+            }
+        }
+
+        m_frameIdx++;
+
+        //-------------------------------------------------------------------------
+
+        #if EE_DEVELOPMENT_TOOLS
+        uint64_t const numAllocationsAtFrameStart = Memory::GetNumAllocations();
+        #endif
+
+        Timer<PlatformClock> frameTimer;
+
+        // Graph update
+        Timer<PlatformClock> stageTimer;
+        for ( auto pGraphInstance : m_graphInstances )
+        {
+            pGraphInstance->EvaluateGraph( m_settings.m_deltaTime, Transform::Identity, nullptr );
+        }
+        Microseconds const graphUpdateTime = stageTimer.GetElapsedTimeMicroseconds();
+
+        // Task execution, this includes the global transform calculation done at the end of the post-physics tasks
+        stageTimer.Start();
+        for ( auto pGraphInstance : m_graphInstances )
+        {
+            pGraphInstance->ExecutePrePhysicsPoseTasks( Transform::Identity, m_pTaskSystem );
+            pGraphInstance->ExecutePostPhysicsPoseTasks( m_pTaskSystem );
+        }
+        Microseconds const taskExecutionTime = stageTimer.GetElapsedTimeMicroseconds();
+
+        Microseconds const frameTime = frameTimer.GetElapsedTimeMicroseconds();
+
+        #if EE_DEVELOPMENT_TOOLS
+        uint64_t const numAllocations = Memory::GetNumAllocations() - numAllocationsAtFrameStart;
+        #else
+        uint64_t const numAllocations = 0;
+        #endif
+
+        // Global transforms are measured in isolation on a copy of each final pose so that they arent hidden in the task cost
+        Microseconds globalTransformsTime = 0.0f;
+        for ( auto pGraphInstance : m_graphInstances )
+        {
+            m_pScratchPose->CopyFrom( pGraphInstance->GetPose() );
+            stageTimer.Start();
+            m_pScratchPose->CalculateGlobalTransforms();
+            globalTransformsTime += stageTimer.GetElapsedTimeMicroseconds();
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( recordTimings )
+        {
+            m_graphUpdateTimings.m_samples.emplace_back( graphUpdateTime );
+            m_taskExecutionTimings.m_samples.emplace_back( taskExecutionTime );
+            m_globalTransformTimings.m_samples.emplace_back( globalTransformsTime );
+            m_frameTimings.m_samples.emplace_back( frameTime );
+            m_allocationsPerFrame.emplace_back( numAllocations );
+        }
+    }
+
+    void AnimationGraphBenchmark::RunBlendBenchmarks( Animation::GraphVariation const* pGraphVariation )
+    {
+        Animation::Skeleton const* pSkeleton = pGraphVariation->GetSkeleton();
+        Animation::Pose sourcePose( pSkeleton, Animation::Pose::Type::ReferencePose );
+        Animation::Pose targetPose( pSkeleton );
+        Animation::Pose resultPose( pSkeleton );
+        targetPose.CopyFrom( m_graphInstances[0]->GetPose() );
+
+        float const numIterations = (float) m_settings.m_numBlendIterations;
+
+        Timer<PlatformClock> timer;
+        for ( int32_t i = 0; i < m_settings.m_numBlendIterations; i++ )
+        {
+            Animation::Blender::Blend( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.5f, TBitFlags<Animation::PoseBlendOptions>(), nullptr, &resultPose );
+        }
+        m_localBlendTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+        timer.Start();
+        for ( int32_t i = 0; i < m_settings.m_numBlendIterations; i++ )
+        {
+            Animation::Blender::Blend( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.5f, TBitFlags<Animation::PoseBlendOptions>( Animation::PoseBlendOptions::GlobalSpace ), nullptr, &resultPose );
+        }
+        m_globalBlendTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+        timer.Start();
+        for ( int32_t i = 0; i < m_settings.m_numBlendIterations; i++ )
+        {
+            resultPose.CalculateGlobalTransforms();
+        }
+        m_calculateGlobalTransformsTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+        timer.Start();
+        for ( int32_t i = 0; i < m_settings.m_numBlendIterations; i++ )
+        {
+            resultPose.CalculateGlobalTransformsScalar();
+        }
+        m_calculateGlobalTransformsScalarTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+    }
+
+    bool AnimationGraphBenchmark::RunClipDecodeBenchmarks( Animation::GraphVariation const* pGraphVariation )
+    {
+        m_numDecodedClips = 0;
+        m_numDecodedTransforms = 0;
+        m_numBitExactDecodedTransforms = 0;
+        m_numDecodeMismatches = 0;
+        m_maxDecodeError = 0.0f;
+        m_decodeTimeSIMD = 0.0f;
+        m_decodeTimeScalar = 0.0f;
+
+        int32_t numSampledPoses = 0;
+
+        for ( auto const& resourcePtr : pGraphVariation->GetDataSet()->GetResources() )
+        {
+            if ( !resourcePtr.IsSet() || !resourcePtr.IsLoaded() || resourcePtr.GetResourceTypeID() != Animation::AnimationClip::GetStaticResourceTypeID() )
+            {
+                continue;
+            }
+
+            TResourcePtr<Animation::AnimationClip> const clipPtr( resourcePtr );
+            Animation::AnimationClip const* pClip = clipPtr.GetPtr();
+            Animation::Skeleton const* pSkeleton = pClip->GetSkeleton();
+            int32_t const numBones = pSkeleton->GetNumBones();
+
+            // Sample every key frame as well as half way between every pair of key frames so that we test the interpolation
+            TInlineVector<Animation::FrameTime, 128> sampleTimes;
+            uint32_t const numFrames = pClip->GetNumFrames();
+            for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+            {
+                sampleTimes.emplace_back( Animation::FrameTime( frameIdx ) );
+                if ( ( frameIdx + 1 ) < numFrames )
+                {
+                    sampleTimes.emplace_back( Animation::FrameTime( frameIdx, Percentage( 0.5f ) ) );
+                }
+            }
+
+            // Validate
+            //-------------------------------------------------------------------------
+
+            Animation::Pose simdPose( pSkeleton );
+            Animation::Pose scalarPose( pSkeleton );
+
+            int32_t numMismatches = 0;
+            for ( auto const& sampleTime : sampleTimes )
+            {
+                pClip->GetPose( sampleTime, &simdPose );
+                pClip->GetPoseScalar( sampleTime, &scalarPose );
+
+                for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+                {
+                    Transform const& simdTransform = simdPose.GetTransform( boneIdx );
+                    Transform const& scalarTransform = scalarPose.GetTransform( boneIdx );
+
+                    if ( IsBitExact( simdTransform, scalarTransform ) )
+                    {
+                        m_numBitExactDecodedTransforms++;
+                    }
+                    else
+                    {
+                        float const error = GetMaxComponentError( simdTransform, scalarTransform );
+                        m_maxDecodeError = Math::Max( m_maxDecodeError, error );
+                        if ( error > g_decodeErrorTolerance )
+                        {
+                            numMismatches++;
+                        }
+                    }
+                }
+
+                m_numDecodedTransforms += numBones;
+            }
+
+            if ( numMismatches > 0 )
+            {
+                EE_LOG_ERROR( "Animation", "Graph Benchmark", "SIMD and scalar decoding differ for %d transforms in clip: %s", numMismatches, clipPtr.GetResourceID().c_str() );
+                m_numDecodeMismatches += numMismatches;
+            }
+
+            // Time
+            //-------------------------------------------------------------------------
+
+            Timer<PlatformClock> timer;
+            for ( int32_t i = 0; i < m_settings.m_numDecodeIterations; i++ )
+            {
+                for ( auto const& sampleTime : sampleTimes )
+                {
+                    pClip->GetPose( sampleTime, &simdPose );
+                }
+            }
+            m_decodeTimeSIMD += timer.GetElapsedTimeMicroseconds();
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numDecodeIterations; i++ )
+            {
+                for ( auto const& sampleTime : sampleTimes )
+                {
+                    pClip->GetPoseScalar( sampleTime, &scalarPose );
+                }
+            }
+            m_decodeTimeScalar += timer.GetElapsedTimeMicroseconds();
+
+            numSampledPoses += (int32_t) sampleTimes.size() * m_settings.m_numDecodeIterations;
+            m_numDecodedClips++;
+        }
+
+        if ( numSampledPoses > 0 )
+        {
+            m_decodeTimeSIMD = m_decodeTimeSIMD / float( numSampledPoses );
+            m_decodeTimeScalar = m_decodeTimeScalar / float( numSampledPoses );
+        }
+
+        return m_numDecodeMismatches == 0;
+    }
+
+    bool AnimationGraphBenchmark::WriteResults( Animation::GraphVariation const* pGraphVariation )
+    {
+        #if EE_DEVELOPMENT_TOOLS
+        uint64_t totalAllocations = 0;
+        uint64_t maxAllocations = 0;
+        for ( auto numAllocations : m_allocationsPerFrame )
+        {
+            totalAllocations += numAllocations;
+            maxAllocations = Math::Max( maxAllocations, numAllocations );
+        }
+        #endif
+
+        //-------------------------------------------------------------------------
+
+        Serialization::JsonArchiveWriter archive;
+        auto& writer = *archive.GetWriter();
+
+        writer.StartObject();
+
+        writer.Key( "Graph" );
+        writer.String( m_settings.m_graphVariationID.c_str() );
+        writer.Key( "NumBones" );
+        writer.Int( pGraphVariation->GetSkeleton()->GetNumBones() );
+        writer.Key( "NumInstances" );
+        writer.Int( m_settings.m_numInstances );
+        writer.Key( "NumFrames" );
+        writer.Int( m_settings.m_numFrames );
+        writer.Key( "DeltaTime" );
+        writer.Double( m_settings.m_deltaTime.ToFloat() );
+        writer.Key( "Seed" );
+        writer.Uint( m_settings.m_seed );
+        writer.Key( "Parallel" );
+        writer.Bool( m_settings.m_useTaskSystem );
+
+        // All stage timings are in microseconds for all instances in a frame
+        writer.Key( "Stages" );
+        writer.StartObject();
+        m_graphUpdateTimings.WriteStats( writer, "GraphUpdate" );
+        m_taskExecutionTimings.WriteStats( writer, "TaskExecution" );
+        m_globalTransformTimings.WriteStats( writer, "GlobalTransforms" );
+        m_frameTimings.WriteStats( writer, "Frame" );
+        writer.EndObject();
+
+        // The allocator only counts allocations in development builds, so explicitly flag when the counts are missing
+        #if EE_DEVELOPMENT_TOOLS
+        bool const areAllocationCountsAvailable = !m_allocationsPerFrame.empty();
+        #else
+        bool const areAllocationCountsAvailable = false;
+        #endif
+
+        writer.Key( "AllocationsPerFrame" );
+        writer.StartObject();
+        writer.Key( "Available" );
+        writer.Bool( areAllocationCountsAvailable );
+        #if EE_DEVELOPMENT_TOOLS
+        if ( areAllocationCountsAvailable )
+        {
+            writer.Key( "Mean" );
+            writer.Double( double( totalAllocations ) / m_allocationsPerFrame.size() );
+            writer.Key( "Max" );
+            writer.Uint64( maxAllocations );
+        }
+        #endif
+        writer.EndObject();
+
+        // Per call timings in microseconds
+        writer.Key( "Operations" );
+        writer.StartObject();
+        writer.Key( "LocalSpaceBlend" );
+        writer.Double( m_localBlendTime.ToFloat() );
+        writer.Key( "GlobalSpaceBlend" );
+        writer.Double( m_globalBlendTime.ToFloat() );
+        writer.Key( "CalculateGlobalTransforms" );
+        writer.Double( m_calculateGlobalTransformsTime.ToFloat() );
+        writer.Key( "CalculateGlobalTransformsScalar" );
+        writer.Double( m_calculateGlobalTransformsScalarTime.ToFloat() );
+        writer.EndObject();
+
+        // Comparison of the SIMD clip decoding against the scalar reference, timings are per sampled pose in microseconds
+        writer.Key( "ClipDecode" );
+        writer.StartObject();
+        writer.Key( "NumClips" );
+        writer.Int( m_numDecodedClips );
+        writer.Key( "NumTransforms" );
+        writer.Int( m_numDecodedTransforms );
+        writer.Key( "NumBitExactTransforms" );
+        writer.Int( m_numBitExactDecodedTransforms );
+        writer.Key( "NumMismatches" );
+        writer.Int( m_numDecodeMismatches );
+        writer.Key( "MaxError" );
+        writer.Double( m_maxDecodeError );
+        writer.Key( "SIMD" );
+        writer.Double( m_decodeTimeSIMD.ToFloat() );
+        writer.Key( "Scalar" );
+        writer.Double( m_decodeTimeScalar.ToFloat() );
+        writer.EndObject();
+
+        writer.EndObject();
+
+        //-------------------------------------------------------------------------
+
+        if ( m_settings.m_outputPath.IsValid() )
+        {
+            if ( !archive.WriteToFile( m_settings.m_outputPath ) )
+            {
+                EE_LOG_ERROR( "Animation", "Graph Benchmark", "Failed to write results to: %s", m_settings.m_outputPath.c_str() );
+                return false;
+            }
+        }
+        else
+        {
+            std::cout << archive.GetStringBuffer().GetString() << std::endl;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "System/Resource/ResourceID.h"
+#include "System/Serialization/JsonSerialization.h"
+#include "System/FileSystem/FileSystemPath.h"
+#include "System/Math/MathRandom.h"
+#include "System/Time/Time.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE { class TaskSystem; }
+namespace EE::TypeSystem { class TypeRegistry; }
+namespace EE::Animation { class GraphInstance; class GraphVariation; class Pose; }
+
+//-------------------------------------------------------------------------
+// Animation Graph Benchmark
+//-------------------------------------------------------------------------
+// Headless benchmark of the animation graph runtime, no renderer or physics scene is created
+// Loads a compiled graph variation (and its skeleton, clips, bone masks and motion databases) from the compiled data folder,
+// creates N graph instances with randomized control parameters and times every stage of the evaluation
+// The results are written out as JSON so that they can be compared between runs
+//
+// Note: Since there is no physics scene, any graph that relies on physics nodes can not be benchmarked
+
+namespace EE
+{
+    class AnimationGraphBenchmark
+    {
+        struct StageTimings
+        {
+            void Reset( int32_t numFrames ) { m_samples.clear(); m_samples.reserve( numFrames ); }
+            void WriteStats( Serialization::JsonWriter& writer, char const* pName ) const;
+
+            TVector<Microseconds>               m_samples;
+        };
+
+    public:
+
+        struct Settings
+        {
+            ResourceID                          m_graphVariationID;
+            FileSystem::Path                    m_compiledResourcePath;
+            FileSystem::Path                    m_outputPath;                       // If not set, the results are printed to stdout
+            int32_t                             m_numInstances = 100;
+            int32_t                             m_numWarmupFrames = 30;
+            int32_t                             m_numFrames = 300;
+            int32_t                             m_parameterRandomizationPeriod = 30; // Every N frames, each instance's control parameters are re-randomized
+            int32_t                             m_numBlendIterations = 1000;
+            int32_t                             m_numDecodeIterations = 10;         // Number of times every frame of every clip is decoded when comparing the SIMD and scalar clip decoding
+            Seconds                             m_deltaTime = 1.0f / 30.0f;
+            uint32_t                            m_seed = 0;
+            bool                                m_useTaskSystem = true;             // Should the pose tasks be allowed to execute in parallel
+        };
+
+    public:
+
+        AnimationGraphBenchmark( TypeSystem::TypeRegistry const& typeRegistry, Settings const& settings );
+
+        // Load the resources, run the benchmark and write out the results - returns false if the graph could not be loaded
+        bool Run();
+
+    private:
+
+        void RandomizeControlParameters( Animation::GraphInstance* pGraphInstance );
+        void RunFrame( bool recordTimings );
+        void RunBlendBenchmarks( Animation::GraphVariation const* pGraphVariation );
+        bool RunClipDecodeBenchmarks( Animation::GraphVariation const* pGraphVariation );
+        bool WriteResults( Animation::GraphVariation const* pGraphVariation );
+
+    private:
+
+        TypeSystem::TypeRegistry const&         m_typeRegistry;
+        Settings                                m_settings;
+        Math::RNG                               m_rng;
+        TaskSystem*                             m_pTaskSystem = nullptr;
+        TVector<Animation::GraphInstance*>      m_graphInstances;
+        Animation::Pose*                        m_pScratchPose = nullptr;
+        int32_t                                 m_frameIdx = 0;
+
+        StageTimings                            m_graphUpdateTimings;
+        StageTimings                            m_taskExecutionTimings;
+        StageTimings                            m_globalTransformTimings;
+        StageTimings                            m_frameTimings;
+        TVector<uint64_t>                       m_allocationsPerFrame;
+
+        Microseconds                            m_localBlendTime = 0.0f;
+        Microseconds                            m_globalBlendTime = 0.0f;
+        Microseconds                            m_calculateGlobalTransformsTime = 0.0f;
+        Microseconds                            m_calculateGlobalTransformsScalarTime = 0.0f;   // The bone by bone reference loop, for comparison against the depth level evaluation
+
+        // Clip decoding, timings are per sampled pose
+        int32_t                                 m_numDecodedClips = 0;
+        int32_t                                 m_numDecodedTransforms = 0;
+        int32_t                                 m_numBitExactDecodedTransforms = 0;
+        int32_t                                 m_numDecodeMismatches = 0;
+        float                                   m_maxDecodeError = 0.0f;
+        Microseconds                            m_decodeTimeSIMD = 0.0f;
+        Microseconds                            m_decodeTimeScalar = 0.0f;
+    };
+}
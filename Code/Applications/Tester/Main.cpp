@@ -1,5 +1,9 @@
+#include "AnimationGraphBenchmark.h"
+#include "MotionMatchingBenchmark.h"
+#include "PoseBenchmark.h"
 #include "System/TypeSystem/TypeRegistry.h"
 #include "Applications/Shared/ApplicationGlobalState.h"
+#include "Applications/Shared/cmdParser/cmdParser.h"
 #include "_AutoGenerated/ToolsTypeRegistration.h"
 #include "Engine/Physics/PhysicsLayers.h"
 #include "System/FileSystem/FileSystem.h"
@@ -105,6 +109,101 @@ int main( int argc, char *argv[] )
         TypeSystem::TypeRegistry typeRegistry;
         AutoGenerated::Tools::RegisterTypes( typeRegistry );
 
+        // Animation graph benchmark
+        //-------------------------------------------------------------------------
+        // e.g. -benchmark "data://Characters/Hero/Hero.gv" -data "D:\Compiled" -instances 100 -frames 300 -output "D:\results.json"
+
+        cli::Parser cmdParser( argc, argv );
+        cmdParser.set_optional<std::string>( "benchmark", "benchmark", "", "Animation graph variation to benchmark" );
+        cmdParser.set_optional<std::string>( "data", "data", "", "Compiled resource directory" );
+        cmdParser.set_optional<std::string>( "output", "output", "", "Benchmark result file, results are printed to stdout if not set" );
+        cmdParser.set_optional<int>( "instances", "instances", 100, "Number of graph instances to benchmark" );
+        cmdParser.set_optional<int>( "frames", "frames", 300, "Number of frames to record" );
+        cmdParser.set_optional<int>( "warmup", "warmup", 30, "Number of frames to run before recording" );
+        cmdParser.set_optional<int>( "seed", "seed", 0, "Control parameter randomization seed" );
+        cmdParser.set_optional<bool>( "serial", "serial", false, "Execute the pose tasks without the task system" );
+
+        // Motion matching benchmark
+        //-------------------------------------------------------------------------
+        // e.g. -mmbenchmark -queries 1000 -characters 50 -output "D:\mm_results.json"
+
+        cmdParser.set_optional<bool>( "mmbenchmark", "mmbenchmark", false, "Benchmark the motion matching database search" );
+        cmdParser.set_optional<int>( "queries", "queries", 1000, "Number of motion matching queries per database size" );
+        cmdParser.set_optional<int>( "characters", "characters", 50, "Number of characters searching per frame" );
+
+        // Pose benchmark
+        //-------------------------------------------------------------------------
+        // e.g. -posebenchmark -iterations 10000 -output "D:\pose_results.json"
+
+        cmdParser.set_optional<bool>( "posebenchmark", "posebenchmark", false, "Benchmark the pose operations and root motion delta queries against their reference implementations" );
+        cmdParser.set_optional<int>( "iterations", "iterations", 10000, "Number of times each pose operation is run per skeleton size" );
+
+        bool const hasValidCommandLine = cmdParser.run();
+
+        if ( hasValidCommandLine && cmdParser.get<bool>( "posebenchmark" ) )
+        {
+            PoseBenchmark::Settings settings;
+            settings.m_numIterations = cmdParser.get<int>( "iterations" );
+            settings.m_seed = (uint32_t) cmdParser.get<int>( "seed" );
+
+            std::string const outputPath = cmdParser.get<std::string>( "output" );
+            if ( !outputPath.empty() )
+            {
+                settings.m_outputPath = FileSystem::Path( outputPath.c_str() );
+            }
+
+            PoseBenchmark benchmark( settings );
+            bool const result = benchmark.Run();
+
+            AutoGenerated::Tools::UnregisterTypes( typeRegistry );
+            return result ? 0 : 1;
+        }
+
+        if ( hasValidCommandLine && cmdParser.get<bool>( "mmbenchmark" ) )
+        {
+            MotionMatchingBenchmark::Settings settings;
+            settings.m_numQueries = cmdParser.get<int>( "queries" );
+            settings.m_numCharacters = cmdParser.get<int>( "characters" );
+            settings.m_seed = (uint32_t) cmdParser.get<int>( "seed" );
+
+            std::string const outputPath = cmdParser.get<std::string>( "output" );
+            if ( !outputPath.empty() )
+            {
+                settings.m_outputPath = FileSystem::Path( outputPath.c_str() );
+            }
+
+            MotionMatchingBenchmark benchmark( settings );
+            bool const result = benchmark.Run();
+
+            AutoGenerated::Tools::UnregisterTypes( typeRegistry );
+            return result ? 0 : 1;
+        }
+
+        if ( hasValidCommandLine && !cmdParser.get<std::string>( "benchmark" ).empty() )
+        {
+            AnimationGraphBenchmark::Settings settings;
+            settings.m_graphVariationID = ResourceID( cmdParser.get<std::string>( "benchmark" ).c_str() );
+            settings.m_compiledResourcePath = FileSystem::Path( cmdParser.get<std::string>( "data" ).c_str() );
+            settings.m_numInstances = cmdParser.get<int>( "instances" );
+            settings.m_numFrames = cmdParser.get<int>( "frames" );
+            settings.m_numWarmupFrames = cmdParser.get<int>( "warmup" );
+            settings.m_seed = (uint32_t) cmdParser.get<int>( "seed" );
+            settings.m_useTaskSystem = !cmdParser.get<bool>( "serial" );
+
+            std::string const outputPath = cmdParser.get<std::string>( "output" );
+            if ( !outputPath.empty() )
+            {
+                settings.m_outputPath = FileSystem::Path( outputPath.c_str() );
+            }
+
+            AnimationGraphBenchmark benchmark( typeRegistry, settings );
+            bool const result = benchmark.Run();
+
+            AutoGenerated::Tools::UnregisterTypes( typeRegistry );
+            return result ? 0 : 1;
+        }
+
+        // Serialization test
         //-------------------------------------------------------------------------
 
         //String f( "SDA" );
@@ -0,0 +1,212 @@
+#include "MotionMatchingBenchmark.h"
+#include "Engine/Animation/AnimationMotionDatabase.h"
+#include "System/Time/Timers.h"
+#include "System/Log.h"
+#include <iostream>
+
+//-------------------------------------------------------------------------
+
+namespace EE
+{
+    MotionMatchingBenchmark::MotionMatchingBenchmark( Settings const& settings )
+        : m_settings( settings )
+        , m_rng( settings.m_seed )
+    {
+        EE_ASSERT( !m_settings.m_databaseSizes.empty() && m_settings.m_numFeatures > 0 && m_settings.m_clipLength > 1 );
+        EE_ASSERT( m_settings.m_numQueries > 0 && m_settings.m_numCharacters > 0 );
+    }
+
+    bool MotionMatchingBenchmark::Run()
+    {
+        m_results.clear();
+        for ( auto numEntries : m_settings.m_databaseSizes )
+        {
+            m_results.emplace_back( BenchmarkDatabase( numEntries ) );
+        }
+
+        return WriteResults();
+    }
+
+    void MotionMatchingBenchmark::GenerateFeatures( int32_t numEntries, TVector<float>& outFeatures )
+    {
+        int32_t const numFeatures = m_settings.m_numFeatures;
+        outFeatures.resize( numEntries * numFeatures );
+
+        TVector<float> velocity( numFeatures, 0.0f );
+        for ( int32_t entryIdx = 0; entryIdx < numEntries; entryIdx++ )
+        {
+            float* pEntry = &outFeatures[entryIdx * numFeatures];
+
+            // Start a new clip at a random point
+            if ( ( entryIdx % m_settings.m_clipLength ) == 0 )
+            {
+                for ( int32_t i = 0; i < numFeatures; i++ )
+                {
+                    pEntry[i] = m_rng.GetFloat( -2.0f, 2.0f );
+                    velocity[i] = 0.0f;
+                }
+                continue;
+            }
+
+            // Continue the clip with a smoothly changing velocity, pulled back towards the origin to keep the data normalized
+            float const* pPreviousEntry = pEntry - numFeatures;
+            for ( int32_t i = 0; i < numFeatures; i++ )
+            {
+                velocity[i] = ( velocity[i] * 0.9f ) + m_rng.GetFloat( -0.02f, 0.02f ) - ( pPreviousEntry[i] * 0.005f );
+                pEntry[i] = pPreviousEntry[i] + velocity[i];
+            }
+        }
+    }
+
+    void MotionMatchingBenchmark::GenerateQueries( Animation::MotionFeatureIndex const& index, TVector<float>& outQueries )
+    {
+        int32_t const stride = index.GetStride();
+        outQueries.clear();
+        outQueries.resize( m_settings.m_numQueries * stride, 0.0f );
+
+        for ( int32_t queryIdx = 0; queryIdx < m_settings.m_numQueries; queryIdx++ )
+        {
+            int32_t const entryIdx = (int32_t) m_rng.GetUInt( 0, index.GetNumEntries() - 1 );
+            float const* pEntry = index.GetEntryFeatures( entryIdx );
+            float* pQuery = &outQueries[queryIdx * stride];
+            for ( int32_t i = 0; i < index.GetNumFeatures(); i++ )
+            {
+                pQuery[i] = pEntry[i] + m_rng.GetFloat( -m_settings.m_queryNoise, m_settings.m_queryNoise );
+            }
+        }
+    }
+
+    MotionMatchingBenchmark::DatabaseResult MotionMatchingBenchmark::BenchmarkDatabase( int32_t numEntries )
+    {
+        DatabaseResult result;
+        result.m_numEntries = numEntries;
+
+        TVector<float> features;
+        GenerateFeatures( numEntries, features );
+
+        Animation::MotionFeatureIndex index;
+        Timer<PlatformClock> timer;
+        index.Build( m_settings.m_numFeatures, features.data(), numEntries );
+        result.m_buildTime = timer.GetElapsedTimeMicroseconds();
+
+        TVector<float> queries;
+        GenerateQueries( index, queries );
+
+        int32_t const stride = index.GetStride();
+        float const numQueries = (float) m_settings.m_numQueries;
+
+        // Brute force
+        //-------------------------------------------------------------------------
+
+        TVector<Animation::MotionFeatureIndex::SearchResult> bruteForceResults;
+        bruteForceResults.resize( m_settings.m_numQueries );
+
+        timer.Start();
+        for ( int32_t queryIdx = 0; queryIdx < m_settings.m_numQueries; queryIdx++ )
+        {
+            bruteForceResults[queryIdx] = index.FindNearestBruteForce( &queries[queryIdx * stride] );
+        }
+        result.m_bruteForceQueryTime = timer.GetElapsedTimeMicroseconds() / numQueries;
+
+        // KD-tree
+        //-------------------------------------------------------------------------
+
+        TVector<Animation::MotionFeatureIndex::SearchResult> indexedResults;
+        indexedResults.resize( m_settings.m_numQueries );
+
+        timer.Start();
+        for ( int32_t queryIdx = 0; queryIdx < m_settings.m_numQueries; queryIdx++ )
+        {
+            indexedResults[queryIdx] = index.FindNearest( &queries[queryIdx * stride] );
+        }
+        result.m_indexedQueryTime = timer.GetElapsedTimeMicroseconds() / numQueries;
+
+        // Both searches are exact, so any difference (other than an equal cost tie) is a bug in the index
+        //-------------------------------------------------------------------------
+
+        for ( int32_t queryIdx = 0; queryIdx < m_settings.m_numQueries; queryIdx++ )
+        {
+            if ( bruteForceResults[queryIdx].m_entryIdx != indexedResults[queryIdx].m_entryIdx && bruteForceResults[queryIdx].m_cost != indexedResults[queryIdx].m_cost )
+            {
+                result.m_numMismatches++;
+            }
+        }
+
+        if ( result.m_numMismatches > 0 )
+        {
+            EE_LOG_ERROR( "Animation", "Motion Matching Benchmark", "KD-tree search returned a different result to the brute force search for %d queries (%d entries)", result.m_numMismatches, numEntries );
+        }
+
+        return result;
+    }
+
+    bool MotionMatchingBenchmark::WriteResults() const
+    {
+        Serialization::JsonArchiveWriter archive;
+        auto& writer = *archive.GetWriter();
+
+        writer.StartObject();
+
+        writer.Key( "NumFeatures" );
+        writer.Int( m_settings.m_numFeatures );
+        writer.Key( "NumQueries" );
+        writer.Int( m_settings.m_numQueries );
+        writer.Key( "NumCharacters" );
+        writer.Int( m_settings.m_numCharacters );
+        writer.Key( "QueryNoise" );
+        writer.Double( m_settings.m_queryNoise );
+        writer.Key( "Seed" );
+        writer.Uint( m_settings.m_seed );
+
+        // All times are in microseconds, the per frame cost is for all characters searching once
+        writer.Key( "Databases" );
+        writer.StartArray();
+        for ( auto const& result : m_results )
+        {
+            writer.StartObject();
+            writer.Key( "NumEntries" );
+            writer.Int( result.m_numEntries );
+            writer.Key( "BuildTime" );
+            writer.Double( result.m_buildTime.ToFloat() );
+            writer.Key( "BruteForceQuery" );
+            writer.Double( result.m_bruteForceQueryTime.ToFloat() );
+            writer.Key( "IndexedQuery" );
+            writer.Double( result.m_indexedQueryTime.ToFloat() );
+            writer.Key( "Speedup" );
+            writer.Double( result.m_bruteForceQueryTime.ToFloat() / Math::Max( result.m_indexedQueryTime.ToFloat(), 0.001f ) );
+            writer.Key( "BruteForceFrameCost" );
+            writer.Double( result.m_bruteForceQueryTime.ToFloat() * m_settings.m_numCharacters );
+            writer.Key( "IndexedFrameCost" );
+            writer.Double( result.m_indexedQueryTime.ToFloat() * m_settings.m_numCharacters );
+            writer.Key( "Mismatches" );
+            writer.Int( result.m_numMismatches );
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+
+        //-------------------------------------------------------------------------
+
+        if ( m_settings.m_outputPath.IsValid() )
+        {
+            if ( !archive.WriteToFile( m_settings.m_outputPath ) )
+            {
+                EE_LOG_ERROR( "Animation", "Motion Matching Benchmark", "Failed to write results to: %s", m_settings.m_outputPath.c_str() );
+                return false;
+            }
+        }
+        else
+        {
+            std::cout << archive.GetStringBuffer().GetString() << std::endl;
+        }
+
+        bool allResultsMatch = true;
+        for ( auto const& result : m_results )
+        {
+            allResultsMatch &= ( result.m_numMismatches == 0 );
+        }
+
+        return allResultsMatch;
+    }
+}
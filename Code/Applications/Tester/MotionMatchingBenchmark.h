@@ -0,0 +1,69 @@
+#pragma once
+
+#include "System/Serialization/JsonSerialization.h"
+#include "System/FileSystem/FileSystemPath.h"
+#include "System/Math/MathRandom.h"
+#include "System/Time/Time.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation { class MotionFeatureIndex; }
+
+//-------------------------------------------------------------------------
+// Motion Matching Benchmark
+//-------------------------------------------------------------------------
+// Measures the motion database search cost for a range of database sizes, no compiled data is needed
+// The feature data is synthetic: each clip is a smoothly varying random walk through feature space, which is a lot closer
+// to real animation data than uniformly distributed noise. The queries are existing entries with some noise added,
+// i.e. similar to the query created from the current pose and a slightly different desired trajectory
+// Every query is run against both the brute force search and the KD-tree and the results are compared
+
+namespace EE
+{
+    class MotionMatchingBenchmark
+    {
+        struct DatabaseResult
+        {
+            int32_t                             m_numEntries = 0;
+            Microseconds                        m_buildTime = 0.0f;
+            Microseconds                        m_bruteForceQueryTime = 0.0f;
+            Microseconds                        m_indexedQueryTime = 0.0f;
+            int32_t                             m_numMismatches = 0;
+        };
+
+    public:
+
+        struct Settings
+        {
+            FileSystem::Path                    m_outputPath;                       // If not set, the results are printed to stdout
+            TVector<int32_t>                    m_databaseSizes = { 1024, 4096, 16384, 65536, 262144 };
+            int32_t                             m_numFeatures = 27;                 // 3 bones and 3 trajectory samples
+            int32_t                             m_clipLength = 300;                 // Number of entries per synthetic clip
+            int32_t                             m_numQueries = 1000;
+            int32_t                             m_numCharacters = 50;               // Every character searches once per frame
+            float                               m_queryNoise = 0.25f;
+            uint32_t                            m_seed = 0;
+        };
+
+    public:
+
+        MotionMatchingBenchmark( Settings const& settings );
+
+        // Run the benchmark and write out the results
+        bool Run();
+
+    private:
+
+        void GenerateFeatures( int32_t numEntries, TVector<float>& outFeatures );
+        void GenerateQueries( Animation::MotionFeatureIndex const& index, TVector<float>& outQueries );
+        DatabaseResult BenchmarkDatabase( int32_t numEntries );
+        bool WriteResults() const;
+
+    private:
+
+        Settings                                m_settings;
+        Math::RNG                               m_rng;
+        TVector<DatabaseResult>                 m_results;
+    };
+}
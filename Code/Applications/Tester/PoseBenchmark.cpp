@@ -0,0 +1,437 @@
+#include "PoseBenchmark.h"
+#include "Engine/Animation/AnimationBlender.h"
+#include "Engine/Animation/AnimationPose.h"
+#include "Engine/Animation/AnimationRootMotion.h"
+#include "Engine/Animation/AnimationSkeleton.h"
+#include "System/Time/Timers.h"
+#include "System/Log.h"
+#include <iostream>
+
+//-------------------------------------------------------------------------
+
+namespace EE
+{
+    static float CalculateGlobalTransformError( Transform const& transform0, Transform const& transform1 )
+    {
+        // The translation error grows with the length of the chain so compare it relative to the distance from the root
+        float const translationLength = Math::Max( transform0.GetTranslation().GetLength3(), 1.0f );
+        float error = transform0.GetTranslation().GetDistance3( transform1.GetTranslation() ) / translationLength;
+        error = Math::Max( error, Quaternion::Distance( transform0.GetRotation(), transform1.GetRotation() ).ToFloat() );
+        error = Math::Max( error, Math::Abs( transform0.GetScale() - transform1.GetScale() ) / Math::Max( Math::Abs( transform0.GetScale() ), 1.0f ) );
+        return error;
+    }
+
+    //-------------------------------------------------------------------------
+
+    PoseBenchmark::PoseBenchmark( Settings const& settings )
+        : m_settings( settings )
+        , m_rng( settings.m_seed )
+    {
+        EE_ASSERT( !m_settings.m_skeletonSizes.empty() && m_settings.m_numIterations > 0 && m_settings.m_errorTolerance >= 0.0f );
+        EE_ASSERT( m_settings.m_numRootMotionFrames > 1 && m_settings.m_numRootMotionQueries > 0 );
+    }
+
+    bool PoseBenchmark::Run()
+    {
+        m_results.clear();
+        for ( auto numBones : m_settings.m_skeletonSizes )
+        {
+            m_results.emplace_back( BenchmarkSkeleton( numBones ) );
+        }
+
+        m_rootMotionResult = BenchmarkRootMotion();
+
+        return WriteResults();
+    }
+
+    void PoseBenchmark::RandomizePose( Animation::Pose& pose )
+    {
+        int32_t const numBones = pose.GetNumBones();
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            Quaternion const rotation( EulerAngles( m_rng.GetFloat( -90.0f, 90.0f ), m_rng.GetFloat( -90.0f, 90.0f ), m_rng.GetFloat( -90.0f, 90.0f ) ) );
+            Vector const translation( m_rng.GetFloat( -0.5f, 0.5f ), m_rng.GetFloat( -0.5f, 0.5f ), m_rng.GetFloat( -0.5f, 0.5f ) );
+            pose.SetTransform( boneIdx, Transform( rotation, translation, m_rng.GetFloat( 0.5f, 1.5f ) ) );
+        }
+    }
+
+    float PoseBenchmark::CompareLocalTransforms( Animation::Pose const& pose0, Animation::Pose const& pose1, int32_t& inOutNumMismatches ) const
+    {
+        EE_ASSERT( pose0.GetNumBones() == pose1.GetNumBones() );
+
+        float maxError = 0.0f;
+        int32_t const numBones = pose0.GetNumBones();
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            Transform const& transform0 = pose0.GetTransform( boneIdx );
+            Transform const& transform1 = pose1.GetTransform( boneIdx );
+
+            float error = transform0.GetTranslation().GetDistance3( transform1.GetTranslation() );
+            error = Math::Max( error, Quaternion::Distance( transform0.GetRotation(), transform1.GetRotation() ).ToFloat() );
+            error = Math::Max( error, Math::Abs( transform0.GetScale() - transform1.GetScale() ) );
+
+            maxError = Math::Max( maxError, error );
+            if ( error > m_settings.m_errorTolerance )
+            {
+                inOutNumMismatches++;
+            }
+        }
+
+        return maxError;
+    }
+
+    float PoseBenchmark::CompareGlobalTransforms( Animation::Pose const& pose0, Animation::Pose const& pose1, int32_t& inOutNumMismatches ) const
+    {
+        EE_ASSERT( pose0.GetNumBones() == pose1.GetNumBones() );
+        EE_ASSERT( pose0.HasGlobalTransforms() && pose1.HasGlobalTransforms() );
+
+        float maxError = 0.0f;
+        int32_t const numBones = pose0.GetNumBones();
+        Transform const* pGlobalTransforms0 = pose0.GetGlobalTransforms();
+        Transform const* pGlobalTransforms1 = pose1.GetGlobalTransforms();
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            float const error = CalculateGlobalTransformError( pGlobalTransforms0[boneIdx], pGlobalTransforms1[boneIdx] );
+            maxError = Math::Max( maxError, error );
+            if ( error > m_settings.m_errorTolerance )
+            {
+                inOutNumMismatches++;
+            }
+        }
+
+        return maxError;
+    }
+
+    PoseBenchmark::SkeletonResult PoseBenchmark::BenchmarkSkeleton( int32_t numBones )
+    {
+        SkeletonResult result;
+        result.m_numBones = numBones;
+
+        Animation::Skeleton* pSkeleton = Animation::Skeleton::CreateProceduralSkeleton( numBones );
+
+        {
+            Animation::Pose sourcePose( pSkeleton );
+            Animation::Pose targetPose( pSkeleton );
+            Animation::Pose resultPose( pSkeleton );
+            Animation::Pose scalarResultPose( pSkeleton );
+            RandomizePose( sourcePose );
+            RandomizePose( targetPose );
+
+            float const numIterations = (float) m_settings.m_numIterations;
+            TBitFlags<Animation::PoseBlendOptions> const interpolativeBlend;
+            TBitFlags<Animation::PoseBlendOptions> const additiveBlend( Animation::PoseBlendOptions::Additive );
+
+            // Local space blend
+            //-------------------------------------------------------------------------
+
+            Timer<PlatformClock> timer;
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                Animation::Blender::Blend( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.35f, interpolativeBlend, nullptr, &resultPose );
+            }
+            result.m_localBlendTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                Animation::Blender::BlendScalar( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.35f, interpolativeBlend, nullptr, &scalarResultPose );
+            }
+            result.m_localBlendScalarTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            result.m_maxBlendError = CompareLocalTransforms( resultPose, scalarResultPose, result.m_numBlendMismatches );
+
+            // Additive blend
+            //-------------------------------------------------------------------------
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                Animation::Blender::Blend( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.35f, additiveBlend, nullptr, &resultPose );
+            }
+            result.m_additiveBlendTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                Animation::Blender::BlendScalar( Animation::Skeleton::LOD::High, &sourcePose, &targetPose, 0.35f, additiveBlend, nullptr, &scalarResultPose );
+            }
+            result.m_additiveBlendScalarTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            result.m_maxBlendError = Math::Max( result.m_maxBlendError, CompareLocalTransforms( resultPose, scalarResultPose, result.m_numBlendMismatches ) );
+
+            // Global transforms
+            //-------------------------------------------------------------------------
+
+            targetPose.CopyFrom( sourcePose );
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                sourcePose.CalculateGlobalTransforms();
+            }
+            result.m_globalTransformsTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                targetPose.CalculateGlobalTransformsScalar();
+            }
+            result.m_globalTransformsScalarTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+
+            result.m_maxGlobalTransformError = CompareGlobalTransforms( sourcePose, targetPose, result.m_numGlobalTransformMismatches );
+
+            // Partial global transforms, for a random subset of bones
+            //-------------------------------------------------------------------------
+
+            int32_t const numPartialBones = Math::Max( numBones / 10, 1 );
+            TVector<int32_t> partialBoneIndices;
+            for ( int32_t i = 0; i < numPartialBones; i++ )
+            {
+                partialBoneIndices.emplace_back( (int32_t) m_rng.GetUInt( 0, numBones - 1 ) );
+            }
+
+            // The partial calculation just copies the global transforms if they are already calculated
+            TVector<Transform> partialGlobalTransforms( numPartialBones );
+            targetPose.ClearGlobalTransforms();
+
+            timer.Start();
+            for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+            {
+                targetPose.CalculateGlobalTransforms( partialBoneIndices.data(), numPartialBones, partialGlobalTransforms.data() );
+            }
+            result.m_partialGlobalTransformsTime = timer.GetElapsedTimeMicroseconds() / numIterations;
+            result.m_numPartialBones = numPartialBones;
+
+            Transform const* pGlobalTransforms = sourcePose.GetGlobalTransforms();
+            for ( int32_t i = 0; i < numPartialBones; i++ )
+            {
+                float const error = CalculateGlobalTransformError( pGlobalTransforms[partialBoneIndices[i]], partialGlobalTransforms[i] );
+                result.m_maxGlobalTransformError = Math::Max( result.m_maxGlobalTransformError, error );
+                if ( error > m_settings.m_errorTolerance )
+                {
+                    result.m_numPartialGlobalTransformMismatches++;
+                }
+            }
+        }
+
+        EE::Delete( pSkeleton );
+
+        //-------------------------------------------------------------------------
+
+        if ( result.m_numBlendMismatches > 0 )
+        {
+            EE_LOG_ERROR( "Animation", "Pose Benchmark", "SIMD and scalar blends differ for %d transforms (%d bones)", result.m_numBlendMismatches, numBones );
+        }
+
+        if ( result.m_numGlobalTransformMismatches > 0 )
+        {
+            EE_LOG_ERROR( "Animation", "Pose Benchmark", "Depth level and scalar global transforms differ for %d bones (%d bones)", result.m_numGlobalTransformMismatches, numBones );
+        }
+
+        if ( result.m_numPartialGlobalTransformMismatches > 0 )
+        {
+            EE_LOG_ERROR( "Animation", "Pose Benchmark", "Partial and full global transforms differ for %d of %d requested bones (%d bones)", result.m_numPartialGlobalTransformMismatches, result.m_numPartialBones, numBones );
+        }
+
+        return result;
+    }
+
+    PoseBenchmark::RootMotionResult PoseBenchmark::BenchmarkRootMotion()
+    {
+        RootMotionResult result;
+
+        // Create a root motion track that moves forward while randomly turning, same as a locomotion clip would
+        //-------------------------------------------------------------------------
+
+        Animation::RootMotionData rootMotion;
+        rootMotion.m_transforms.resize( m_settings.m_numRootMotionFrames );
+        rootMotion.m_transforms[0] = Transform::Identity;
+
+        Radians heading = 0.0f;
+        Vector position = Vector::Zero;
+        for ( int32_t frameIdx = 1; frameIdx < m_settings.m_numRootMotionFrames; frameIdx++ )
+        {
+            heading += Radians( m_rng.GetFloat( -0.05f, 0.05f ) );
+            Quaternion const rotation( Vector::WorldUp, heading );
+            position += rotation.RotateVector( Vector::WorldForward * m_rng.GetFloat( 0.02f, 0.08f ) );
+            rootMotion.m_transforms[frameIdx] = Transform( rotation, position );
+        }
+
+        // Compress to get the same data (and lookup tables) that we would have at runtime
+        rootMotion.Compress();
+
+        // Random time ranges, a third of which start exactly at a key frame
+        //-------------------------------------------------------------------------
+
+        int32_t const numQueries = m_settings.m_numRootMotionQueries;
+        TVector<Percentage> fromTimes( numQueries, 0.0f );
+        TVector<Percentage> toTimes( numQueries, 0.0f );
+        for ( int32_t i = 0; i < numQueries; i++ )
+        {
+            float fromTime = m_rng.GetFloat( 0.0f, 1.0f );
+            if ( i % 3 == 0 )
+            {
+                fromTime = float( m_rng.GetUInt( 0, m_settings.m_numRootMotionFrames - 1 ) ) / ( m_settings.m_numRootMotionFrames - 1 );
+            }
+
+            fromTimes[i] = fromTime;
+            toTimes[i] = m_rng.GetFloat( fromTime, 1.0f );
+        }
+
+        // Delta queries
+        //-------------------------------------------------------------------------
+
+        float const numCalls = float( m_settings.m_numIterations ) * numQueries;
+        TVector<Transform> deltas( numQueries );
+        TVector<Transform> referenceDeltas( numQueries );
+
+        Timer<PlatformClock> timer;
+        for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+        {
+            for ( int32_t queryIdx = 0; queryIdx < numQueries; queryIdx++ )
+            {
+                deltas[queryIdx] = rootMotion.GetDeltaNoLooping( fromTimes[queryIdx], toTimes[queryIdx] );
+            }
+        }
+        result.m_deltaTime = timer.GetElapsedTimeMicroseconds() / numCalls;
+
+        timer.Start();
+        for ( int32_t i = 0; i < m_settings.m_numIterations; i++ )
+        {
+            for ( int32_t queryIdx = 0; queryIdx < numQueries; queryIdx++ )
+            {
+                referenceDeltas[queryIdx] = rootMotion.GetDeltaNoLoopingReference( fromTimes[queryIdx], toTimes[queryIdx] );
+            }
+        }
+        result.m_deltaReferenceTime = timer.GetElapsedTimeMicroseconds() / numCalls;
+
+        for ( int32_t queryIdx = 0; queryIdx < numQueries; queryIdx++ )
+        {
+            float const error = CalculateGlobalTransformError( deltas[queryIdx], referenceDeltas[queryIdx] );
+            result.m_maxDeltaError = Math::Max( result.m_maxDeltaError, error );
+            if ( error > m_settings.m_errorTolerance )
+            {
+                result.m_numDeltaMismatches++;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( result.m_numDeltaMismatches > 0 )
+        {
+            EE_LOG_ERROR( "Animation", "Pose Benchmark", "Lookup table and reference root motion deltas differ for %d of %d queries", result.m_numDeltaMismatches, numQueries );
+        }
+
+        return result;
+    }
+
+    bool PoseBenchmark::WriteResults() const
+    {
+        Serialization::JsonArchiveWriter archive;
+        auto& writer = *archive.GetWriter();
+
+        writer.StartObject();
+
+        writer.Key( "NumIterations" );
+        writer.Int( m_settings.m_numIterations );
+        writer.Key( "ErrorTolerance" );
+        writer.Double( m_settings.m_errorTolerance );
+        writer.Key( "Seed" );
+        writer.Uint( m_settings.m_seed );
+
+        // All times are in microseconds per call
+        writer.Key( "Skeletons" );
+        writer.StartArray();
+        for ( auto const& result : m_results )
+        {
+            writer.StartObject();
+            writer.Key( "NumBones" );
+            writer.Int( result.m_numBones );
+
+            writer.Key( "LocalSpaceBlend" );
+            writer.Double( result.m_localBlendTime.ToFloat() );
+            writer.Key( "LocalSpaceBlendScalar" );
+            writer.Double( result.m_localBlendScalarTime.ToFloat() );
+            writer.Key( "LocalSpaceBlendSpeedup" );
+            writer.Double( result.m_localBlendScalarTime.ToFloat() / Math::Max( result.m_localBlendTime.ToFloat(), 0.001f ) );
+
+            writer.Key( "AdditiveBlend" );
+            writer.Double( result.m_additiveBlendTime.ToFloat() );
+            writer.Key( "AdditiveBlendScalar" );
+            writer.Double( result.m_additiveBlendScalarTime.ToFloat() );
+            writer.Key( "AdditiveBlendSpeedup" );
+            writer.Double( result.m_additiveBlendScalarTime.ToFloat() / Math::Max( result.m_additiveBlendTime.ToFloat(), 0.001f ) );
+
+            writer.Key( "MaxBlendError" );
+            writer.Double( result.m_maxBlendError );
+            writer.Key( "BlendMismatches" );
+            writer.Int( result.m_numBlendMismatches );
+
+            writer.Key( "CalculateGlobalTransforms" );
+            writer.Double( result.m_globalTransformsTime.ToFloat() );
+            writer.Key( "CalculateGlobalTransformsScalar" );
+            writer.Double( result.m_globalTransformsScalarTime.ToFloat() );
+            writer.Key( "CalculateGlobalTransformsSpeedup" );
+            writer.Double( result.m_globalTransformsScalarTime.ToFloat() / Math::Max( result.m_globalTransformsTime.ToFloat(), 0.001f ) );
+
+            writer.Key( "NumPartialBones" );
+            writer.Int( result.m_numPartialBones );
+            writer.Key( "PartialGlobalTransforms" );
+            writer.Double( result.m_partialGlobalTransformsTime.ToFloat() );
+            writer.Key( "PartialGlobalTransformMismatches" );
+            writer.Int( result.m_numPartialGlobalTransformMismatches );
+
+            writer.Key( "MaxGlobalTransformError" );
+            writer.Double( result.m_maxGlobalTransformError );
+            writer.Key( "GlobalTransformMismatches" );
+            writer.Int( result.m_numGlobalTransformMismatches );
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.Key( "RootMotion" );
+        writer.StartObject();
+        writer.Key( "NumFrames" );
+        writer.Int( m_settings.m_numRootMotionFrames );
+        writer.Key( "NumQueries" );
+        writer.Int( m_settings.m_numRootMotionQueries );
+        writer.Key( "GetDelta" );
+        writer.Double( m_rootMotionResult.m_deltaTime.ToFloat() );
+        writer.Key( "DeltaNoScale" );
+        writer.Double( m_rootMotionResult.m_deltaReferenceTime.ToFloat() );
+        writer.Key( "GetDeltaSpeedup" );
+        writer.Double( m_rootMotionResult.m_deltaReferenceTime.ToFloat() / Math::Max( m_rootMotionResult.m_deltaTime.ToFloat(), 0.000001f ) );
+        writer.Key( "MaxDeltaError" );
+        writer.Double( m_rootMotionResult.m_maxDeltaError );
+        writer.Key( "DeltaMismatches" );
+        writer.Int( m_rootMotionResult.m_numDeltaMismatches );
+        writer.EndObject();
+
+        writer.EndObject();
+
+        //-------------------------------------------------------------------------
+
+        if ( m_settings.m_outputPath.IsValid() )
+        {
+            if ( !archive.WriteToFile( m_settings.m_outputPath ) )
+            {
+                EE_LOG_ERROR( "Animation", "Pose Benchmark", "Failed to write results to: %s", m_settings.m_outputPath.c_str() );
+                return false;
+            }
+        }
+        else
+        {
+            std::cout << archive.GetStringBuffer().GetString() << std::endl;
+        }
+
+        bool allResultsMatch = ( m_rootMotionResult.m_numDeltaMismatches == 0 );
+        for ( auto const& result : m_results )
+        {
+            allResultsMatch &= ( result.m_numBlendMismatches == 0 );
+            allResultsMatch &= ( result.m_numGlobalTransformMismatches == 0 );
+            allResultsMatch &= ( result.m_numPartialGlobalTransformMismatches == 0 );
+        }
+
+        return allResultsMatch;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "System/Serialization/JsonSerialization.h"
+#include "System/FileSystem/FileSystemPath.h"
+#include "System/Math/MathRandom.h"
+#include "System/Time/Time.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation { class Pose; }
+
+//-------------------------------------------------------------------------
+// Pose Benchmark
+//-------------------------------------------------------------------------
+// Measures the cost of the core pose operations for a range of skeleton sizes, no compiled data is needed
+// The skeletons are procedurally generated (see 'Skeleton::CreateProceduralSkeleton') and the poses are randomized
+// Every operation is run through both the optimized path and the scalar reference path and the results are compared
+// The root motion delta queries (lookup table vs 'Transform::DeltaNoScale') are benchmarked on a procedural root motion track
+
+namespace EE
+{
+    class PoseBenchmark
+    {
+        struct SkeletonResult
+        {
+            int32_t                             m_numBones = 0;
+            Microseconds                        m_localBlendTime = 0.0f;
+            Microseconds                        m_localBlendScalarTime = 0.0f;
+            Microseconds                        m_additiveBlendTime = 0.0f;
+            Microseconds                        m_additiveBlendScalarTime = 0.0f;
+            float                               m_maxBlendError = 0.0f;
+            int32_t                             m_numBlendMismatches = 0;
+            Microseconds                        m_globalTransformsTime = 0.0f;
+            Microseconds                        m_globalTransformsScalarTime = 0.0f;
+            float                               m_maxGlobalTransformError = 0.0f;   // Includes the error of the partial global transforms
+            int32_t                             m_numGlobalTransformMismatches = 0;
+            Microseconds                        m_partialGlobalTransformsTime = 0.0f;
+            int32_t                             m_numPartialBones = 0;
+            int32_t                             m_numPartialGlobalTransformMismatches = 0;
+        };
+
+        struct RootMotionResult
+        {
+            Microseconds                        m_deltaTime = 0.0f;
+            Microseconds                        m_deltaReferenceTime = 0.0f;
+            float                               m_maxDeltaError = 0.0f;
+            int32_t                             m_numDeltaMismatches = 0;
+        };
+
+    public:
+
+        struct Settings
+        {
+            FileSystem::Path                    m_outputPath;                       // If not set, the results are printed to stdout
+            TVector<int32_t>                    m_skeletonSizes = { 100, 250 };
+            int32_t                             m_numIterations = 10000;
+            int32_t                             m_numRootMotionFrames = 300;
+            int32_t                             m_numRootMotionQueries = 100;     // Number of random delta queries per iteration
+            float                               m_errorTolerance = 1.0e-4f;         // The SIMD paths use approximations of some of the trig functions so the results are not bit-exact
+            uint32_t                            m_seed = 0;
+        };
+
+    public:
+
+        PoseBenchmark( Settings const& settings );
+
+        // Run the benchmark and write out the results - returns false if the optimized and scalar paths produced different results
+        bool Run();
+
+    private:
+
+        void RandomizePose( Animation::Pose& pose );
+        float CompareLocalTransforms( Animation::Pose const& pose0, Animation::Pose const& pose1, int32_t& inOutNumMismatches ) const;
+        float CompareGlobalTransforms( Animation::Pose const& pose0, Animation::Pose const& pose1, int32_t& inOutNumMismatches ) const;
+        SkeletonResult BenchmarkSkeleton( int32_t numBones );
+        RootMotionResult BenchmarkRootMotion();
+        bool WriteResults() const;
+
+    private:
+
+        Settings                                m_settings;
+        Math::RNG                               m_rng;
+        TVector<SkeletonResult>                 m_results;
+        RootMotionResult                        m_rootMotionResult;
+    };
+}
@@ -5,49 +5,7 @@
 namespace EE::Animation
 {
     template<typename Blender, typename BlendWeight>
-    void BlenderLocal( Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
-    {
-        EE_ASSERT( blendWeight >= 0.0f && blendWeight <= 1.0f );
-        EE_ASSERT( pSourcePose != nullptr && pTargetPose != nullptr && pResultPose != nullptr );
-
-        if ( pBoneMask != nullptr )
-        {
-            EE_ASSERT( pBoneMask->GetNumWeights() == pSourcePose->GetSkeleton()->GetNumBones() );
-        }
-
-        int32_t const numBones = pResultPose->GetNumBones();
-        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
-        {
-            // If the bone has been masked out
-            float const boneBlendWeight = BlendWeight::GetBlendWeight( blendWeight, pBoneMask, boneIdx );
-            if ( boneBlendWeight == 0.0f )
-            { 
-                pResultPose->SetTransform( boneIdx, pSourcePose->GetTransform( boneIdx ) );
-            }
-            else // Perform Blend
-            {
-                Transform const& sourceTransform = pSourcePose->GetTransform( boneIdx );
-                Transform const& targetTransform = pTargetPose->GetTransform( boneIdx );
-
-                // Blend translations
-                Vector const translation = Blender::BlendTranslation( sourceTransform.GetTranslation(), targetTransform.GetTranslation(), boneBlendWeight );
-                pResultPose->SetTranslation( boneIdx, translation );
-
-                // Blend scales
-                float const scale = Blender::BlendScale( sourceTransform.GetScale(), targetTransform.GetScale(), boneBlendWeight );
-                pResultPose->SetScale( boneIdx, scale );
-
-                // Blend rotations
-                Quaternion const rotation = Blender::BlendRotation( sourceTransform.GetRotation(), targetTransform.GetRotation(), boneBlendWeight );
-                pResultPose->SetRotation( boneIdx, rotation );
-            }
-        }
-    }
-
-    //-------------------------------------------------------------------------
-
-    template<typename Blender, typename BlendWeight>
-    void BlenderGlobal( Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
+    void BlenderGlobal( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
     {
         static auto const rootBoneIndex = 0;
         EE_ASSERT( blendWeight >= 0.0f && blendWeight <= 1.0f );
@@ -78,7 +36,7 @@ namespace EE::Animation
         //-------------------------------------------------------------------------
 
         auto const& parentIndices = pSourcePose->GetSkeleton()->GetParentBoneIndices();
-        auto const numBones = pResultPose->GetNumBones();
+        auto const numBones = pResultPose->GetSkeleton()->GetNumBones( lod );
         for ( auto boneIdx = 1; boneIdx < numBones; boneIdx++ )
         {
             boneBlendWeight = BlendWeight::GetBlendWeight( blendWeight, pBoneMask, boneIdx );
@@ -130,32 +88,181 @@ namespace EE::Animation
 
 namespace EE::Animation
 {
-    void Blender::Blend( Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose )
+    template<typename BlendFunction, typename WeightFunction>
+    void Blender::BlendLocalSpace( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
+    {
+        EE_ASSERT( blendWeight >= 0.0f && blendWeight <= 1.0f );
+        EE_ASSERT( pSourcePose != nullptr && pTargetPose != nullptr && pResultPose != nullptr );
+
+        if ( pBoneMask != nullptr )
+        {
+            EE_ASSERT( pBoneMask->GetNumWeights() == pSourcePose->GetSkeleton()->GetNumBones() );
+        }
+
+        int32_t const numBones = pResultPose->GetSkeleton()->GetNumBones( lod );
+        Transform const* pSourceTransforms = pSourcePose->m_pLocalTransforms;
+        Transform const* pTargetTransforms = pTargetPose->m_pLocalTransforms;
+        Transform* pResultTransforms = pResultPose->m_pLocalTransforms;
+
+        // Blend groups of four bones
+        //-------------------------------------------------------------------------
+
+        Vector const vBlendWeight( blendWeight );
+        TransformSoA4 source, target, result;
+
+        int32_t const numSIMDBones = numBones & ~3;
+        for ( int32_t boneIdx = 0; boneIdx < numSIMDBones; boneIdx += 4 )
+        {
+            Vector const boneBlendWeights = WeightFunction::GetBlendWeights4( vBlendWeight, pBoneMask, boneIdx );
+            source.Load( &pSourceTransforms[boneIdx] );
+            target.Load( &pTargetTransforms[boneIdx] );
+
+            result.m_translation = BlendFunction::BlendTranslation( source.m_translation, target.m_translation, boneBlendWeights );
+            result.m_scale = BlendFunction::BlendScale( source.m_scale, target.m_scale, boneBlendWeights );
+            result.m_rotation = BlendFunction::BlendRotation( source.m_rotation, target.m_rotation, boneBlendWeights );
+
+            // Bones that have been masked out keep the source transform
+            result = TransformSoA4::Select( result, source, boneBlendWeights.EqualsZero() );
+            result.Store( &pResultTransforms[boneIdx] );
+        }
+
+        // Blend the remaining bones
+        //-------------------------------------------------------------------------
+
+        BlendLocalSpaceBones<BlendFunction, WeightFunction>( numSIMDBones, numBones, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+
+        pResultPose->MarkAsValidPose();
+    }
+
+    template<typename BlendFunction, typename WeightFunction>
+    void Blender::BlendLocalSpaceBones( int32_t startBoneIdx, int32_t endBoneIdx, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
+    {
+        Transform const* pSourceTransforms = pSourcePose->m_pLocalTransforms;
+        Transform const* pTargetTransforms = pTargetPose->m_pLocalTransforms;
+        Transform* pResultTransforms = pResultPose->m_pLocalTransforms;
+
+        for ( int32_t boneIdx = startBoneIdx; boneIdx < endBoneIdx; boneIdx++ )
+        {
+            // If the bone has been masked out
+            float const boneBlendWeight = WeightFunction::GetBlendWeight( blendWeight, pBoneMask, boneIdx );
+            if ( boneBlendWeight == 0.0f )
+            {
+                pResultTransforms[boneIdx] = pSourceTransforms[boneIdx];
+            }
+            else // Perform Blend
+            {
+                Transform const& sourceTransform = pSourceTransforms[boneIdx];
+                Transform const& targetTransform = pTargetTransforms[boneIdx];
+                Transform& resultTransform = pResultTransforms[boneIdx];
+                resultTransform.SetTranslation( BlendFunction::BlendTranslation( sourceTransform.GetTranslation(), targetTransform.GetTranslation(), boneBlendWeight ) );
+                resultTransform.SetScale( BlendFunction::BlendScale( sourceTransform.GetScale(), targetTransform.GetScale(), boneBlendWeight ) );
+                resultTransform.SetRotation( BlendFunction::BlendRotation( sourceTransform.GetRotation(), targetTransform.GetRotation(), boneBlendWeight ) );
+            }
+        }
+    }
+
+    template<typename WeightFunction>
+    void Blender::BlendAdditiveActiveBones( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose )
+    {
+        EE_ASSERT( blendWeight >= 0.0f && blendWeight <= 1.0f );
+        EE_ASSERT( pSourcePose != nullptr && pTargetPose != nullptr && pResultPose != nullptr );
+        EE_ASSERT( pTargetPose->IsAdditivePose() && pTargetPose->GetActiveAdditiveBoneIndices() != nullptr );
+
+        if ( pBoneMask != nullptr )
+        {
+            EE_ASSERT( pBoneMask->GetNumWeights() == pSourcePose->GetSkeleton()->GetNumBones() );
+        }
+
+        TVector<uint16_t> const& activeBoneIndices = *pTargetPose->GetActiveAdditiveBoneIndices();
+        int32_t const numBones = pResultPose->GetSkeleton()->GetNumBones( lod );
+        Transform const* pSourceTransforms = pSourcePose->m_pLocalTransforms;
+        Transform const* pTargetTransforms = pTargetPose->m_pLocalTransforms;
+        Transform* pResultTransforms = pResultPose->m_pLocalTransforms;
+
+        // All the inactive bones keep the source transform
+        if ( pResultPose != pSourcePose )
+        {
+            memcpy( pResultTransforms, pSourceTransforms, sizeof( Transform ) * numBones );
+        }
+
+        // The active bones are sorted, so we can stop as soon as we reach a bone that isnt part of this LOD
+        for ( uint16_t const boneIdx : activeBoneIndices )
+        {
+            if ( boneIdx >= numBones )
+            {
+                break;
+            }
+
+            float const boneBlendWeight = WeightFunction::GetBlendWeight( blendWeight, pBoneMask, boneIdx );
+            if ( boneBlendWeight == 0.0f )
+            {
+                continue;
+            }
+
+            Transform const& sourceTransform = pSourceTransforms[boneIdx];
+            Transform const& targetTransform = pTargetTransforms[boneIdx];
+            Transform& resultTransform = pResultTransforms[boneIdx];
+            resultTransform.SetTranslation( AdditiveBlender::BlendTranslation( sourceTransform.GetTranslation(), targetTransform.GetTranslation(), boneBlendWeight ) );
+            resultTransform.SetScale( AdditiveBlender::BlendScale( sourceTransform.GetScale(), targetTransform.GetScale(), boneBlendWeight ) );
+            resultTransform.SetRotation( AdditiveBlender::BlendRotation( sourceTransform.GetRotation(), targetTransform.GetRotation(), boneBlendWeight ) );
+        }
+
+        pResultPose->MarkAsValidPose();
+    }
+
+    //-------------------------------------------------------------------------
+
+    void Blender::Blend( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose )
     {
         pResultPose->ClearGlobalTransforms();
 
+        // Additive poses sampled from clips with identity tracks only need their active bones blended
+        //-------------------------------------------------------------------------
+
+        if ( blendOptions.IsFlagSet( PoseBlendOptions::Additive ) && !blendOptions.IsFlagSet( PoseBlendOptions::GlobalSpace ) && pTargetPose->GetActiveAdditiveBoneIndices() != nullptr )
+        {
+            if ( pBoneMask == nullptr )
+            {
+                BlendAdditiveActiveBones<BlendWeight>( lod, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+            }
+            else
+            {
+                BlendAdditiveActiveBones<BoneWeight>( lod, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+            }
+            return;
+        }
+
+        // Blending two additive poses sampled from the same clip doesnt change the set of active bones
+        TVector<uint16_t> const* pActiveAdditiveBoneIndices = nullptr;
+        if ( !blendOptions.IsFlagSet( PoseBlendOptions::Additive ) && pSourcePose->GetActiveAdditiveBoneIndices() == pTargetPose->GetActiveAdditiveBoneIndices() )
+        {
+            pActiveAdditiveBoneIndices = pSourcePose->GetActiveAdditiveBoneIndices();
+        }
+
+        //-------------------------------------------------------------------------
+
         if ( pBoneMask == nullptr )
         {
             if ( blendOptions.IsFlagSet( PoseBlendOptions::GlobalSpace ) )
             {
                 if ( blendOptions.IsFlagSet( PoseBlendOptions::Additive ) )
                 {
-                    BlenderGlobal<AdditiveBlender, BlendWeight>( pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+                    BlenderGlobal<AdditiveBlender, BlendWeight>( lod, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
                 }
                 else
                 {
-                    BlenderGlobal<InterpolativeBlender, BlendWeight>( pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+                    BlenderGlobal<InterpolativeBlender, BlendWeight>( lod, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
                 }
             }
             else
             {
                 if ( blendOptions.IsFlagSet( PoseBlendOptions::Additive ) )
                 {
-                    BlenderLocal<AdditiveBlender, BlendWeight>( pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+                    BlendLocalSpace<AdditiveBlender, BlendWeight>( lod, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
                 }
                 else
                 {
-                    BlenderLocal<InterpolativeBlender, BlendWeight>( pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+                    BlendLocalSpace<InterpolativeBlender, BlendWeight>( lod, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
                 }
             }
         }
@@ -167,24 +274,73 @@ namespace EE::Animation
 
                 if ( blendOptions.IsFlagSet( PoseBlendOptions::Additive ) )
                 {
-                    BlenderGlobal<AdditiveBlender, BoneWeight>( pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+                    BlenderGlobal<AdditiveBlender, BoneWeight>( lod, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
                 }
                 else
                 {
-                    BlenderGlobal<InterpolativeBlender, BoneWeight>( pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+                    BlenderGlobal<InterpolativeBlender, BoneWeight>( lod, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
                 }
             }
             else
             {
                 if ( blendOptions.IsFlagSet( PoseBlendOptions::Additive ) )
                 {
-                    BlenderLocal<AdditiveBlender, BoneWeight>( pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+                    BlendLocalSpace<AdditiveBlender, BoneWeight>( lod, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
                 }
                 else
                 {
-                    BlenderLocal<InterpolativeBlender, BoneWeight>( pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+                    BlendLocalSpace<InterpolativeBlender, BoneWeight>( lod, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
                 }
             }
         }
+
+        // Only valid if the result is still an additive pose i.e. we blended two additive poses
+        if ( pActiveAdditiveBoneIndices != nullptr && pResultPose->IsAdditivePose() )
+        {
+            pResultPose->m_pActiveAdditiveBoneIndices = pActiveAdditiveBoneIndices;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void Blender::BlendScalar( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose )
+    {
+        EE_ASSERT( blendWeight >= 0.0f && blendWeight <= 1.0f );
+        EE_ASSERT( pSourcePose != nullptr && pTargetPose != nullptr && pResultPose != nullptr );
+        EE_ASSERT( !blendOptions.IsFlagSet( PoseBlendOptions::GlobalSpace ) ); // Global space blends have no SIMD path
+
+        pResultPose->ClearGlobalTransforms();
+
+        int32_t const numBones = pResultPose->GetSkeleton()->GetNumBones( lod );
+        bool const isAdditive = blendOptions.IsFlagSet( PoseBlendOptions::Additive );
+
+        if ( pBoneMask == nullptr )
+        {
+            if ( isAdditive )
+            {
+                BlendLocalSpaceBones<AdditiveBlender, BlendWeight>( 0, numBones, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+            }
+            else
+            {
+                BlendLocalSpaceBones<InterpolativeBlender, BlendWeight>( 0, numBones, pSourcePose, pTargetPose, blendWeight, nullptr, pResultPose );
+            }
+        }
+        else
+        {
+            EE_ASSERT( pBoneMask->GetNumWeights() == pSourcePose->GetSkeleton()->GetNumBones() );
+
+            if ( isAdditive )
+            {
+                BlendLocalSpaceBones<AdditiveBlender, BoneWeight>( 0, numBones, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+            }
+            else
+            {
+                BlendLocalSpaceBones<InterpolativeBlender, BoneWeight>( 0, numBones, pSourcePose, pTargetPose, blendWeight, pBoneMask, pResultPose );
+            }
+        }
+
+        pResultPose->MarkAsValidPose();
     }
+    #endif
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Engine/_Module/API.h"
 #include "AnimationBoneMask.h"
 #include "Engine/Animation/AnimationPose.h"
+#include "Engine/Animation/AnimationPoseSoA.h"
 #include "System/Math/Quaternion.h"
 #include "System/Types/BitFlags.h"
 #include "System/TypeSystem/RegisteredType.h"
@@ -51,6 +52,28 @@ namespace EE::Animation
             {
                 return Math::Lerp( scale0, scale1, t );
             }
+
+            // SoA
+            //-------------------------------------------------------------------------
+
+            EE_FORCE_INLINE static QuaternionSoA4 BlendRotation( QuaternionSoA4 const& quat0, QuaternionSoA4 const& quat1, Vector const& t )
+            {
+                return QuaternionSoA4::SLerp( quat0, quat1, t );
+            }
+
+            EE_FORCE_INLINE static VectorSoA4 BlendTranslation( VectorSoA4 const& trans0, VectorSoA4 const& trans1, Vector const& t )
+            {
+                VectorSoA4 result;
+                result.m_x = Vector::MultiplyAdd( trans1.m_x - trans0.m_x, t, trans0.m_x );
+                result.m_y = Vector::MultiplyAdd( trans1.m_y - trans0.m_y, t, trans0.m_y );
+                result.m_z = Vector::MultiplyAdd( trans1.m_z - trans0.m_z, t, trans0.m_z );
+                return result;
+            }
+
+            EE_FORCE_INLINE static Vector BlendScale( Vector const& scale0, Vector const& scale1, Vector const& t )
+            {
+                return Vector::MultiplyAdd( scale1 - scale0, t, scale0 );
+            }
         };
 
         struct AdditiveBlender
@@ -70,6 +93,29 @@ namespace EE::Animation
             {
                 return scale0 + (scale1 * t );
             }
+
+            // SoA
+            //-------------------------------------------------------------------------
+
+            EE_FORCE_INLINE static QuaternionSoA4 BlendRotation( QuaternionSoA4 const& quat0, QuaternionSoA4 const& quat1, Vector const& t )
+            {
+                QuaternionSoA4 const targetQuat = QuaternionSoA4::Multiply( quat0, quat1 );
+                return QuaternionSoA4::SLerp( quat0, targetQuat, t );
+            }
+
+            EE_FORCE_INLINE static VectorSoA4 BlendTranslation( VectorSoA4 const& trans0, VectorSoA4 const& trans1, Vector const& t )
+            {
+                VectorSoA4 result;
+                result.m_x = Vector::MultiplyAdd( trans1.m_x, t, trans0.m_x );
+                result.m_y = Vector::MultiplyAdd( trans1.m_y, t, trans0.m_y );
+                result.m_z = Vector::MultiplyAdd( trans1.m_z, t, trans0.m_z );
+                return result;
+            }
+
+            EE_FORCE_INLINE static Vector BlendScale( Vector const& scale0, Vector const& scale1, Vector const& t )
+            {
+                return Vector::MultiplyAdd( scale1, t, scale0 );
+            }
         };
 
         struct BlendWeight
@@ -78,6 +124,11 @@ namespace EE::Animation
             {
                 return blendWeight;
             }
+
+            EE_FORCE_INLINE static Vector GetBlendWeights4( Vector const& blendWeight, BoneMask const* pBoneMask, int32_t const firstBoneIdx )
+            {
+                return blendWeight;
+            }
         };
 
         struct BoneWeight
@@ -86,11 +137,24 @@ namespace EE::Animation
             {
                 return blendWeight * pBoneMask->GetWeight( boneIdx );
             }
+
+            EE_FORCE_INLINE static Vector GetBlendWeights4( Vector const& blendWeight, BoneMask const* pBoneMask, int32_t const firstBoneIdx )
+            {
+                EE_ASSERT( firstBoneIdx + 3 < pBoneMask->GetNumWeights() );
+                return blendWeight * Vector( _mm_loadu_ps( pBoneMask->GetWeights() + firstBoneIdx ) );
+            }
         };
 
     public:
 
-        static void Blend( Pose const* pSourcePose, Pose const* pTargetPose, float blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose );
+        // Blend two poses together, only the bones needed for the specified LOD are blended
+        // Local space additive blends only touch the bones that are active in the target pose (see 'Pose::GetActiveAdditiveBoneIndices')
+        static void Blend( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose );
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Reference implementation of the local space blend that blends every bone individually without SIMD, only used to validate and benchmark 'Blend'
+        static void BlendScalar( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float blendWeight, TBitFlags<PoseBlendOptions> blendOptions, BoneMask const* pBoneMask, Pose* pResultPose );
+        #endif
 
         //-------------------------------------------------------------------------
 
@@ -124,5 +188,19 @@ namespace EE::Animation
 
             return result;
         }
+
+    private:
+
+        // Blend all the bones for the specified LOD in local space, bones are transposed into SoA form and blended four at a time
+        template<typename BlendFunction, typename WeightFunction>
+        static void BlendLocalSpace( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose );
+
+        // Blend a range of bones in local space one bone at a time
+        template<typename BlendFunction, typename WeightFunction>
+        static void BlendLocalSpaceBones( int32_t startBoneIdx, int32_t endBoneIdx, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose );
+
+        // Additively blend only the bones that are active in the target additive pose, all other bones keep the source transform
+        template<typename WeightFunction>
+        static void BlendAdditiveActiveBones( Skeleton::LOD lod, Pose const* pSourcePose, Pose const* pTargetPose, float const blendWeight, BoneMask const* pBoneMask, Pose* pResultPose );
     };
 }
\ No newline at end of file
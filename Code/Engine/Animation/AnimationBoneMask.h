@@ -93,6 +93,7 @@ namespace EE::Animation
         inline Skeleton const* GetSkeleton() const { return m_pSkeleton; }
         inline int32_t GetNumWeights() const { return (int32_t) m_weights.size(); }
         inline float GetWeight( uint32_t i ) const { EE_ASSERT( i < (uint32_t) m_weights.size() ); return m_weights[i]; }
+        inline float const* GetWeights() const { return m_weights.data(); }
         inline float operator[]( uint32_t i ) const { return GetWeight( i ); }
         BoneMask& operator*=( BoneMask const& rhs );
 
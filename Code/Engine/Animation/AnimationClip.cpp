@@ -1,47 +1,296 @@
 #include "AnimationClip.h"
 #include "Engine/Animation/AnimationPose.h"
 #include "System/Drawing/DebugDrawing.h"
+#include <eastl/algorithm.h>
 
 //-------------------------------------------------------------------------
 
 namespace EE::Animation
 {
-    void AnimationClip::GetPose( FrameTime const& frameTime, Pose* pOutPose ) const
+    void AnimationClip::GetPoses( PoseSampleRequest const* pRequests, int32_t numRequests ) const
     {
         EE_ASSERT( IsValid() );
-        EE_ASSERT( pOutPose != nullptr && pOutPose->GetSkeleton() == m_skeleton.GetPtr() );
-        EE_ASSERT( frameTime.GetFrameIndex() < m_numFrames );
+        EE_ASSERT( pRequests != nullptr && numRequests > 0 );
 
-        pOutPose->ClearGlobalTransforms();
+        // Track indices are sorted by bone index and the low LOD bones are stored first, so we only need to find the number of tracks to sample per LOD
+        //-------------------------------------------------------------------------
+
+        int32_t numDenseTracks[2];
+        int32_t numSparseTracks[2];
+        int32_t numSIMDTracks[2];
+
+        for ( auto lod : { Skeleton::LOD::Low, Skeleton::LOD::High } )
+        {
+            int32_t const lodIdx = (int32_t) lod;
+            int32_t const numBonesToSample = m_skeleton->GetNumBones( lod );
+            numDenseTracks[lodIdx] = (int32_t) ( eastl::lower_bound( m_denseTrackIndices.begin(), m_denseTrackIndices.end(), (uint16_t) numBonesToSample ) - m_denseTrackIndices.begin() );
+            numSparseTracks[lodIdx] = (int32_t) ( eastl::lower_bound( m_sparseTrackIndices.begin(), m_sparseTrackIndices.end(), (uint16_t) numBonesToSample ) - m_sparseTrackIndices.begin() );
 
+            // Dense tracks are decoded in groups of 4 using SIMD, any remaining tracks are decoded individually
+            numSIMDTracks[lodIdx] = numDenseTracks[lodIdx] & ~3;
+        }
+
+        int32_t maxNumSIMDTracks = 0;
+        for ( int32_t r = 0; r < numRequests; r++ )
+        {
+            PoseSampleRequest const& request = pRequests[r];
+            EE_ASSERT( request.m_pPose != nullptr && request.m_pPose->GetSkeleton() == m_skeleton.GetPtr() );
+            EE_ASSERT( request.m_frameTime.GetFrameIndex() < m_numFrames );
+            request.m_pPose->ClearGlobalTransforms();
+            maxNumSIMDTracks = Math::Max( maxNumSIMDTracks, numSIMDTracks[(int32_t) request.m_lod] );
+        }
+
+        // Decode the SIMD track groups for all requests
         //-------------------------------------------------------------------------
+        // The track group data is only prepared once, and all the requests read from the same compressed data so it stays hot in the cache
 
-        Transform boneTransform;
-        uint16_t const* pTrackData = m_compressedPoseData.data();
+        TrackGroup4 group;
+        Transform transforms0[4];
+        Transform transforms1[4];
 
-        // Read exact key frame
-        if ( frameTime.IsExactlyAtKeyFrame() )
+        for ( int32_t i = 0; i < maxNumSIMDTracks; i += 4 )
+        {
+            InitializeTrackGroup4( &m_denseTrackIndices[i], group );
+
+            for ( int32_t r = 0; r < numRequests; r++ )
+            {
+                PoseSampleRequest const& request = pRequests[r];
+                if ( i >= numSIMDTracks[(int32_t) request.m_lod] )
+                {
+                    continue;
+                }
+
+                Transform* pLocalTransforms = request.m_pPose->m_pLocalTransforms;
+                uint32_t const frameIdx = request.m_frameTime.GetFrameIndex();
+
+                // Read exact key frame
+                if ( request.m_frameTime.IsExactlyAtKeyFrame() )
+                {
+                    ReadCompressedTrackKeyFrames4( group, frameIdx, transforms0 );
+
+                    for ( int32_t j = 0; j < 4; j++ )
+                    {
+                        pLocalTransforms[m_denseTrackIndices[i + j]] = transforms0[j];
+                    }
+                }
+                else // Read interpolated transforms
+                {
+                    Percentage const percentageThrough = request.m_frameTime.GetPercentageThrough();
+                    ReadCompressedTrackKeyFrames4( group, frameIdx, transforms0 );
+                    ReadCompressedTrackKeyFrames4( group, frameIdx + 1, transforms1 );
+
+                    for ( int32_t j = 0; j < 4; j++ )
+                    {
+                        pLocalTransforms[m_denseTrackIndices[i + j]] = Transform::Slerp( transforms0[j], transforms1[j], percentageThrough );
+                    }
+                }
+            }
+        }
+
+        // Decode the remaining dense tracks and the sparse tracks individually
+        //-------------------------------------------------------------------------
+
+        for ( int32_t r = 0; r < numRequests; r++ )
         {
-            auto const numBones = m_skeleton->GetNumBones();
-            for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            PoseSampleRequest const& request = pRequests[r];
+            int32_t const lodIdx = (int32_t) request.m_lod;
+            Pose* pOutPose = request.m_pPose;
+            FrameTime const& frameTime = request.m_frameTime;
+            uint32_t const frameIdx = frameTime.GetFrameIndex();
+
+            if ( frameTime.IsExactlyAtKeyFrame() )
+            {
+                for ( int32_t i = numSIMDTracks[lodIdx]; i < numDenseTracks[lodIdx]; i++ )
+                {
+                    uint16_t const boneIdx = m_denseTrackIndices[i];
+                    ReadCompressedTrackKeyFrame( m_trackCompressionSettings[boneIdx], frameIdx, pOutPose->m_pLocalTransforms[boneIdx] );
+                }
+            }
+            else
+            {
+                for ( int32_t i = numSIMDTracks[lodIdx]; i < numDenseTracks[lodIdx]; i++ )
+                {
+                    uint16_t const boneIdx = m_denseTrackIndices[i];
+                    ReadCompressedTrackTransform( m_trackCompressionSettings[boneIdx], frameTime, pOutPose->m_pLocalTransforms[boneIdx] );
+                }
+            }
+
+            // Sparse tracks are always interpolated between their stored keys
+            for ( int32_t i = 0; i < numSparseTracks[lodIdx]; i++ )
+            {
+                uint16_t const boneIdx = m_sparseTrackIndices[i];
+                ReadCompressedSparseTrackTransform( m_trackCompressionSettings[boneIdx], frameIdx, frameTime.GetPercentageThrough(), pOutPose->m_pLocalTransforms[boneIdx] );
+            }
+
+            // Flag the pose as being set
+            pOutPose->m_state = m_isAdditive ? Pose::State::AdditivePose : Pose::State::Pose;
+            pOutPose->m_pActiveAdditiveBoneIndices = ( m_isAdditive && m_activeAdditiveBoneIndices.size() < m_trackCompressionSettings.size() ) ? &m_activeAdditiveBoneIndices : nullptr;
+        }
+    }
+
+    void AnimationClip::InitializeTrackGroup4( uint16_t const* pTrackIndices, TrackGroup4& outGroup ) const
+    {
+        EE_ASSERT( pTrackIndices != nullptr );
+
+        static constexpr float const maxEncodedStaticValue = float( 0xFFFF );
+
+        for ( int32_t i = 0; i < 4; i++ )
+        {
+            TrackCompressionSettings const* pTrackSettings = &m_trackCompressionSettings[pTrackIndices[i]];
+            EE_ASSERT( !pTrackSettings->IsSparseTrack() );
+            outGroup.m_pTrackSettings[i] = pTrackSettings;
+
+            // Static values are constant for the whole clip so we can read them once here, animated values are read per frame
+            uint16_t const* pTrackStaticData = m_compressedPoseData.data() + pTrackSettings->m_staticDataOffset;
+
+            if ( pTrackSettings->IsTranslationTrackStatic() )
+            {
+                for ( int32_t c = 0; c < 3; c++ )
+                {
+                    outGroup.m_staticEncodedValues[c][i] = *pTrackStaticData++;
+                    outGroup.m_maxEncodedValues[c][i] = maxEncodedStaticValue;
+                }
+            }
+            else
+            {
+                outGroup.m_maxEncodedValues[0][i] = float( ( 1u << pTrackSettings->m_translationBitsX ) - 1 );
+                outGroup.m_maxEncodedValues[1][i] = float( ( 1u << pTrackSettings->m_translationBitsY ) - 1 );
+                outGroup.m_maxEncodedValues[2][i] = float( ( 1u << pTrackSettings->m_translationBitsZ ) - 1 );
+            }
+
+            if ( pTrackSettings->IsScaleTrackStatic() )
+            {
+                outGroup.m_staticEncodedValues[3][i] = *pTrackStaticData++;
+                outGroup.m_maxEncodedValues[3][i] = maxEncodedStaticValue;
+            }
+            else
             {
-                pTrackData = ReadCompressedTrackKeyFrame( pTrackData, m_trackCompressionSettings[boneIdx], frameTime.GetFrameIndex(), boneTransform );
-                pOutPose->m_localTransforms[boneIdx] = boneTransform;
+                outGroup.m_maxEncodedValues[3][i] = float( ( 1u << pTrackSettings->m_scaleBits ) - 1 );
             }
         }
-        else // Read interpolated anim pose
+
+        TrackCompressionSettings const* const* pTS = outGroup.m_pTrackSettings;
+        outGroup.m_translationRangeStart[0] = Vector( pTS[0]->m_translationRangeX.m_rangeStart, pTS[1]->m_translationRangeX.m_rangeStart, pTS[2]->m_translationRangeX.m_rangeStart, pTS[3]->m_translationRangeX.m_rangeStart );
+        outGroup.m_translationRangeStart[1] = Vector( pTS[0]->m_translationRangeY.m_rangeStart, pTS[1]->m_translationRangeY.m_rangeStart, pTS[2]->m_translationRangeY.m_rangeStart, pTS[3]->m_translationRangeY.m_rangeStart );
+        outGroup.m_translationRangeStart[2] = Vector( pTS[0]->m_translationRangeZ.m_rangeStart, pTS[1]->m_translationRangeZ.m_rangeStart, pTS[2]->m_translationRangeZ.m_rangeStart, pTS[3]->m_translationRangeZ.m_rangeStart );
+        outGroup.m_translationRangeLength[0] = Vector( pTS[0]->m_translationRangeX.m_rangeLength, pTS[1]->m_translationRangeX.m_rangeLength, pTS[2]->m_translationRangeX.m_rangeLength, pTS[3]->m_translationRangeX.m_rangeLength );
+        outGroup.m_translationRangeLength[1] = Vector( pTS[0]->m_translationRangeY.m_rangeLength, pTS[1]->m_translationRangeY.m_rangeLength, pTS[2]->m_translationRangeY.m_rangeLength, pTS[3]->m_translationRangeY.m_rangeLength );
+        outGroup.m_translationRangeLength[2] = Vector( pTS[0]->m_translationRangeZ.m_rangeLength, pTS[1]->m_translationRangeZ.m_rangeLength, pTS[2]->m_translationRangeZ.m_rangeLength, pTS[3]->m_translationRangeZ.m_rangeLength );
+        outGroup.m_scaleRangeStart = Vector( pTS[0]->m_scaleRange.m_rangeStart, pTS[1]->m_scaleRange.m_rangeStart, pTS[2]->m_scaleRange.m_rangeStart, pTS[3]->m_scaleRange.m_rangeStart );
+        outGroup.m_scaleRangeLength = Vector( pTS[0]->m_scaleRange.m_rangeLength, pTS[1]->m_scaleRange.m_rangeLength, pTS[2]->m_scaleRange.m_rangeLength, pTS[3]->m_scaleRange.m_rangeLength );
+    }
+
+    void AnimationClip::ReadCompressedTrackKeyFrames4( TrackGroup4 const& group, uint32_t frameIdx, Transform* pOutTransforms ) const
+    {
+        EE_ASSERT( pOutTransforms != nullptr );
+        EE_ASSERT( frameIdx < m_numFrames );
+
+        // Rotations are 48bits (3 x uint16_t)
+        static constexpr uint32_t const rotationStride = 3;
+
+        // Find the key-frame data for each track
+        //-------------------------------------------------------------------------
+        // All tracks' animated data for a frame lives in the same frame block, so this only touches a couple of cache lines
+
+        uint16_t const* pFrameData = GetFrameData( frameIdx );
+        uint16_t const* pRotationData[4];
+
+        // The encoded translation (x,y,z) and scale values per track, stored as SoA i.e. [component][track]
+        alignas( 16 ) int32_t encodedValues[4][4];
+        memcpy( encodedValues, group.m_staticEncodedValues, sizeof( encodedValues ) );
+
+        for ( int32_t i = 0; i < 4; i++ )
         {
-            auto const numBones = m_skeleton->GetNumBones();
-            for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            TrackCompressionSettings const* pTrackSettings = group.m_pTrackSettings[i];
+            uint16_t const* pTrackFrameData = pFrameData + pTrackSettings->m_frameDataOffset;
+
+            pRotationData[i] = pTrackFrameData;
+            pTrackFrameData += rotationStride;
+
+            uint32_t bitOffset = 0;
+            auto ReadPackedValue = [&] ( int32_t componentIdx, uint32_t numBits )
             {
-                pTrackData = ReadCompressedTrackTransform( pTrackData, m_trackCompressionSettings[boneIdx], frameTime, boneTransform );
-                pOutPose->m_localTransforms[boneIdx] = boneTransform;
+                encodedValues[componentIdx][i] = Quantization::ReadPackedBits( pTrackFrameData, bitOffset, numBits );
+                bitOffset += numBits;
+            };
+
+            if ( !pTrackSettings->IsTranslationTrackStatic() )
+            {
+                ReadPackedValue( 0, pTrackSettings->m_translationBitsX );
+                ReadPackedValue( 1, pTrackSettings->m_translationBitsY );
+                ReadPackedValue( 2, pTrackSettings->m_translationBitsZ );
+            }
+
+            if ( !pTrackSettings->IsScaleTrackStatic() )
+            {
+                ReadPackedValue( 3, pTrackSettings->m_scaleBits );
             }
         }
 
-        // Flag the pose as being set
+        // Decode rotations
+        //-------------------------------------------------------------------------
+
+        Quaternion rotations[4];
+
+        {
+            __m128i const data0 = _mm_setr_epi32( pRotationData[0][0], pRotationData[1][0], pRotationData[2][0], pRotationData[3][0] );
+            __m128i const data1 = _mm_setr_epi32( pRotationData[0][1], pRotationData[1][1], pRotationData[2][1], pRotationData[3][1] );
+            __m128i const data2 = _mm_setr_epi32( pRotationData[0][2], pRotationData[1][2], pRotationData[2][2], pRotationData[3][2] );
+            Quantization::EncodedQuaternion::ToQuaternions4( data0, data1, data2, rotations );
+        }
+
+        // Decode translations
+        //-------------------------------------------------------------------------
+
+        __m128 translationX, translationY, translationZ, translationW = _mm_setzero_ps();
+
+        {
+            translationX = Quantization::DecodeFloat4( _mm_load_si128( (__m128i const*) encodedValues[0] ), group.m_translationRangeStart[0], group.m_translationRangeLength[0], _mm_load_ps( group.m_maxEncodedValues[0] ) );
+            translationY = Quantization::DecodeFloat4( _mm_load_si128( (__m128i const*) encodedValues[1] ), group.m_translationRangeStart[1], group.m_translationRangeLength[1], _mm_load_ps( group.m_maxEncodedValues[1] ) );
+            translationZ = Quantization::DecodeFloat4( _mm_load_si128( (__m128i const*) encodedValues[2] ), group.m_translationRangeStart[2], group.m_translationRangeLength[2], _mm_load_ps( group.m_maxEncodedValues[2] ) );
+
+            // Convert from SoA to AoS
+            _MM_TRANSPOSE4_PS( translationX, translationY, translationZ, translationW );
+        }
+
+        // Decode scales
+        //-------------------------------------------------------------------------
+
+        alignas( 16 ) float scales[4];
+        _mm_store_ps( scales, Quantization::DecodeFloat4( _mm_load_si128( (__m128i const*) encodedValues[3] ), group.m_scaleRangeStart, group.m_scaleRangeLength, _mm_load_ps( group.m_maxEncodedValues[3] ) ) );
+
+        //-------------------------------------------------------------------------
+
+        pOutTransforms[0] = Transform( rotations[0], translationX, scales[0] );
+        pOutTransforms[1] = Transform( rotations[1], translationY, scales[1] );
+        pOutTransforms[2] = Transform( rotations[2], translationZ, scales[2] );
+        pOutTransforms[3] = Transform( rotations[3], translationW, scales[3] );
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void AnimationClip::GetPoseScalar( FrameTime const& frameTime, Pose* pOutPose, Skeleton::LOD lod ) const
+    {
+        EE_ASSERT( IsValid() );
+        EE_ASSERT( pOutPose != nullptr && pOutPose->GetSkeleton() == m_skeleton.GetPtr() );
+        EE_ASSERT( frameTime.GetFrameIndex() < m_numFrames );
+
+        pOutPose->ClearGlobalTransforms();
+
+        // The low LOD bones are stored first, so we only need to sample the first N bones
+        int32_t const numBonesToSample = m_skeleton->GetNumBones( lod );
+        for ( int32_t boneIdx = 0; boneIdx < numBonesToSample; boneIdx++ )
+        {
+            pOutPose->m_pLocalTransforms[boneIdx] = GetLocalSpaceTransform( boneIdx, frameTime );
+        }
+
         pOutPose->m_state = m_isAdditive ? Pose::State::AdditivePose : Pose::State::Pose;
+        pOutPose->m_pActiveAdditiveBoneIndices = ( m_isAdditive && m_activeAdditiveBoneIndices.size() < m_trackCompressionSettings.size() ) ? &m_activeAdditiveBoneIndices : nullptr;
     }
+    #endif
+
+    //-------------------------------------------------------------------------
 
     Transform AnimationClip::GetLocalSpaceTransform( int32_t boneIdx, FrameTime const& frameTime ) const
     {
@@ -53,7 +302,6 @@ namespace EE::Animation
         //-------------------------------------------------------------------------
 
         auto const& trackSettings = m_trackCompressionSettings[boneIdx];
-        uint16_t const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
 
         //-------------------------------------------------------------------------
 
@@ -61,11 +309,11 @@ namespace EE::Animation
 
         if ( frameTime.IsExactlyAtKeyFrame() )
         {
-            ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, boneLocalTransform );
+            ReadCompressedTrackKeyFrame( trackSettings, frameIdx, boneLocalTransform );
         }
         else
         {
-            ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, boneLocalTransform );
+            ReadCompressedTrackTransform( trackSettings, frameTime, boneLocalTransform );
         }
         return boneLocalTransform;
     }
@@ -99,9 +347,7 @@ namespace EE::Animation
         {
             // Read root transform
             {
-                auto const& trackSettings = m_trackCompressionSettings[boneHierarchy.back()];
-                uint16_t const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, globalTransform );
+                ReadCompressedTrackKeyFrame( m_trackCompressionSettings[boneHierarchy.back()], frameIdx, globalTransform );
             }
 
             // Read and multiply out all the transforms moving down the hierarchy
@@ -109,9 +355,7 @@ namespace EE::Animation
             for ( int32_t i = (int32_t) boneHierarchy.size() - 2; i >= 0; i-- )
             {
                 int32_t const trackIdx = boneHierarchy[i];
-                auto const& trackSettings = m_trackCompressionSettings[trackIdx];
-                uint16_t const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackKeyFrame( pTrackData, trackSettings, frameIdx, localTransform );
+                ReadCompressedTrackKeyFrame( m_trackCompressionSettings[trackIdx], frameIdx, localTransform );
 
                 globalTransform = localTransform * globalTransform;
             }
@@ -120,9 +364,7 @@ namespace EE::Animation
         {
             // Read root transform
             {
-                auto const& trackSettings = m_trackCompressionSettings[boneHierarchy.back()];
-                uint16_t const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, globalTransform );
+                ReadCompressedTrackTransform( m_trackCompressionSettings[boneHierarchy.back()], frameTime, globalTransform );
             }
 
             // Read and multiply out all the transforms moving down the hierarchy
@@ -130,9 +372,7 @@ namespace EE::Animation
             for ( int32_t i = (int32_t) boneHierarchy.size() - 2; i >= 0; i-- )
             {
                 int32_t const trackIdx = boneHierarchy[i];
-                auto const& trackSettings = m_trackCompressionSettings[trackIdx];
-                uint16_t const* pTrackData = m_compressedPoseData.data() + trackSettings.m_trackStartIndex;
-                ReadCompressedTrackTransform( pTrackData, trackSettings, frameTime, localTransform );
+                ReadCompressedTrackTransform( m_trackCompressionSettings[trackIdx], frameTime, localTransform );
 
                 globalTransform = localTransform * globalTransform;
             }
@@ -9,6 +9,7 @@
 #include "System/Math/NumericRange.h"
 #include "System/Time/Time.h"
 #include "System/Algorithm/Quantization.h"
+#include <eastl/algorithm.h>
 
 //-------------------------------------------------------------------------
 
@@ -42,7 +43,7 @@ namespace EE::Animation
 
     struct TrackCompressionSettings
     {
-        EE_SERIALIZE( m_translationRangeX, m_translationRangeY, m_translationRangeZ, m_scaleRange, m_trackStartIndex, m_isTranslationStatic, m_isScaleStatic );
+        EE_SERIALIZE( m_translationRangeX, m_translationRangeY, m_translationRangeZ, m_scaleRange, m_frameDataOffset, m_staticDataOffset, m_sparseDataOffset, m_numSparseKeys, m_translationBitsX, m_translationBitsY, m_translationBitsZ, m_scaleBits, m_isTranslationStatic, m_isScaleStatic );
 
         friend class AnimationClipCompiler;
 
@@ -56,13 +57,29 @@ namespace EE::Animation
         // Is the scale for this track static i.e. a fixed value for the duration of the animation
         inline bool IsScaleTrackStatic() const { return m_isScaleStatic; }
 
+        // Is this a key-reduced track i.e. it only stores a subset of the key frames in the sparse data block rather than a key per frame
+        inline bool IsSparseTrack() const { return m_numSparseKeys > 0; }
+
+        // Get the number of bits needed to store the animated translation/scale values for a single key
+        inline uint32_t GetNumAnimatedDataBits() const { return ( m_isTranslationStatic ? 0 : ( m_translationBitsX + m_translationBitsY + m_translationBitsZ ) ) + ( m_isScaleStatic ? 0 : m_scaleBits ); }
+
+        // Get the number of uint16s needed to store a single key for this track (rotation + bit-packed animated translation/scale)
+        inline uint32_t GetKeyStride() const { return 3 + ( ( GetNumAnimatedDataBits() + 15 ) / 16 ); }
+
     public:
 
         QuantizationRange                       m_translationRangeX;
         QuantizationRange                       m_translationRangeY;
         QuantizationRange                       m_translationRangeZ;
         QuantizationRange                       m_scaleRange;
-        uint32_t                                m_trackStartIndex = 0; // The start offset for this track in the compressed data block (in number of uint16s)
+        uint32_t                                m_frameDataOffset = 0; // The offset for this track's animated data within each frame block (in number of uint16s)
+        uint32_t                                m_staticDataOffset = 0; // The offset for this track's static data within the static data block (in number of uint16s)
+        uint32_t                                m_sparseDataOffset = 0; // The start offset for a sparse track's key data in the compressed data block (in number of uint16s)
+        uint16_t                                m_numSparseKeys = 0; // The number of keys stored for a sparse track, zero for tracks with a key per frame
+        uint8_t                                 m_translationBitsX = 16; // The number of bits used to store each animated translation component, static values always use 16 bits
+        uint8_t                                 m_translationBitsY = 16;
+        uint8_t                                 m_translationBitsZ = 16;
+        uint8_t                                 m_scaleBits = 16; // The number of bits used to store each animated scale value, static values always use 16 bits
 
     private:
 
@@ -71,11 +88,21 @@ namespace EE::Animation
     };
 
     //-------------------------------------------------------------------------
+    // Animation Clip
+    //-------------------------------------------------------------------------
+    // The compressed pose data is stored frame-interleaved so that sampling a single frame only touches a small contiguous block of memory:
+    // [Static Data] -> the static translation/scale values for all tracks
+    // [Frame 0] -> [Track 0: rotation, animated translation, animated scale] [Track 1: ...] ...
+    // Rotations are always 48bits, animated translation/scale values are bit-packed using each track's bit-widths and padded to a uint16 boundary
+    // [Frame 1] -> ...
+    // [Sparse Data] -> for each key-reduced track: [Key frame indices] [Key 0: rotation, animated translation, animated scale] [Key 1: ...] ...
+    //
+    // Key-reduced (sparse) tracks are not present in the frame blocks, they are interpolated between their surrounding keys when sampled.
 
     class EE_ENGINE_API AnimationClip : public Resource::IResource
     {
         EE_REGISTER_RESOURCE( 'anim', "Animation Clip" );
-        EE_SERIALIZE( m_skeleton, m_numFrames, m_duration, m_compressedPoseData, m_trackCompressionSettings, m_rootMotion, m_isAdditive );
+        EE_SERIALIZE( m_skeleton, m_numFrames, m_duration, m_compressedPoseData, m_frameDataStartIndex, m_frameDataStride, m_trackCompressionSettings, m_denseTrackIndices, m_sparseTrackIndices, m_eventStartTimes, m_eventMaxEndTimes, m_rootMotion, m_isAdditive, m_activeAdditiveBoneIndices );
 
         friend class AnimationClipCompiler;
         friend class AnimationClipLoader;
@@ -102,6 +129,21 @@ namespace EE::Animation
             return s;
         }
 
+        inline static float DecodePackedFloat( uint16_t const* pData, uint32_t& bitOffset, uint32_t numBits, QuantizationRange const& range )
+        {
+            uint16_t const encodedValue = Quantization::ReadPackedBits( pData, bitOffset, numBits );
+            bitOffset += numBits;
+            return Quantization::DecodeFloat( encodedValue, range.m_rangeStart, range.m_rangeLength, numBits );
+        }
+
+        inline static Vector DecodePackedTranslation( uint16_t const* pData, uint32_t& bitOffset, TrackCompressionSettings const& settings )
+        {
+            float const m_x = DecodePackedFloat( pData, bitOffset, settings.m_translationBitsX, settings.m_translationRangeX );
+            float const m_y = DecodePackedFloat( pData, bitOffset, settings.m_translationBitsY, settings.m_translationRangeY );
+            float const m_z = DecodePackedFloat( pData, bitOffset, settings.m_translationBitsZ, settings.m_translationRangeZ );
+            return Vector( m_x, m_y, m_z );
+        }
+
     public:
 
         AnimationClip() = default;
@@ -115,6 +157,7 @@ namespace EE::Animation
 
         inline bool IsSingleFrameAnimation() const { return m_numFrames == 1; }
         inline bool IsAdditive() const { return m_isAdditive; }
+        inline TVector<uint16_t> const& GetActiveAdditiveBoneIndices() const { EE_ASSERT( m_isAdditive ); return m_activeAdditiveBoneIndices; }
         inline float GetFPS() const { return float( m_numFrames - 1 ) / m_duration; }
         inline uint32_t GetNumFrames() const { return m_numFrames; }
         inline Seconds GetDuration() const { return m_duration; }
@@ -127,8 +170,24 @@ namespace EE::Animation
         // Pose
         //-------------------------------------------------------------------------
 
-        void GetPose( FrameTime const& frameTime, Pose* pOutPose ) const;
-        inline void GetPose( Percentage percentageThrough, Pose* pOutPose ) const { GetPose( GetFrameTime( percentageThrough ), pOutPose ); }
+        struct PoseSampleRequest
+        {
+            FrameTime                           m_frameTime;
+            Pose*                               m_pPose = nullptr;
+            Skeleton::LOD                       m_lod = Skeleton::LOD::High;
+        };
+
+        // Sample the pose for the specified time, at the low LOD only the low LOD bones are sampled and the remaining bones are left untouched
+        inline void GetPose( FrameTime const& frameTime, Pose* pOutPose, Skeleton::LOD lod = Skeleton::LOD::High ) const { PoseSampleRequest const request = { frameTime, pOutPose, lod }; GetPoses( &request, 1 ); }
+        inline void GetPose( Percentage percentageThrough, Pose* pOutPose, Skeleton::LOD lod = Skeleton::LOD::High ) const { GetPose( GetFrameTime( percentageThrough ), pOutPose, lod ); }
+
+        // Sample multiple poses at once, the frame independent decoding data for each group of tracks is only prepared once and shared by all the requests
+        void GetPoses( PoseSampleRequest const* pRequests, int32_t numRequests ) const;
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Reference implementation of 'GetPose' that decodes every track individually without SIMD, only used to validate and benchmark the SIMD decoding
+        void GetPoseScalar( FrameTime const& frameTime, Pose* pOutPose, Skeleton::LOD lod = Skeleton::LOD::High ) const;
+        #endif
 
         Transform GetLocalSpaceTransform( int32_t boneIdx, FrameTime const& frameTime ) const;
         inline Transform GetLocalSpaceTransform( int32_t boneIdx, Percentage percentageThrough ) const{ return GetLocalSpaceTransform( boneIdx, GetFrameTime( percentageThrough ) ); }
@@ -192,9 +251,40 @@ namespace EE::Animation
 
     private:
 
-        // Read a compressed transform from a track and return a pointer to the data for the next track
-        inline uint16_t const* ReadCompressedTrackTransform( uint16_t const* pTrackData, TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const;
-        inline uint16_t const* ReadCompressedTrackKeyFrame( uint16_t const* pTrackData, TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Transform& outTransform ) const;
+        // Get the start of the frame block for the specified frame
+        EE_FORCE_INLINE uint16_t const* GetFrameData( uint32_t frameIdx ) const { return m_compressedPoseData.data() + m_frameDataStartIndex + ( frameIdx * m_frameDataStride ); }
+
+        // Decode a single key from the supplied animated data, static values are read from the static data block
+        inline void ReadCompressedTrackKey( TrackCompressionSettings const& trackSettings, uint16_t const* pKeyData, Transform& outTransform ) const;
+
+        // Read a compressed transform from a track for the specified (interpolated) frame time
+        inline void ReadCompressedTrackTransform( TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const;
+
+        // Read a compressed transform from a track for the specified key frame
+        inline void ReadCompressedTrackKeyFrame( TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Transform& outTransform ) const;
+
+        // Read a transform from a sparse track, interpolating between the surrounding stored keys
+        inline void ReadCompressedSparseTrackTransform( TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Percentage percentageThrough, Transform& outTransform ) const;
+
+        // The frame independent data needed to decode a group of four dense tracks
+        struct TrackGroup4
+        {
+            TrackCompressionSettings const*     m_pTrackSettings[4];
+            Vector                              m_translationRangeStart[3];
+            Vector                              m_translationRangeLength[3];
+            Vector                              m_scaleRangeStart;
+            Vector                              m_scaleRangeLength;
+
+            // The encoded static values and the max encoded values for the translation (x,y,z) and scale components, stored as SoA i.e. [component][track]
+            alignas( 16 ) int32_t               m_staticEncodedValues[4][4];
+            alignas( 16 ) float                 m_maxEncodedValues[4][4];
+        };
+
+        // Prepare the decoding data for four dense tracks
+        void InitializeTrackGroup4( uint16_t const* pTrackIndices, TrackGroup4& outGroup ) const;
+
+        // Read the same key frame for four dense tracks at once (SIMD)
+        void ReadCompressedTrackKeyFrames4( TrackGroup4 const& group, uint32_t frameIdx, Transform* pOutTransforms ) const;
 
     private:
 
@@ -202,11 +292,18 @@ namespace EE::Animation
         uint32_t                                m_numFrames = 0;
         Seconds                                 m_duration = 0.0f;
         TVector<uint16_t>                       m_compressedPoseData;
+        uint32_t                                m_frameDataStartIndex = 0; // The start of the first frame block i.e. the size of the static data block (in number of uint16s)
+        uint32_t                                m_frameDataStride = 0; // The size of each frame block (in number of uint16s)
         TVector<TrackCompressionSettings>       m_trackCompressionSettings;
+        TVector<uint16_t>                       m_denseTrackIndices; // The tracks that have a key per frame and are stored in the frame blocks
+        TVector<uint16_t>                       m_sparseTrackIndices; // The key-reduced tracks stored in the sparse data block
         TVector<Event*>                         m_events;
+        TVector<float>                          m_eventStartTimes; // The start time of each event (events are sorted by start time)
+        TVector<float>                          m_eventMaxEndTimes; // The max end time of all events up to and including each event, allows us to skip all events that end before a query range
         SyncTrack                               m_syncTrack;
         RootMotionData                          m_rootMotion;
         bool                                    m_isAdditive = false;
+        TVector<uint16_t>                       m_activeAdditiveBoneIndices; // The non-identity tracks for additive clips (sorted), only these bones need to be blended
     };
 }
 
@@ -217,180 +314,143 @@ namespace EE::Animation
 
 namespace EE::Animation
 {
-    inline uint16_t const* AnimationClip::ReadCompressedTrackTransform( uint16_t const* pTrackData, TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const
+    inline void AnimationClip::ReadCompressedTrackKey( TrackCompressionSettings const& trackSettings, uint16_t const* pKeyData, Transform& outTransform ) const
     {
-        EE_ASSERT( pTrackData != nullptr );
+        EE_ASSERT( pKeyData != nullptr );
 
-        uint32_t const frameIdx = frameTime.GetFrameIndex();
-        Percentage const percentageThrough = frameTime.GetPercentageThrough();
-        EE_ASSERT( frameIdx < GetNumFrames() );
-
-        //-------------------------------------------------------------------------
+        // Rotations and static translations are 48bits (3 x uint16_t), static scales are 16bits (1 x uint16_t)
+        static constexpr uint32_t const rotationStride = 3;
+        static constexpr uint32_t const translationStride = 3;
 
-        Transform transform0;
-        Transform transform1;
+        uint16_t const* pStaticData = m_compressedPoseData.data() + trackSettings.m_staticDataOffset;
 
         //-------------------------------------------------------------------------
         // Read rotation
         //-------------------------------------------------------------------------
 
-        // Rotations are 48bits (3 x uint16_t)
-        static constexpr uint32_t const rotationStride = 3;
-
-        uint32_t PoseDataIdx0 = frameIdx * rotationStride;
-        uint32_t PoseDataIdx1 = PoseDataIdx0 + rotationStride;
-        EE_ASSERT( PoseDataIdx1 < ( m_numFrames * rotationStride ) );
-
-        transform0.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx0] ) );
-        transform1.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx1] ) );
+        outTransform.SetRotation( DecodeRotation( pKeyData ) );
+        pKeyData += rotationStride;
 
-        // Shift the track data ptr to the translation data
-        pTrackData += ( m_numFrames * rotationStride );
+        // Animated values are bit-packed after the rotation
+        uint32_t bitOffset = 0;
 
         //-------------------------------------------------------------------------
         // Read translation
         //-------------------------------------------------------------------------
 
-        // Translations are 48bits (3 x uint16_t)
-        static constexpr uint32_t const translationStride = 3;
-
         if ( trackSettings.IsTranslationTrackStatic() )
         {
-            Vector const translation = DecodeTranslation( pTrackData, trackSettings );
-            transform0.SetTranslation( translation );
-            transform1.SetTranslation( translation );
-
-            // Shift the track data ptr to the scale data
-            pTrackData += translationStride;
+            outTransform.SetTranslation( DecodeTranslation( pStaticData, trackSettings ) );
+            pStaticData += translationStride;
         }
-        else // Read the translation key-frames
+        else
         {
-            PoseDataIdx0 = frameIdx * translationStride;
-            PoseDataIdx1 = PoseDataIdx0 + translationStride;
-            EE_ASSERT( PoseDataIdx1 < ( m_numFrames * translationStride ) );
-
-            transform0.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx0], trackSettings ) );
-            transform1.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx1], trackSettings ) );
-
-            // Shift the track data ptr to the translation data
-            pTrackData += ( m_numFrames * rotationStride );
+            outTransform.SetTranslation( DecodePackedTranslation( pKeyData, bitOffset, trackSettings ) );
         }
 
         //-------------------------------------------------------------------------
         // Read scale
         //-------------------------------------------------------------------------
 
-        // Scales are 16bits (1 x uint16_t)
-        static constexpr uint32_t const scaleStride = 1;
-
         if ( trackSettings.IsScaleTrackStatic() )
         {
-            float const scale = DecodeScale( pTrackData, trackSettings );
-            transform0.SetScale( scale );
-            transform1.SetScale( scale );
-
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += scaleStride;
+            outTransform.SetScale( DecodeScale( pStaticData, trackSettings ) );
         }
-        else // Read the scale key-frames
+        else
         {
-            PoseDataIdx0 = frameIdx * scaleStride;
-            PoseDataIdx1 = PoseDataIdx0 + scaleStride;
-            EE_ASSERT( PoseDataIdx1 < ( m_numFrames * scaleStride ) );
-
-            transform0.SetScale( DecodeScale( &pTrackData[PoseDataIdx0], trackSettings ) );
-            transform1.SetScale( DecodeScale( &pTrackData[PoseDataIdx1], trackSettings ) );
-
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += ( m_numFrames * scaleStride );
+            outTransform.SetScale( DecodePackedFloat( pKeyData, bitOffset, trackSettings.m_scaleBits, trackSettings.m_scaleRange ) );
         }
-
-        //-------------------------------------------------------------------------
-
-        outTransform = Transform::Slerp( transform0, transform1, percentageThrough );
-
-        //-------------------------------------------------------------------------
-
-        return pTrackData;
     }
 
     //-------------------------------------------------------------------------
 
-    inline uint16_t const* AnimationClip::ReadCompressedTrackKeyFrame( uint16_t const* pTrackData, TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Transform& outTransform ) const
+    inline void AnimationClip::ReadCompressedTrackKeyFrame( TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Transform& outTransform ) const
     {
-        EE_ASSERT( pTrackData != nullptr );
         EE_ASSERT( frameIdx < GetNumFrames() );
 
-        //-------------------------------------------------------------------------
-        // Read rotation
-        //-------------------------------------------------------------------------
-
-        // Rotations are 48bits (3 x uint16_t)
-        static constexpr uint32_t const rotationStride = 3;
-
-        uint32_t PoseDataIdx = frameIdx * rotationStride;
-        EE_ASSERT( PoseDataIdx < ( m_numFrames * rotationStride ) );
-
-        outTransform.SetRotation( DecodeRotation( &pTrackData[PoseDataIdx] ) );
-
-        // Shift the track data ptr to the translation data
-        pTrackData += ( m_numFrames * rotationStride );
-
-        //-------------------------------------------------------------------------
-        // Read translation
-        //-------------------------------------------------------------------------
-
-        // Translations are 48bits (3 x uint16_t)
-        static constexpr uint32_t const translationStride = 3;
-
-        if ( trackSettings.IsTranslationTrackStatic() )
+        if ( trackSettings.IsSparseTrack() )
         {
-            Vector const translation = DecodeTranslation( pTrackData, trackSettings );
-            outTransform.SetTranslation( translation );
-
-            // Shift the track data ptr to the scale data
-            pTrackData += translationStride;
+            ReadCompressedSparseTrackTransform( trackSettings, frameIdx, Percentage( 0.0f ), outTransform );
         }
-        else // Read the translation key-frames
+        else
         {
-            PoseDataIdx = frameIdx * translationStride;
-            EE_ASSERT( PoseDataIdx < ( m_numFrames * translationStride ) );
-
-            outTransform.SetTranslation( DecodeTranslation( &pTrackData[PoseDataIdx], trackSettings ) );
-
-            // Shift the track data ptr to the translation data
-            pTrackData += ( m_numFrames * rotationStride );
+            ReadCompressedTrackKey( trackSettings, GetFrameData( frameIdx ) + trackSettings.m_frameDataOffset, outTransform );
         }
+    }
 
-        //-------------------------------------------------------------------------
-        // Read scale
-        //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
 
-         // Scales are 16bits (1 x uint16_t)
-        static constexpr uint32_t const scaleStride = 1;
+    inline void AnimationClip::ReadCompressedTrackTransform( TrackCompressionSettings const& trackSettings, FrameTime const& frameTime, Transform& outTransform ) const
+    {
+        uint32_t const frameIdx = frameTime.GetFrameIndex();
+        EE_ASSERT( ( frameIdx + 1 ) < GetNumFrames() );
 
-        if ( trackSettings.IsScaleTrackStatic() )
+        if ( trackSettings.IsSparseTrack() )
         {
-            float scale = DecodeScale( pTrackData, trackSettings );
-            outTransform.SetScale( scale );
-
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += scaleStride;
+            ReadCompressedSparseTrackTransform( trackSettings, frameIdx, frameTime.GetPercentageThrough(), outTransform );
         }
-        else // Read the scale key-frames
+        else
         {
-            PoseDataIdx = frameIdx * scaleStride;
-            EE_ASSERT( PoseDataIdx < ( m_numFrames * scaleStride ) );
+            Transform transform0;
+            Transform transform1;
+            ReadCompressedTrackKey( trackSettings, GetFrameData( frameIdx ) + trackSettings.m_frameDataOffset, transform0 );
+            ReadCompressedTrackKey( trackSettings, GetFrameData( frameIdx + 1 ) + trackSettings.m_frameDataOffset, transform1 );
+            outTransform = Transform::Slerp( transform0, transform1, frameTime.GetPercentageThrough() );
+        }
+    }
 
-            outTransform.SetScale( DecodeScale( &pTrackData[PoseDataIdx], trackSettings ) );
+    //-------------------------------------------------------------------------
 
-            // Shift the track data ptr to the next track's rotation data
-            pTrackData += ( m_numFrames * scaleStride );
+    inline void AnimationClip::ReadCompressedSparseTrackTransform( TrackCompressionSettings const& trackSettings, uint32_t frameIdx, Percentage percentageThrough, Transform& outTransform ) const
+    {
+        EE_ASSERT( trackSettings.IsSparseTrack() && frameIdx < GetNumFrames() );
+
+        // The first and last frames are always stored, so we always have a surrounding pair of keys
+        uint16_t const* pKeyFrameIndices = m_compressedPoseData.data() + trackSettings.m_sparseDataOffset;
+        uint16_t const* pKeyData = pKeyFrameIndices + trackSettings.m_numSparseKeys;
+        uint32_t const keyStride = trackSettings.GetKeyStride();
+        EE_ASSERT( pKeyFrameIndices[0] == 0 && pKeyFrameIndices[trackSettings.m_numSparseKeys - 1] == ( m_numFrames - 1 ) );
+
+        // Find the last key at or before the requested frame
+        int32_t keyIdx0 = 0;
+        int32_t keyIdx1 = trackSettings.m_numSparseKeys - 1;
+        while ( ( keyIdx1 - keyIdx0 ) > 1 )
+        {
+            int32_t const midKeyIdx = ( keyIdx0 + keyIdx1 ) / 2;
+            if ( pKeyFrameIndices[midKeyIdx] <= frameIdx )
+            {
+                keyIdx0 = midKeyIdx;
+            }
+            else
+            {
+                keyIdx1 = midKeyIdx;
+            }
+        }
+
+        if ( pKeyFrameIndices[keyIdx1] <= frameIdx )
+        {
+            keyIdx0 = keyIdx1;
         }
 
         //-------------------------------------------------------------------------
 
-        return pTrackData;
+        uint32_t const keyFrameIdx0 = pKeyFrameIndices[keyIdx0];
+        if ( keyFrameIdx0 == frameIdx && percentageThrough == 0.0f )
+        {
+            ReadCompressedTrackKey( trackSettings, pKeyData + ( keyIdx0 * keyStride ), outTransform );
+        }
+        else
+        {
+            EE_ASSERT( keyIdx0 < ( trackSettings.m_numSparseKeys - 1 ) );
+            uint32_t const keyFrameIdx1 = pKeyFrameIndices[keyIdx0 + 1];
+            float const t = ( float( frameIdx - keyFrameIdx0 ) + percentageThrough.ToFloat() ) / float( keyFrameIdx1 - keyFrameIdx0 );
+
+            Transform transform0;
+            Transform transform1;
+            ReadCompressedTrackKey( trackSettings, pKeyData + ( keyIdx0 * keyStride ), transform0 );
+            ReadCompressedTrackKey( trackSettings, pKeyData + ( ( keyIdx0 + 1 ) * keyStride ), transform1 );
+            outTransform = Transform::Slerp( transform0, transform1, t );
+        }
     }
 
     //-------------------------------------------------------------------------
@@ -398,18 +458,20 @@ namespace EE::Animation
     inline void AnimationClip::GetEventsForRangeNoLooping( Seconds fromTime, Seconds toTime, TInlineVector<Event const*, 10>& outEvents ) const
     {
         EE_ASSERT( toTime >= fromTime );
+        EE_ASSERT( m_eventStartTimes.size() == m_events.size() && m_eventMaxEndTimes.size() == m_events.size() );
 
-        for ( auto const& pEvent : m_events )
-        {
-            // Events are stored sorted by time so as soon as we reach an event after the end of the time range, we're done
-            if ( pEvent->GetStartTime() > toTime )
-            {
-                break;
-            }
+        // Only events that start before the end of the range can overlap it
+        int32_t const endIdx = int32_t( eastl::upper_bound( m_eventStartTimes.begin(), m_eventStartTimes.end(), toTime.ToFloat() ) - m_eventStartTimes.begin() );
+
+        // All events before the first event whose max end time reaches the range start, end before the range
+        int32_t const startIdx = int32_t( eastl::lower_bound( m_eventMaxEndTimes.begin(), m_eventMaxEndTimes.begin() + endIdx, fromTime.ToFloat() ) - m_eventMaxEndTimes.begin() );
 
-            if ( FloatRange( fromTime, toTime ).Overlaps( pEvent->GetTimeRange() ) )
+        FloatRange const timeRange( fromTime, toTime );
+        for ( auto i = startIdx; i < endIdx; i++ )
+        {
+            if ( timeRange.Overlaps( m_events[i]->GetTimeRange() ) )
             {
-                outEvents.emplace_back( pEvent );
+                outEvents.emplace_back( m_events[i] );
             }
         }
     }
@@ -0,0 +1,263 @@
+#include "AnimationMotionDatabase.h"
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    void MotionFeatureIndex::Build( int32_t numFeatures, float const* pFeatures, int32_t numEntries )
+    {
+        EE_ASSERT( numFeatures > 0 && pFeatures != nullptr && numEntries > 0 );
+
+        m_numFeatures = numFeatures;
+        m_stride = ( numFeatures + 3 ) & ~3;
+        m_nodes.clear();
+
+        // Build the tree, this reorders the entry indices so that each leaf covers a contiguous range
+        //-------------------------------------------------------------------------
+
+        TVector<float> entryFeatures( pFeatures, pFeatures + ( numFeatures * numEntries ) );
+
+        TVector<int32_t> entryIndices;
+        entryIndices.resize( numEntries );
+        for ( int32_t i = 0; i < numEntries; i++ )
+        {
+            entryIndices[i] = i;
+        }
+
+        BuildNode( entryFeatures, entryIndices, 0, numEntries );
+
+        // Store the padded rows in tree order
+        //-------------------------------------------------------------------------
+
+        m_features.clear();
+        m_features.resize( m_stride * numEntries, 0.0f );
+        m_rowEntryIndices = entryIndices;
+        m_entryRowIndices.resize( numEntries );
+
+        for ( int32_t rowIdx = 0; rowIdx < numEntries; rowIdx++ )
+        {
+            int32_t const entryIdx = m_rowEntryIndices[rowIdx];
+            m_entryRowIndices[entryIdx] = rowIdx;
+            memcpy( &m_features[rowIdx * m_stride], &entryFeatures[entryIdx * numFeatures], sizeof( float ) * numFeatures );
+        }
+    }
+
+    int32_t MotionFeatureIndex::BuildNode( TVector<float> const& entryFeatures, TVector<int32_t>& entryIndices, int32_t startIdx, int32_t endIdx )
+    {
+        int32_t const nodeIdx = (int32_t) m_nodes.size();
+        m_nodes.emplace_back();
+        m_nodes[nodeIdx].m_firstRowIdx = startIdx;
+        m_nodes[nodeIdx].m_numRows = endIdx - startIdx;
+
+        if ( ( endIdx - startIdx ) <= s_maxLeafSize )
+        {
+            return nodeIdx;
+        }
+
+        // Split along the feature with the largest spread
+        //-------------------------------------------------------------------------
+
+        int32_t splitFeatureIdx = 0;
+        float largestSpread = -1.0f;
+        for ( int32_t featureIdx = 0; featureIdx < m_numFeatures; featureIdx++ )
+        {
+            float minValue = FLT_MAX;
+            float maxValue = -FLT_MAX;
+            for ( int32_t i = startIdx; i < endIdx; i++ )
+            {
+                float const value = entryFeatures[entryIndices[i] * m_numFeatures + featureIdx];
+                minValue = Math::Min( minValue, value );
+                maxValue = Math::Max( maxValue, value );
+            }
+
+            if ( ( maxValue - minValue ) > largestSpread )
+            {
+                largestSpread = maxValue - minValue;
+                splitFeatureIdx = featureIdx;
+            }
+        }
+
+        // All entries are identical, no point in splitting any further
+        if ( largestSpread <= 0.0f )
+        {
+            return nodeIdx;
+        }
+
+        // Partition around the median, everything to the left is <= the split value and everything to the right is >= the split value
+        //-------------------------------------------------------------------------
+
+        int32_t const medianIdx = startIdx + ( ( endIdx - startIdx ) / 2 );
+        auto Comparator = [&entryFeatures, splitFeatureIdx, this] ( int32_t a, int32_t b )
+        {
+            return entryFeatures[a * m_numFeatures + splitFeatureIdx] < entryFeatures[b * m_numFeatures + splitFeatureIdx];
+        };
+        eastl::nth_element( entryIndices.begin() + startIdx, entryIndices.begin() + medianIdx, entryIndices.begin() + endIdx, Comparator );
+
+        m_nodes[nodeIdx].m_splitFeatureIdx = splitFeatureIdx;
+        m_nodes[nodeIdx].m_splitValue = entryFeatures[entryIndices[medianIdx] * m_numFeatures + splitFeatureIdx];
+
+        int32_t const leftChildIdx = BuildNode( entryFeatures, entryIndices, startIdx, medianIdx );
+        EE_ASSERT( leftChildIdx == nodeIdx + 1 );
+        m_nodes[nodeIdx].m_rightChildIdx = BuildNode( entryFeatures, entryIndices, medianIdx, endIdx );
+        return nodeIdx;
+    }
+
+    //-------------------------------------------------------------------------
+
+    float MotionFeatureIndex::CalculateCost( float const* pQuery, int32_t entryIdx ) const
+    {
+        float const* pRow = GetEntryFeatures( entryIdx );
+
+        Vector cost = Vector::Zero;
+        for ( int32_t i = 0; i < m_stride; i += 4 )
+        {
+            Vector const delta = Vector( _mm_loadu_ps( pQuery + i ) ) - Vector( _mm_loadu_ps( pRow + i ) );
+            cost += delta * delta;
+        }
+
+        return cost.Dot4( Vector::One ).ToFloat();
+    }
+
+    void MotionFeatureIndex::SearchRows( float const* pQuery, int32_t firstRowIdx, int32_t numRows, SearchResult& result ) const
+    {
+        float const* pRow = &m_features[firstRowIdx * m_stride];
+        for ( int32_t rowIdx = firstRowIdx; rowIdx < firstRowIdx + numRows; rowIdx++, pRow += m_stride )
+        {
+            Vector cost = Vector::Zero;
+            for ( int32_t i = 0; i < m_stride; i += 4 )
+            {
+                Vector const delta = Vector( _mm_loadu_ps( pQuery + i ) ) - Vector( _mm_loadu_ps( pRow + i ) );
+                cost += delta * delta;
+            }
+
+            float const rowCost = cost.Dot4( Vector::One ).ToFloat();
+            if ( rowCost < result.m_cost )
+            {
+                result.m_cost = rowCost;
+                result.m_entryIdx = m_rowEntryIndices[rowIdx];
+            }
+        }
+    }
+
+    MotionFeatureIndex::SearchResult MotionFeatureIndex::FindNearestBruteForce( float const* pQuery ) const
+    {
+        EE_ASSERT( IsValid() && pQuery != nullptr );
+
+        SearchResult result;
+        SearchRows( pQuery, 0, GetNumEntries(), result );
+        return result;
+    }
+
+    MotionFeatureIndex::SearchResult MotionFeatureIndex::FindNearest( float const* pQuery ) const
+    {
+        EE_ASSERT( IsValid() && pQuery != nullptr );
+
+        struct StackEntry
+        {
+            int32_t     m_nodeIdx;
+            float       m_minCost;
+        };
+
+        // The tree is balanced so the depth is bounded by log2 of the number of entries
+        StackEntry stack[64];
+        int32_t stackSize = 0;
+        stack[stackSize++] = { 0, 0.0f };
+
+        SearchResult result;
+        while ( stackSize > 0 )
+        {
+            StackEntry const entry = stack[--stackSize];
+            if ( entry.m_minCost >= result.m_cost )
+            {
+                continue;
+            }
+
+            Node const& node = m_nodes[entry.m_nodeIdx];
+            if ( node.IsLeaf() )
+            {
+                SearchRows( pQuery, node.m_firstRowIdx, node.m_numRows, result );
+                continue;
+            }
+
+            // Visit the nearest child first, the far child can only contain a better match if the split plane is closer than the current best
+            float const delta = pQuery[node.m_splitFeatureIdx] - node.m_splitValue;
+            int32_t const leftChildIdx = entry.m_nodeIdx + 1;
+            int32_t const nearChildIdx = ( delta < 0.0f ) ? leftChildIdx : node.m_rightChildIdx;
+            int32_t const farChildIdx = ( delta < 0.0f ) ? node.m_rightChildIdx : leftChildIdx;
+
+            EE_ASSERT( stackSize + 2 <= 64 );
+            stack[stackSize++] = { farChildIdx, Math::Max( entry.m_minCost, delta * delta ) };
+            stack[stackSize++] = { nearChildIdx, entry.m_minCost };
+        }
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool MotionDatabase::IsValid() const
+    {
+        if ( !m_skeleton.IsLoaded() || !m_index.IsValid() || m_clips.empty() )
+        {
+            return false;
+        }
+
+        for ( auto const& clip : m_clips )
+        {
+            if ( !clip.IsLoaded() )
+            {
+                return false;
+            }
+        }
+
+        return m_clipFirstEntryIndices.size() == ( m_clips.size() + 1 );
+    }
+
+    int32_t MotionDatabase::GetEntryIndex( int32_t clipIdx, Percentage percentageThrough ) const
+    {
+        EE_ASSERT( clipIdx >= 0 && clipIdx < GetNumClips() );
+        AnimationClip const* pClip = m_clips[clipIdx].GetPtr();
+        int32_t const frameIdx = Math::Min( (int32_t) pClip->GetFrameTime( percentageThrough ).GetNearestFrameIndex(), GetLastSearchableFrameIdx( clipIdx ) );
+        return m_clipFirstEntryIndices[clipIdx] + frameIdx;
+    }
+
+    Percentage MotionDatabase::GetEntryTime( int32_t entryIdx ) const
+    {
+        Entry const& entry = m_entries[entryIdx];
+        uint32_t const numFrames = m_clips[entry.m_clipIdx]->GetNumFrames();
+        return ( numFrames > 1 ) ? Percentage( float( entry.m_frameIdx ) / ( numFrames - 1 ) ) : Percentage( 0.0f );
+    }
+
+    void MotionDatabase::CreateQuery( int32_t currentEntryIdx, TrajectorySample const* pDesiredTrajectory, float* pOutQuery ) const
+    {
+        EE_ASSERT( pDesiredTrajectory != nullptr && pOutQuery != nullptr );
+
+        // The pose features are taken directly from the current entry, they are already normalized
+        int32_t const numPoseFeatures = m_numFeatureBones * s_numFeaturesPerBone;
+        memcpy( pOutQuery, m_index.GetEntryFeatures( currentEntryIdx ), sizeof( float ) * numPoseFeatures );
+
+        // Normalize the desired trajectory
+        float* pTrajectoryQuery = pOutQuery + numPoseFeatures;
+        float const* pOffsets = &m_featureOffsets[numPoseFeatures];
+        float const* pScales = &m_featureScales[numPoseFeatures];
+
+        int32_t const numTrajectorySamples = GetNumTrajectorySamples();
+        for ( int32_t i = 0; i < numTrajectorySamples; i++ )
+        {
+            TrajectorySample const& sample = pDesiredTrajectory[i];
+            float const rawFeatures[s_numFeaturesPerTrajectorySample] = { sample.m_position.m_x, sample.m_position.m_y, sample.m_facing.m_x, sample.m_facing.m_y };
+            for ( int32_t j = 0; j < s_numFeaturesPerTrajectorySample; j++ )
+            {
+                int32_t const featureIdx = ( i * s_numFeaturesPerTrajectorySample ) + j;
+                pTrajectoryQuery[featureIdx] = ( rawFeatures[j] - pOffsets[featureIdx] ) * pScales[featureIdx];
+            }
+        }
+
+        // Clear the padding
+        for ( int32_t i = m_index.GetNumFeatures(); i < m_index.GetStride(); i++ )
+        {
+            pOutQuery[i] = 0.0f;
+        }
+    }
+}
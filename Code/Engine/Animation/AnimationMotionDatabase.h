@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "AnimationClip.h"
+#include "System/Resource/IResource.h"
+#include "System/Resource/ResourcePtr.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Motion Feature Index
+//-------------------------------------------------------------------------
+// Nearest neighbour search over a set of fixed size (already normalized) feature vectors
+// The feature rows are padded to a multiple of 4 so that the cost can be calculated 4 features at a time
+// A KD-tree is built over the rows and the rows are reordered so that each leaf is a contiguous block of memory
+
+namespace EE::Animation
+{
+    class EE_ENGINE_API MotionFeatureIndex
+    {
+        EE_SERIALIZE( m_numFeatures, m_stride, m_features, m_rowEntryIndices, m_entryRowIndices, m_nodes );
+
+    public:
+
+        constexpr static int32_t const s_maxLeafSize = 16;
+
+        struct Node
+        {
+            EE_SERIALIZE( m_splitValue, m_splitFeatureIdx, m_rightChildIdx, m_firstRowIdx, m_numRows );
+
+            inline bool IsLeaf() const { return m_splitFeatureIdx == InvalidIndex; }
+
+            float                       m_splitValue = 0.0f;
+            int32_t                     m_splitFeatureIdx = InvalidIndex;
+            int32_t                     m_rightChildIdx = InvalidIndex; // The left child is always the next node
+            int32_t                     m_firstRowIdx = 0;
+            int32_t                     m_numRows = 0;
+        };
+
+        struct SearchResult
+        {
+            inline bool IsValid() const { return m_entryIdx != InvalidIndex; }
+
+            int32_t                     m_entryIdx = InvalidIndex;
+            float                       m_cost = FLT_MAX;
+        };
+
+    public:
+
+        inline bool IsValid() const { return m_numFeatures > 0 && !m_features.empty() && !m_nodes.empty(); }
+
+        // Build the index from a set of entries, each entry is a contiguous set of 'numFeatures' values
+        void Build( int32_t numFeatures, float const* pFeatures, int32_t numEntries );
+
+        inline int32_t GetNumFeatures() const { return m_numFeatures; }
+        inline int32_t GetNumEntries() const { return (int32_t) m_entryRowIndices.size(); }
+
+        // The number of floats per row, queries need to be padded with zeros to this size
+        inline int32_t GetStride() const { return m_stride; }
+
+        // Get the feature row for an entry
+        inline float const* GetEntryFeatures( int32_t entryIdx ) const
+        {
+            EE_ASSERT( entryIdx >= 0 && entryIdx < GetNumEntries() );
+            return &m_features[m_entryRowIndices[entryIdx] * m_stride];
+        }
+
+        // Calculate the cost (squared distance) between the query and an entry
+        float CalculateCost( float const* pQuery, int32_t entryIdx ) const;
+
+        // Test every entry, only worth it for small databases
+        SearchResult FindNearestBruteForce( float const* pQuery ) const;
+
+        // Search using the KD-tree
+        SearchResult FindNearest( float const* pQuery ) const;
+
+    private:
+
+        int32_t BuildNode( TVector<float> const& entryFeatures, TVector<int32_t>& entryIndices, int32_t startIdx, int32_t endIdx );
+        void SearchRows( float const* pQuery, int32_t firstRowIdx, int32_t numRows, SearchResult& result ) const;
+
+    private:
+
+        int32_t                         m_numFeatures = 0;
+        int32_t                         m_stride = 0;
+        TVector<float>                  m_features;
+        TVector<int32_t>                m_rowEntryIndices;
+        TVector<int32_t>                m_entryRowIndices;
+        TVector<Node>                   m_nodes;
+    };
+
+    //-------------------------------------------------------------------------
+    // Motion Database
+    //-------------------------------------------------------------------------
+    // A searchable set of animation frames, each frame is described by a feature vector containing:
+    // * The character space position and velocity of a set of bones
+    // * The future root trajectory (position and facing on the horizontal plane) at a set of sample times
+    // The features are normalized at compile time, so the query trajectory needs to be normalized with the stored offsets and scales
+    // Only frames that have enough animation left to play are searchable, the last frames of each clip are excluded
+
+    class EE_ENGINE_API MotionDatabase final : public Resource::IResource
+    {
+        EE_REGISTER_RESOURCE( 'mmdb', "Animation Motion Database" );
+        EE_SERIALIZE( m_skeleton, m_clips, m_entries, m_clipFirstEntryIndices, m_numFeatureBones, m_trajectorySampleTimes, m_featureOffsets, m_featureScales, m_index );
+
+        friend class MotionDatabaseCompiler;
+        friend class MotionDatabaseLoader;
+
+    public:
+
+        constexpr static int32_t const s_numFeaturesPerBone = 6;
+        constexpr static int32_t const s_numFeaturesPerTrajectorySample = 4;
+        constexpr static int32_t const s_maxTrajectorySamples = 8;
+
+        struct Entry
+        {
+            EE_SERIALIZE( m_clipIdx, m_frameIdx );
+
+            int32_t                     m_clipIdx = InvalidIndex;
+            int32_t                     m_frameIdx = InvalidIndex;
+        };
+
+        // A desired character space root trajectory sample (position and facing on the horizontal plane)
+        struct TrajectorySample
+        {
+            Float2                      m_position = Float2::Zero;
+            Float2                      m_facing = Float2( 0, -1 );
+        };
+
+        using SearchResult = MotionFeatureIndex::SearchResult;
+
+    public:
+
+        virtual bool IsValid() const final;
+
+        inline Skeleton const* GetSkeleton() const { return m_skeleton.GetPtr(); }
+
+        // Clips
+        //-------------------------------------------------------------------------
+
+        inline int32_t GetNumClips() const { return (int32_t) m_clips.size(); }
+        inline AnimationClip const* GetClip( int32_t clipIdx ) const { EE_ASSERT( clipIdx >= 0 && clipIdx < GetNumClips() ); return m_clips[clipIdx].GetPtr(); }
+
+        // Entries
+        //-------------------------------------------------------------------------
+
+        inline int32_t GetNumEntries() const { return (int32_t) m_entries.size(); }
+        inline Entry const& GetEntry( int32_t entryIdx ) const { return m_entries[entryIdx]; }
+
+        // Get the entry for the nearest searchable frame of a clip
+        int32_t GetEntryIndex( int32_t clipIdx, Percentage percentageThrough ) const;
+
+        // Get the last searchable frame for a clip, once playback reaches this frame we need to find a new entry
+        inline int32_t GetLastSearchableFrameIdx( int32_t clipIdx ) const { return m_clipFirstEntryIndices[clipIdx + 1] - m_clipFirstEntryIndices[clipIdx] - 1; }
+
+        // Get the percentage through a clip for an entry
+        Percentage GetEntryTime( int32_t entryIdx ) const;
+
+        // Search
+        //-------------------------------------------------------------------------
+
+        inline int32_t GetNumTrajectorySamples() const { return (int32_t) m_trajectorySampleTimes.size(); }
+        inline Seconds GetTrajectorySampleTime( int32_t sampleIdx ) const { return m_trajectorySampleTimes[sampleIdx]; }
+        inline int32_t GetQuerySize() const { return m_index.GetStride(); }
+
+        // Create a query from the pose features of the current entry and the desired trajectory (one sample per trajectory sample time)
+        void CreateQuery( int32_t currentEntryIdx, TrajectorySample const* pDesiredTrajectory, float* pOutQuery ) const;
+
+        // Calculate the cost of the query for a specific entry
+        inline float CalculateCost( float const* pQuery, int32_t entryIdx ) const { return m_index.CalculateCost( pQuery, entryIdx ); }
+
+        // Find the best matching entry, the brute force search is only worth it for small databases
+        inline SearchResult FindBestMatch( float const* pQuery, bool useAccelerationStructure = true ) const
+        {
+            return useAccelerationStructure ? m_index.FindNearest( pQuery ) : m_index.FindNearestBruteForce( pQuery );
+        }
+
+    private:
+
+        TResourcePtr<Skeleton>                      m_skeleton;
+        TVector<TResourcePtr<AnimationClip>>        m_clips;
+        TVector<Entry>                              m_entries;
+        TVector<int32_t>                            m_clipFirstEntryIndices; // One extra element to mark the end of the last clip
+        int32_t                                     m_numFeatureBones = 0;
+        TVector<Seconds>                            m_trajectorySampleTimes;
+        TVector<float>                              m_featureOffsets;
+        TVector<float>                              m_featureScales;
+        MotionFeatureIndex                          m_index;
+    };
+}
@@ -1,4 +1,5 @@
 #include "AnimationPose.h"
+#include "AnimationPoseSoA.h"
 #include "System/Drawing/DebugDrawing.h"
 
 //-------------------------------------------------------------------------
@@ -7,12 +8,36 @@ namespace EE::Animation
 {
     Pose::Pose( Skeleton const* pSkeleton, Type initialState )
         : m_pSkeleton( pSkeleton )
-        , m_localTransforms( pSkeleton->GetNumBones() )
+        , m_ownsMemory( true )
     {
         EE_ASSERT( pSkeleton != nullptr );
+
+        // Local and global transforms are stored in a single allocation
+        m_pLocalTransforms = (Transform*) EE::Alloc( GetRequiredMemorySize( pSkeleton ), alignof( Transform ) );
+        m_pGlobalTransforms = m_pLocalTransforms + pSkeleton->GetNumBones();
+        Reset( initialState );
+    }
+
+    Pose::Pose( Skeleton const* pSkeleton, void* pMemory, Type initialState )
+        : m_pSkeleton( pSkeleton )
+        , m_pLocalTransforms( (Transform*) pMemory )
+        , m_ownsMemory( false )
+    {
+        EE_ASSERT( pSkeleton != nullptr );
+        EE_ASSERT( pMemory != nullptr && ( (uintptr_t) pMemory % alignof( Transform ) ) == 0 );
+
+        m_pGlobalTransforms = m_pLocalTransforms + pSkeleton->GetNumBones();
         Reset( initialState );
     }
 
+    Pose::~Pose()
+    {
+        if ( m_ownsMemory )
+        {
+            EE::Free( (void*&) m_pLocalTransforms );
+        }
+    }
+
     Pose::Pose( Pose&& rhs )
     {
         EE_ASSERT( rhs.m_pSkeleton != nullptr );
@@ -21,26 +46,42 @@ namespace EE::Animation
 
     Pose& Pose::operator=( Pose&& rhs )
     {
-        m_pSkeleton = rhs.m_pSkeleton;
-        m_localTransforms.swap( rhs.m_localTransforms );
-        m_globalTransforms.swap( rhs.m_globalTransforms );
+        // Swap the storage so that any memory we own is released by the rhs
+        eastl::swap( m_pSkeleton, rhs.m_pSkeleton );
+        eastl::swap( m_pLocalTransforms, rhs.m_pLocalTransforms );
+        eastl::swap( m_pGlobalTransforms, rhs.m_pGlobalTransforms );
+        eastl::swap( m_hasGlobalTransforms, rhs.m_hasGlobalTransforms );
+        eastl::swap( m_ownsMemory, rhs.m_ownsMemory );
         m_state = rhs.m_state;
+        m_pActiveAdditiveBoneIndices = rhs.m_pActiveAdditiveBoneIndices;
 
         return *this;
     }
 
     void Pose::CopyFrom( Pose const& rhs )
     {
+        EE_ASSERT( m_pSkeleton->GetNumBones() == rhs.m_pSkeleton->GetNumBones() );
+        int32_t const numBones = rhs.GetNumBones();
+
         m_pSkeleton = rhs.m_pSkeleton;
-        m_localTransforms = rhs.m_localTransforms;
-        m_globalTransforms = rhs.m_globalTransforms;
+        memcpy( m_pLocalTransforms, rhs.m_pLocalTransforms, sizeof( Transform ) * numBones );
+
+        m_hasGlobalTransforms = rhs.m_hasGlobalTransforms;
+        if ( m_hasGlobalTransforms )
+        {
+            memcpy( m_pGlobalTransforms, rhs.m_pGlobalTransforms, sizeof( Transform ) * numBones );
+        }
+
         m_state = rhs.m_state;
+        m_pActiveAdditiveBoneIndices = rhs.m_pActiveAdditiveBoneIndices;
     }
 
     //-------------------------------------------------------------------------
 
     void Pose::Reset( Type initialState, bool calcGlobalPose )
     {
+        m_pActiveAdditiveBoneIndices = nullptr;
+
         switch ( initialState )
         {
             case Type::ReferencePose:
@@ -66,60 +107,184 @@ namespace EE::Animation
 
     void Pose::SetToReferencePose( bool setGlobalPose )
     {
-        m_localTransforms = m_pSkeleton->GetLocalReferencePose();
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        memcpy( m_pLocalTransforms, m_pSkeleton->GetLocalReferencePose().data(), sizeof( Transform ) * numBones );
 
         if ( setGlobalPose )
         {
-            m_globalTransforms = m_pSkeleton->GetGlobalReferencePose();
-        }
-        else
-        {
-            m_globalTransforms.clear();
+            memcpy( m_pGlobalTransforms, m_pSkeleton->GetGlobalReferencePose().data(), sizeof( Transform ) * numBones );
         }
 
+        m_hasGlobalTransforms = setGlobalPose;
         m_state = State::ReferencePose;
     }
 
     void Pose::SetToZeroPose( bool setGlobalPose )
     {
-        auto const numBones = m_pSkeleton->GetNumBones();
-        m_localTransforms.resize( numBones, Transform::Identity );
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            m_pLocalTransforms[boneIdx] = Transform::Identity;
+        }
 
         if ( setGlobalPose )
         {
-            m_globalTransforms = m_localTransforms;
+            memcpy( m_pGlobalTransforms, m_pLocalTransforms, sizeof( Transform ) * numBones );
         }
-        else
+
+        m_hasGlobalTransforms = setGlobalPose;
+        m_state = State::ZeroPose;
+    }
+
+    void Pose::SetHighLODBonesToReferencePose()
+    {
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        int32_t const numLowLODBones = m_pSkeleton->GetNumBones( Skeleton::LOD::Low );
+        auto const& referencePose = m_pSkeleton->GetLocalReferencePose();
+
+        for ( int32_t boneIdx = numLowLODBones; boneIdx < numBones; boneIdx++ )
         {
-            m_globalTransforms.clear();
+            m_pLocalTransforms[boneIdx] = referencePose[boneIdx];
         }
 
-        m_state = State::ZeroPose;
+        m_hasGlobalTransforms = false;
     }
 
     //-------------------------------------------------------------------------
 
     void Pose::CalculateGlobalTransforms()
+    {
+        int32_t const* pOrderedBoneIndices = m_pSkeleton->GetDepthOrderedBoneIndices().data();
+        auto const& levelStartIndices = m_pSkeleton->GetDepthLevelStartIndices();
+        auto const& parentIndices = m_pSkeleton->GetParentBoneIndices();
+
+        // The first level only contains root bones
+        for ( auto i = levelStartIndices[0]; i < levelStartIndices[1]; i++ )
+        {
+            int32_t const boneIdx = pOrderedBoneIndices[i];
+            m_pGlobalTransforms[boneIdx] = m_pLocalTransforms[boneIdx];
+        }
+
+        // All bones in a level only depend on bones from previous levels, so we can calculate them four at a time
+        TransformSoA4 local, parentGlobal;
+        int32_t const numLevels = m_pSkeleton->GetNumDepthLevels();
+        for ( auto levelIdx = 1; levelIdx < numLevels; levelIdx++ )
+        {
+            int32_t i = levelStartIndices[levelIdx];
+            int32_t const levelEnd = levelStartIndices[levelIdx + 1];
+
+            for ( ; i + 4 <= levelEnd; i += 4 )
+            {
+                int32_t const* pBoneIndices = &pOrderedBoneIndices[i];
+                int32_t const pParentIndices[4] = { parentIndices[pBoneIndices[0]], parentIndices[pBoneIndices[1]], parentIndices[pBoneIndices[2]], parentIndices[pBoneIndices[3]] };
+
+                local.Gather( m_pLocalTransforms, pBoneIndices );
+                parentGlobal.Gather( m_pGlobalTransforms, pParentIndices );
+
+                // Negative scales require the full transform multiplication
+                if ( local.HasNegativeScale() || parentGlobal.HasNegativeScale() )
+                {
+                    for ( auto j = 0; j < 4; j++ )
+                    {
+                        m_pGlobalTransforms[pBoneIndices[j]] = m_pLocalTransforms[pBoneIndices[j]] * m_pGlobalTransforms[pParentIndices[j]];
+                    }
+                }
+                else
+                {
+                    TransformSoA4::Multiply( local, parentGlobal ).Scatter( m_pGlobalTransforms, pBoneIndices );
+                }
+            }
+
+            for ( ; i < levelEnd; i++ )
+            {
+                int32_t const boneIdx = pOrderedBoneIndices[i];
+                m_pGlobalTransforms[boneIdx] = m_pLocalTransforms[boneIdx] * m_pGlobalTransforms[parentIndices[boneIdx]];
+            }
+        }
+
+        m_hasGlobalTransforms = true;
+    }
+
+    void Pose::CalculateGlobalTransforms( int32_t const* pBoneIndices, int32_t numBoneIndices, Transform* pOutGlobalTransforms ) const
+    {
+        EE_ASSERT( pBoneIndices != nullptr && pOutGlobalTransforms != nullptr && numBoneIndices > 0 );
+
+        if ( m_hasGlobalTransforms )
+        {
+            for ( auto i = 0; i < numBoneIndices; i++ )
+            {
+                EE_ASSERT( m_pSkeleton->IsValidBoneIndex( pBoneIndices[i] ) );
+                pOutGlobalTransforms[i] = m_pGlobalTransforms[pBoneIndices[i]];
+            }
+
+            return;
+        }
+
+        // Flag all the bones in the chains from the requested bones to the root
+        //-------------------------------------------------------------------------
+
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        auto isBoneRequired = EE_STACK_ARRAY_ALLOC( bool, numBones );
+        Memory::MemsetZero( isBoneRequired, sizeof( bool ) * numBones );
+
+        int32_t maxBoneIdx = 0;
+        for ( auto i = 0; i < numBoneIndices; i++ )
+        {
+            EE_ASSERT( m_pSkeleton->IsValidBoneIndex( pBoneIndices[i] ) );
+            maxBoneIdx = Math::Max( maxBoneIdx, pBoneIndices[i] );
+
+            // Stop as soon as we hit a chain that has already been flagged
+            int32_t boneIdx = pBoneIndices[i];
+            while ( boneIdx != InvalidIndex && !isBoneRequired[boneIdx] )
+            {
+                isBoneRequired[boneIdx] = true;
+                boneIdx = m_pSkeleton->GetParentBoneIndex( boneIdx );
+            }
+        }
+
+        // Parents always have lower indices than their children, so all chains can be resolved in a single pass with shared chain bones only calculated once
+        //-------------------------------------------------------------------------
+
+        auto globalTransforms = EE_STACK_ARRAY_ALLOC( Transform, maxBoneIdx + 1 );
+        for ( auto boneIdx = 0; boneIdx <= maxBoneIdx; boneIdx++ )
+        {
+            if ( isBoneRequired[boneIdx] )
+            {
+                int32_t const parentIdx = m_pSkeleton->GetParentBoneIndex( boneIdx );
+                globalTransforms[boneIdx] = ( parentIdx == InvalidIndex ) ? m_pLocalTransforms[boneIdx] : m_pLocalTransforms[boneIdx] * globalTransforms[parentIdx];
+            }
+        }
+
+        for ( auto i = 0; i < numBoneIndices; i++ )
+        {
+            pOutGlobalTransforms[i] = globalTransforms[pBoneIndices[i]];
+        }
+    }
+
+    #if EE_DEVELOPMENT_TOOLS
+    void Pose::CalculateGlobalTransformsScalar()
     {
         int32_t const numBones = m_pSkeleton->GetNumBones();
-        m_globalTransforms.resize( numBones );
 
-        m_globalTransforms[0] = m_localTransforms[0];
+        m_pGlobalTransforms[0] = m_pLocalTransforms[0];
         for ( auto boneIdx = 1; boneIdx < numBones; boneIdx++ )
         {
             int32_t const parentIdx = m_pSkeleton->GetParentBoneIndex( boneIdx );
-            m_globalTransforms[boneIdx] = m_localTransforms[boneIdx] * m_globalTransforms[parentIdx];
+            m_pGlobalTransforms[boneIdx] = m_pLocalTransforms[boneIdx] * m_pGlobalTransforms[parentIdx];
         }
+
+        m_hasGlobalTransforms = true;
     }
+    #endif
 
     Transform Pose::GetGlobalTransform( int32_t boneIdx ) const
     {
         EE_ASSERT( boneIdx < m_pSkeleton->GetNumBones() );
 
         Transform boneGlobalTransform;
-        if ( !m_globalTransforms.empty() )
+        if ( m_hasGlobalTransforms )
         {
-            boneGlobalTransform = m_globalTransforms[boneIdx];
+            boneGlobalTransform = m_pGlobalTransforms[boneIdx];
         }
         else
         {
@@ -135,17 +300,17 @@ namespace EE::Animation
             }
 
             // If we have parents
-            boneGlobalTransform = m_localTransforms[boneIdx];
+            boneGlobalTransform = m_pLocalTransforms[boneIdx];
             if ( nextEntry > 0 )
             {
                 // Calculate global transform of parent
                 int32_t arrayIdx = nextEntry - 1;
                 parentIdx = boneParents[arrayIdx--];
-                auto parentGlobalTransform = m_localTransforms[parentIdx];
+                auto parentGlobalTransform = m_pLocalTransforms[parentIdx];
                 for ( arrayIdx; arrayIdx >= 0; arrayIdx-- )
                 {
                     int32_t const nextIdx = boneParents[arrayIdx];
-                    auto const nextTransform = m_localTransforms[nextIdx];
+                    auto const nextTransform = m_pLocalTransforms[nextIdx];
                     parentGlobalTransform = nextTransform * parentGlobalTransform;
                 }
 
@@ -166,7 +331,7 @@ namespace EE::Animation
 
         //-------------------------------------------------------------------------
 
-        auto const numBones = m_localTransforms.size();
+        auto const numBones = m_pSkeleton->GetNumBones();
         if ( numBones > 0 )
         {
             // Calculate bone world transforms
@@ -175,12 +340,12 @@ namespace EE::Animation
             TInlineVector<Transform, 256> worldTransforms;
             worldTransforms.resize( numBones );
 
-            worldTransforms[0] = m_localTransforms[0] * worldTransform;
+            worldTransforms[0] = m_pLocalTransforms[0] * worldTransform;
             for ( auto i = 1; i < numBones; i++ )
             {
                 auto const& parentIdx = parentIndices[i];
                 auto const& parentTransform = worldTransforms[parentIdx];
-                worldTransforms[i] = m_localTransforms[i] * parentTransform;
+                worldTransforms[i] = m_pLocalTransforms[i] * parentTransform;
             }
 
             // Draw bones
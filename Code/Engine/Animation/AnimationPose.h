@@ -35,10 +35,20 @@ namespace EE::Animation
             AdditivePose
         };
 
+    public:
+
+        // Get the size of the memory block needed to store the transforms for a pose of the specified skeleton
+        EE_FORCE_INLINE static size_t GetRequiredMemorySize( Skeleton const* pSkeleton ) { return sizeof( Transform ) * pSkeleton->GetNumBones() * 2; }
+
     public:
 
         Pose( Skeleton const* pSkeleton, Type initialPoseType = Type::ReferencePose );
 
+        // Create a pose whose transforms are stored in externally owned memory, this memory needs to be at least 'GetRequiredMemorySize' bytes and aligned for a transform
+        Pose( Skeleton const* pSkeleton, void* pMemory, Type initialPoseType = Type::ReferencePose );
+
+        ~Pose();
+
         // Move
         Pose( Pose&& rhs );
         Pose& operator=( Pose&& rhs );
@@ -65,35 +75,38 @@ namespace EE::Animation
         inline bool IsZeroPose() const { return m_state == State::ZeroPose; }
         inline bool IsAdditivePose() const { return m_state == State::AdditivePose; }
 
+        // Get the bones that are actually modified by this additive pose (sorted by bone index), null if all bones need to be considered
+        inline TVector<uint16_t> const* GetActiveAdditiveBoneIndices() const { return m_pActiveAdditiveBoneIndices; }
+
         // Local Transforms
         //-------------------------------------------------------------------------
 
-        TVector<Transform> const& GetTransforms() const { return m_localTransforms; }
+        inline Transform const* GetTransforms() const { return m_pLocalTransforms; }
 
         inline Transform const& GetTransform( int32_t boneIdx ) const
         {
             EE_ASSERT( boneIdx < GetNumBones() );
-            return m_localTransforms[boneIdx];
+            return m_pLocalTransforms[boneIdx];
         }
 
         inline void SetTransform( int32_t boneIdx, Transform const& transform )
         {
             EE_ASSERT( boneIdx < GetNumBones() && boneIdx >= 0 );
-            m_localTransforms[boneIdx] = transform;
+            m_pLocalTransforms[boneIdx] = transform;
             MarkAsValidPose();
         }
 
         inline void SetRotation( int32_t boneIdx, Quaternion const& rotation )
         {
             EE_ASSERT( boneIdx < GetNumBones() && boneIdx >= 0 );
-            m_localTransforms[boneIdx].SetRotation( rotation );
+            m_pLocalTransforms[boneIdx].SetRotation( rotation );
             MarkAsValidPose();
         }
 
         inline void SetTranslation( int32_t boneIdx, Float3 const& translation )
         {
             EE_ASSERT( boneIdx < GetNumBones() && boneIdx >= 0 );
-            m_localTransforms[boneIdx].SetTranslation( translation );
+            m_pLocalTransforms[boneIdx].SetTranslation( translation );
             MarkAsValidPose();
         }
 
@@ -101,17 +114,30 @@ namespace EE::Animation
         inline void SetScale( int32_t boneIdx, float uniformScale )
         {
             EE_ASSERT( boneIdx < GetNumBones() && boneIdx >= 0 );
-            m_localTransforms[boneIdx].SetScale( uniformScale );
+            m_pLocalTransforms[boneIdx].SetScale( uniformScale );
             MarkAsValidPose();
         }
 
+        // Reset all the bones that are only evaluated at the high LOD to the reference pose
+        void SetHighLODBonesToReferencePose();
+
         // Global Transform Cache
         //-------------------------------------------------------------------------
 
-        inline bool HasGlobalTransforms() const { return !m_globalTransforms.empty(); }
-        inline void ClearGlobalTransforms() { m_globalTransforms.clear(); }
-        inline TVector<Transform> const& GetGlobalTransforms() const { return m_globalTransforms; }
+        inline bool HasGlobalTransforms() const { return m_hasGlobalTransforms; }
+        inline void ClearGlobalTransforms() { m_hasGlobalTransforms = false; }
+        inline Transform const* GetGlobalTransforms() const { EE_ASSERT( m_hasGlobalTransforms ); return m_pGlobalTransforms; }
         void CalculateGlobalTransforms();
+
+        // Calculate the global transforms for a set of bones without calculating the global pose, only the chains from the root to the requested bones are evaluated
+        // Bones shared between chains are only evaluated once. The results are written in the same order as the requested bone indices
+        void CalculateGlobalTransforms( int32_t const* pBoneIndices, int32_t numBoneIndices, Transform* pOutGlobalTransforms ) const;
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Reference implementation of 'CalculateGlobalTransforms' that evaluates the bones one at a time in parent order, only used to validate and benchmark the depth level evaluation
+        void CalculateGlobalTransformsScalar();
+        #endif
+
         Transform GetGlobalTransform( int32_t boneIdx ) const;
 
         // Debug
@@ -134,13 +160,19 @@ namespace EE::Animation
             {
                 m_state = State::Pose;
             }
+
+            // We dont know which bones have been modified, so all bones need to be considered from now on
+            m_pActiveAdditiveBoneIndices = nullptr;
         }
 
     private:
 
-        Skeleton const*             m_pSkeleton;                // The skeleton for this pose
-        TVector<Transform>          m_localTransforms;          // Parent-space transforms
-        TVector<Transform>          m_globalTransforms;         // Character-space transforms
+        Skeleton const*             m_pSkeleton = nullptr;      // The skeleton for this pose
+        Transform*                  m_pLocalTransforms = nullptr;   // Parent-space transforms
+        Transform*                  m_pGlobalTransforms = nullptr;  // Character-space transforms, only valid if 'm_hasGlobalTransforms' is set
         State                       m_state = State::Unset;     // Pose state
+        TVector<uint16_t> const*    m_pActiveAdditiveBoneIndices = nullptr; // Optional: only set for additive poses sampled from a clip with identity tracks
+        bool                        m_hasGlobalTransforms = false;
+        bool                        m_ownsMemory = false;       // Did we allocate the transform memory or is it externally owned (i.e. by a pose buffer pool)
     };
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "System/Math/Transform.h"
+
+//-------------------------------------------------------------------------
+// SoA Pose Types
+//-------------------------------------------------------------------------
+// Groups of four bones stored as separate component streams i.e. each register holds the same component for all four bones
+// Poses are stored as AoS transforms, these types are used by the vectorized pose operations which transpose blocks of bones in and out
+
+namespace EE::Animation
+{
+    struct VectorSoA4
+    {
+        Vector                  m_x;
+        Vector                  m_y;
+        Vector                  m_z;
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct QuaternionSoA4
+    {
+        // 4D dot product for each of the four quaternions
+        EE_FORCE_INLINE static Vector Dot( QuaternionSoA4 const& q0, QuaternionSoA4 const& q1 )
+        {
+            Vector result = q0.m_x * q1.m_x;
+            result = Vector::MultiplyAdd( q0.m_y, q1.m_y, result );
+            result = Vector::MultiplyAdd( q0.m_z, q1.m_z, result );
+            result = Vector::MultiplyAdd( q0.m_w, q1.m_w, result );
+            return result;
+        }
+
+        // Calculates 'q0 * q1' for each of the four quaternions, matches the Quaternion multiplication operator
+        EE_FORCE_INLINE static QuaternionSoA4 Multiply( QuaternionSoA4 const& q0, QuaternionSoA4 const& q1 )
+        {
+            QuaternionSoA4 result;
+            result.m_x = ( q1.m_w * q0.m_x ) + ( q1.m_x * q0.m_w ) + ( q1.m_y * q0.m_z ) - ( q1.m_z * q0.m_y );
+            result.m_y = ( q1.m_w * q0.m_y ) - ( q1.m_x * q0.m_z ) + ( q1.m_y * q0.m_w ) + ( q1.m_z * q0.m_x );
+            result.m_z = ( q1.m_w * q0.m_z ) + ( q1.m_x * q0.m_y ) - ( q1.m_y * q0.m_x ) + ( q1.m_z * q0.m_w );
+            result.m_w = ( q1.m_w * q0.m_w ) - ( q1.m_x * q0.m_x ) - ( q1.m_y * q0.m_y ) - ( q1.m_z * q0.m_z );
+            return result;
+        }
+
+        // Spherical interpolation with a per-quaternion interpolation parameter, falls back to a normalized lerp for small angles
+        EE_FORCE_INLINE static QuaternionSoA4 SLerp( QuaternionSoA4 const& from, QuaternionSoA4 const& to, Vector const& t )
+        {
+            static __m128 const oneMinusEpsilon = { 1.0f - 0.00001f, 1.0f - 0.00001f, 1.0f - 0.00001f, 1.0f - 0.00001f };
+
+            // Ensure that the rotations are in the same direction
+            Vector cosOmega = Dot( from, to );
+            Vector const sign = Vector::Select( Vector::One, Vector::NegativeOne, cosOmega.LessThan( Vector::Zero ) );
+            cosOmega *= sign;
+
+            Vector const sinOmega = _mm_sqrt_ps( Vector::One - ( cosOmega * cosOmega ) );
+            Vector const omega = Vector::ATan2( sinOmega, cosOmega );
+            Vector const oneMinusT = Vector::One - t;
+
+            // Near parallel quaternions use the lerp weights, these lanes may contain invalid values for the slerp weights but are discarded by the select
+            Vector const useSLerp = cosOmega.LessThan( oneMinusEpsilon );
+            Vector s0 = Vector::Sin( oneMinusT * omega ) / sinOmega;
+            Vector s1 = Vector::Sin( t * omega ) / sinOmega;
+            s0 = Vector::Select( oneMinusT, s0, useSLerp );
+            s1 = Vector::Select( t, s1, useSLerp ) * sign;
+
+            QuaternionSoA4 result;
+            result.m_x = Vector::MultiplyAdd( to.m_x, s1, from.m_x * s0 );
+            result.m_y = Vector::MultiplyAdd( to.m_y, s1, from.m_y * s0 );
+            result.m_z = Vector::MultiplyAdd( to.m_z, s1, from.m_z * s0 );
+            result.m_w = Vector::MultiplyAdd( to.m_w, s1, from.m_w * s0 );
+            result.Normalize();
+            return result;
+        }
+
+        // Rotate a set of vectors by each of the four quaternions, matches Quaternion::RotateVector
+        EE_FORCE_INLINE static VectorSoA4 RotateVector( QuaternionSoA4 const& q, VectorSoA4 const& v )
+        {
+            // v' = v + w * t + ( q.xyz x t ), where t = 2 * ( q.xyz x v )
+            Vector const tx = ( ( q.m_y * v.m_z ) - ( q.m_z * v.m_y ) ) * 2.0f;
+            Vector const ty = ( ( q.m_z * v.m_x ) - ( q.m_x * v.m_z ) ) * 2.0f;
+            Vector const tz = ( ( q.m_x * v.m_y ) - ( q.m_y * v.m_x ) ) * 2.0f;
+
+            VectorSoA4 result;
+            result.m_x = Vector::MultiplyAdd( q.m_w, tx, v.m_x ) + ( q.m_y * tz ) - ( q.m_z * ty );
+            result.m_y = Vector::MultiplyAdd( q.m_w, ty, v.m_y ) + ( q.m_z * tx ) - ( q.m_x * tz );
+            result.m_z = Vector::MultiplyAdd( q.m_w, tz, v.m_z ) + ( q.m_x * ty ) - ( q.m_y * tx );
+            return result;
+        }
+
+        EE_FORCE_INLINE void Normalize()
+        {
+            Vector const length = _mm_sqrt_ps( Dot( *this, *this ) );
+            m_x /= length;
+            m_y /= length;
+            m_z /= length;
+            m_w /= length;
+        }
+
+        Vector                  m_x;
+        Vector                  m_y;
+        Vector                  m_z;
+        Vector                  m_w;
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct TransformSoA4
+    {
+        // Per-bone selection, the 'control' mask selects the transform from 'v1' when set
+        EE_FORCE_INLINE static TransformSoA4 Select( TransformSoA4 const& v0, TransformSoA4 const& v1, Vector const& control )
+        {
+            TransformSoA4 result;
+            result.m_rotation.m_x = Vector::Select( v0.m_rotation.m_x, v1.m_rotation.m_x, control );
+            result.m_rotation.m_y = Vector::Select( v0.m_rotation.m_y, v1.m_rotation.m_y, control );
+            result.m_rotation.m_z = Vector::Select( v0.m_rotation.m_z, v1.m_rotation.m_z, control );
+            result.m_rotation.m_w = Vector::Select( v0.m_rotation.m_w, v1.m_rotation.m_w, control );
+            result.m_translation.m_x = Vector::Select( v0.m_translation.m_x, v1.m_translation.m_x, control );
+            result.m_translation.m_y = Vector::Select( v0.m_translation.m_y, v1.m_translation.m_y, control );
+            result.m_translation.m_z = Vector::Select( v0.m_translation.m_z, v1.m_translation.m_z, control );
+            result.m_scale = Vector::Select( v0.m_scale, v1.m_scale, control );
+            return result;
+        }
+
+        // Calculates 't0 * t1' for each of the four transforms, matches the Transform multiplication operator
+        // Note: this doesnt handle negative scales, these need to be detected and handled by the regular transform multiplication
+        EE_FORCE_INLINE static TransformSoA4 Multiply( TransformSoA4 const& t0, TransformSoA4 const& t1 )
+        {
+            TransformSoA4 result;
+            result.m_rotation = QuaternionSoA4::Multiply( t0.m_rotation, t1.m_rotation );
+            result.m_rotation.Normalize();
+
+            VectorSoA4 scaledTranslation;
+            scaledTranslation.m_x = t0.m_translation.m_x * t1.m_scale;
+            scaledTranslation.m_y = t0.m_translation.m_y * t1.m_scale;
+            scaledTranslation.m_z = t0.m_translation.m_z * t1.m_scale;
+
+            result.m_translation = QuaternionSoA4::RotateVector( t1.m_rotation, scaledTranslation );
+            result.m_translation.m_x += t1.m_translation.m_x;
+            result.m_translation.m_y += t1.m_translation.m_y;
+            result.m_translation.m_z += t1.m_translation.m_z;
+
+            result.m_scale = t0.m_scale * t1.m_scale;
+            return result;
+        }
+
+    public:
+
+        EE_FORCE_INLINE bool HasNegativeScale() const { return m_scale.IsAnyLessThan( Vector::Zero ); }
+
+        // Transpose four consecutive transforms into SoA form
+        EE_FORCE_INLINE void Load( Transform const* pTransforms ) { Load( pTransforms[0], pTransforms[1], pTransforms[2], pTransforms[3] ); }
+
+        // Transpose four arbitrary transforms into SoA form
+        EE_FORCE_INLINE void Gather( Transform const* pTransforms, int32_t const* pIndices ) { Load( pTransforms[pIndices[0]], pTransforms[pIndices[1]], pTransforms[pIndices[2]], pTransforms[pIndices[3]] ); }
+
+        // Transpose back into four consecutive transforms
+        EE_FORCE_INLINE void Store( Transform* pTransforms ) const { Store( pTransforms[0], pTransforms[1], pTransforms[2], pTransforms[3] ); }
+
+        // Transpose back into four arbitrary transforms
+        EE_FORCE_INLINE void Scatter( Transform* pTransforms, int32_t const* pIndices ) const { Store( pTransforms[pIndices[0]], pTransforms[pIndices[1]], pTransforms[pIndices[2]], pTransforms[pIndices[3]] ); }
+
+        // Convert to four consecutive matrices, matches Transform::ToMatrix
+        EE_FORCE_INLINE void StoreMatrices( Matrix* pMatrices ) const
+        {
+            Vector m[3][3];
+            CalculateScaledRotationMatrix( m );
+
+            __m128 m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = _mm_setzero_ps();
+            __m128 m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = _mm_setzero_ps();
+            __m128 m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = _mm_setzero_ps();
+            __m128 m30 = m_translation.m_x, m31 = m_translation.m_y, m32 = m_translation.m_z, m33 = Vector::One;
+
+            // After transposing, each register contains a single matrix row
+            _MM_TRANSPOSE4_PS( m00, m01, m02, m03 );
+            _MM_TRANSPOSE4_PS( m10, m11, m12, m13 );
+            _MM_TRANSPOSE4_PS( m20, m21, m22, m23 );
+            _MM_TRANSPOSE4_PS( m30, m31, m32, m33 );
+
+            pMatrices[0].m_rows[0] = m00; pMatrices[0].m_rows[1] = m10; pMatrices[0].m_rows[2] = m20; pMatrices[0].m_rows[3] = m30;
+            pMatrices[1].m_rows[0] = m01; pMatrices[1].m_rows[1] = m11; pMatrices[1].m_rows[2] = m21; pMatrices[1].m_rows[3] = m31;
+            pMatrices[2].m_rows[0] = m02; pMatrices[2].m_rows[1] = m12; pMatrices[2].m_rows[2] = m22; pMatrices[2].m_rows[3] = m32;
+            pMatrices[3].m_rows[0] = m03; pMatrices[3].m_rows[1] = m13; pMatrices[3].m_rows[2] = m23; pMatrices[3].m_rows[3] = m33;
+        }
+
+        // Convert to four consecutive 3x4 matrices, each matrix is stored as the first three columns of the equivalent 4x4 matrix (3 vectors per transform)
+        EE_FORCE_INLINE void StoreMatrices3x4( Vector* pColumns ) const
+        {
+            Vector m[3][3];
+            CalculateScaledRotationMatrix( m );
+
+            __m128 c00 = m[0][0], c01 = m[1][0], c02 = m[2][0], c03 = m_translation.m_x;
+            __m128 c10 = m[0][1], c11 = m[1][1], c12 = m[2][1], c13 = m_translation.m_y;
+            __m128 c20 = m[0][2], c21 = m[1][2], c22 = m[2][2], c23 = m_translation.m_z;
+
+            // After transposing, each register contains a single matrix column
+            _MM_TRANSPOSE4_PS( c00, c01, c02, c03 );
+            _MM_TRANSPOSE4_PS( c10, c11, c12, c13 );
+            _MM_TRANSPOSE4_PS( c20, c21, c22, c23 );
+
+            pColumns[0] = c00; pColumns[1] = c10; pColumns[2] = c20;
+            pColumns[3] = c01; pColumns[4] = c11; pColumns[5] = c21;
+            pColumns[6] = c02; pColumns[7] = c12; pColumns[8] = c22;
+            pColumns[9] = c03; pColumns[10] = c13; pColumns[11] = c23;
+        }
+
+        // Convert to four consecutive unit dual quaternions (real and dual parts, 2 vectors per transform), the four uniform scales are stored separately in a single vector
+        EE_FORCE_INLINE void StoreDualQuaternions( Vector* pDualQuaternions, Vector& outScales ) const
+        {
+            QuaternionSoA4 const& q = m_rotation;
+            VectorSoA4 const& t = m_translation;
+
+            // Dual part is 0.5 * t * q (with t as a pure quaternion)
+            __m128 d0 = ( q.m_w * t.m_x + t.m_y * q.m_z - t.m_z * q.m_y ) * Vector::Half;
+            __m128 d1 = ( q.m_w * t.m_y + t.m_z * q.m_x - t.m_x * q.m_z ) * Vector::Half;
+            __m128 d2 = ( q.m_w * t.m_z + t.m_x * q.m_y - t.m_y * q.m_x ) * Vector::Half;
+            __m128 d3 = ( t.m_x * q.m_x + t.m_y * q.m_y + t.m_z * q.m_z ) * -Vector::Half;
+            __m128 r0 = q.m_x, r1 = q.m_y, r2 = q.m_z, r3 = q.m_w;
+
+            _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+            _MM_TRANSPOSE4_PS( d0, d1, d2, d3 );
+
+            pDualQuaternions[0] = r0; pDualQuaternions[1] = d0;
+            pDualQuaternions[2] = r1; pDualQuaternions[3] = d1;
+            pDualQuaternions[4] = r2; pDualQuaternions[5] = d2;
+            pDualQuaternions[6] = r3; pDualQuaternions[7] = d3;
+            outScales = m_scale;
+        }
+
+    private:
+
+        // Calculate the upper 3x3 of the scaled rotation matrix, each element contains the values for all four transforms
+        EE_FORCE_INLINE void CalculateScaledRotationMatrix( Vector m[3][3] ) const
+        {
+            QuaternionSoA4 const& q = m_rotation;
+            Vector const x2 = q.m_x + q.m_x;
+            Vector const y2 = q.m_y + q.m_y;
+            Vector const z2 = q.m_z + q.m_z;
+            Vector const xx = q.m_x * x2, yy = q.m_y * y2, zz = q.m_z * z2;
+            Vector const xy = q.m_x * y2, xz = q.m_x * z2, yz = q.m_y * z2;
+            Vector const wx = q.m_w * x2, wy = q.m_w * y2, wz = q.m_w * z2;
+
+            m[0][0] = ( Vector::One - yy - zz ) * m_scale; m[0][1] = ( xy + wz ) * m_scale; m[0][2] = ( xz - wy ) * m_scale;
+            m[1][0] = ( xy - wz ) * m_scale; m[1][1] = ( Vector::One - xx - zz ) * m_scale; m[1][2] = ( yz + wx ) * m_scale;
+            m[2][0] = ( xz + wy ) * m_scale; m[2][1] = ( yz - wx ) * m_scale; m[2][2] = ( Vector::One - xx - yy ) * m_scale;
+        }
+
+        EE_FORCE_INLINE void Load( Transform const& transform0, Transform const& transform1, Transform const& transform2, Transform const& transform3 )
+        {
+            __m128 r0 = transform0.GetRotation(), r1 = transform1.GetRotation(), r2 = transform2.GetRotation(), r3 = transform3.GetRotation();
+            _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+            m_rotation.m_x = r0;
+            m_rotation.m_y = r1;
+            m_rotation.m_z = r2;
+            m_rotation.m_w = r3;
+
+            __m128 t0 = transform0.GetTranslation(), t1 = transform1.GetTranslation(), t2 = transform2.GetTranslation(), t3 = transform3.GetTranslation();
+            _MM_TRANSPOSE4_PS( t0, t1, t2, t3 );
+            m_translation.m_x = t0;
+            m_translation.m_y = t1;
+            m_translation.m_z = t2;
+
+            m_scale = Vector( transform0.GetScale(), transform1.GetScale(), transform2.GetScale(), transform3.GetScale() );
+        }
+
+        EE_FORCE_INLINE void Store( Transform& transform0, Transform& transform1, Transform& transform2, Transform& transform3 ) const
+        {
+            __m128 r0 = m_rotation.m_x, r1 = m_rotation.m_y, r2 = m_rotation.m_z, r3 = m_rotation.m_w;
+            _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+            __m128 t0 = m_translation.m_x, t1 = m_translation.m_y, t2 = m_translation.m_z, t3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS( t0, t1, t2, t3 );
+
+            Float4 const scales = m_scale.ToFloat4();
+
+            transform0.SetRotation( Quaternion( Vector( r0 ) ) );
+            transform0.SetTranslation( t0 );
+            transform0.SetScale( scales.m_x );
+
+            transform1.SetRotation( Quaternion( Vector( r1 ) ) );
+            transform1.SetTranslation( t1 );
+            transform1.SetScale( scales.m_y );
+
+            transform2.SetRotation( Quaternion( Vector( r2 ) ) );
+            transform2.SetTranslation( t2 );
+            transform2.SetScale( scales.m_z );
+
+            transform3.SetRotation( Quaternion( Vector( r3 ) ) );
+            transform3.SetTranslation( t3 );
+            transform3.SetScale( scales.m_w );
+        }
+
+    public:
+
+        QuaternionSoA4          m_rotation;
+        VectorSoA4              m_translation;
+        Vector                  m_scale;
+    };
+}
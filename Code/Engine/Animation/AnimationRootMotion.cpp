@@ -5,14 +5,170 @@
 
 namespace EE::Animation
 {
+    int32_t CompressedRootMotion::GetFrameStride() const
+    {
+        int32_t stride = m_isRotationStatic ? 0 : 3;
+        for ( int32_t i = 0; i < 3; i++ )
+        {
+            if ( !IsTranslationComponentStatic( i ) )
+            {
+                stride++;
+            }
+        }
+
+        return stride;
+    }
+
+    void CompressedRootMotion::Compress( TVector<Transform> const& transforms )
+    {
+        EE_ASSERT( !transforms.empty() );
+
+        m_data.clear();
+        m_numFrames = (int32_t) transforms.size();
+
+        // Calculate translation ranges
+        //-------------------------------------------------------------------------
+
+        Vector minTranslation = transforms[0].GetTranslation();
+        Vector maxTranslation = minTranslation;
+        for ( auto const& transform : transforms )
+        {
+            minTranslation = Vector::Min( minTranslation, transform.GetTranslation() );
+            maxTranslation = Vector::Max( maxTranslation, transform.GetTranslation() );
+        }
+
+        m_translationRangeStart = minTranslation.ToFloat3();
+        m_translationRangeLength = ( maxTranslation - minTranslation ).ToFloat3();
+
+        for ( int32_t i = 0; i < 3; i++ )
+        {
+            if ( m_translationRangeLength[i] < s_staticTranslationTolerance )
+            {
+                // Use the midpoint of the range for static components to halve the max error
+                m_translationRangeStart[i] += m_translationRangeLength[i] / 2;
+                m_translationRangeLength[i] = 0.0f;
+            }
+        }
+
+        // Check for static rotation
+        //-------------------------------------------------------------------------
+
+        m_staticRotation = transforms[0].GetRotation();
+        m_isRotationStatic = true;
+        for ( auto const& transform : transforms )
+        {
+            if ( Quaternion::Distance( m_staticRotation, transform.GetRotation() ) > s_staticRotationTolerance )
+            {
+                m_isRotationStatic = false;
+                m_staticRotation = Quaternion::Identity;
+                break;
+            }
+        }
+
+        // Encode frames
+        //-------------------------------------------------------------------------
+
+        int32_t const stride = GetFrameStride();
+        if ( stride == 0 )
+        {
+            return;
+        }
+
+        m_data.reserve( stride * m_numFrames );
+        for ( auto const& transform : transforms )
+        {
+            if ( !m_isRotationStatic )
+            {
+                Quantization::EncodedQuaternion const encodedRotation( transform.GetRotation() );
+                m_data.emplace_back( encodedRotation.GetData0() );
+                m_data.emplace_back( encodedRotation.GetData1() );
+                m_data.emplace_back( encodedRotation.GetData2() );
+            }
+
+            Vector const& translation = transform.GetTranslation();
+            for ( int32_t i = 0; i < 3; i++ )
+            {
+                if ( !IsTranslationComponentStatic( i ) )
+                {
+                    m_data.emplace_back( Quantization::EncodeFloat( translation[i], m_translationRangeStart[i], m_translationRangeLength[i] ) );
+                }
+            }
+        }
+    }
+
+    void CompressedRootMotion::Decompress( TVector<Transform>& outTransforms ) const
+    {
+        int32_t const stride = GetFrameStride();
+        EE_ASSERT( m_data.size() == size_t( stride * m_numFrames ) );
+
+        outTransforms.resize( m_numFrames );
+
+        uint16_t const* pFrameData = m_data.data();
+        for ( int32_t frameIdx = 0; frameIdx < m_numFrames; frameIdx++ )
+        {
+            uint16_t const* pData = pFrameData;
+
+            Quaternion rotation = m_staticRotation;
+            if ( !m_isRotationStatic )
+            {
+                rotation = Quantization::EncodedQuaternion( pData[0], pData[1], pData[2] ).ToQuaternion();
+                pData += 3;
+            }
+
+            Float3 translation = m_translationRangeStart;
+            for ( int32_t i = 0; i < 3; i++ )
+            {
+                if ( !IsTranslationComponentStatic( i ) )
+                {
+                    translation[i] = Quantization::DecodeFloat( *pData, m_translationRangeStart[i], m_translationRangeLength[i] );
+                    pData++;
+                }
+            }
+
+            outTransforms[frameIdx] = Transform( rotation, Vector( translation, 0.0f ) );
+            pFrameData += stride;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     void RootMotionData::Clear()
     {
         m_transforms.clear();
+        m_inverseTransforms.clear();
+        m_compressedData = CompressedRootMotion();
         m_averageLinearVelocity = 0.0f;
         m_averageAngularVelocity = 0.0f;
         m_totalDelta = Transform::Identity;
     }
 
+    void RootMotionData::Compress()
+    {
+        EE_ASSERT( !m_transforms.empty() );
+        m_compressedData.Compress( m_transforms );
+
+        // Ensure that the runtime data is exactly what we will get when loading
+        m_compressedData.Decompress( m_transforms );
+        UpdateLookupTables();
+    }
+
+    void RootMotionData::Decompress()
+    {
+        m_compressedData.Decompress( m_transforms );
+        m_compressedData = CompressedRootMotion();
+        UpdateLookupTables();
+    }
+
+    void RootMotionData::UpdateLookupTables()
+    {
+        int32_t const numFrames = GetNumFrames();
+        m_inverseTransforms.resize( numFrames );
+        for ( int32_t i = 0; i < numFrames; i++ )
+        {
+            m_inverseTransforms[i] = m_transforms[i].GetInverse();
+        }
+    }
+
     #if EE_DEVELOPMENT_TOOLS
     void RootMotionData::DrawDebug( Drawing::DrawContext& ctx, Transform const& worldTransform ) const
     {
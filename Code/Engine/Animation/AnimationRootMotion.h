@@ -2,6 +2,7 @@
 #include "Engine/_Module/API.h"
 #include "AnimationFrameTime.h"
 #include "System/Math/Transform.h"
+#include "System/Algorithm/Quantization.h"
 #include "System/Types/Arrays.h"
 
 //-------------------------------------------------------------------------
@@ -12,16 +13,71 @@ namespace EE::Drawing { class DrawContext; }
 
 namespace EE::Animation
 {
+    //-------------------------------------------------------------------------
+    // Compressed Root Motion
+    //-------------------------------------------------------------------------
+    // The serialized form of the root motion: rotations are stored as encoded quaternions and each translation component is quantized to 16bits
+    // over its own range. Components that dont change over the course of the animation are stripped and only stored once.
+    //
+    // Per frame layout: [ 3 x uint16_t rotation (if not static) ][ 1 x uint16_t per non-static translation component ]
+
+    struct EE_ENGINE_API CompressedRootMotion
+    {
+        EE_SERIALIZE( m_data, m_translationRangeStart, m_translationRangeLength, m_staticRotation, m_numFrames, m_isRotationStatic );
+
+        // A translation component is considered static if its range is smaller than this
+        constexpr static float const s_staticTranslationTolerance = 0.0001f;
+
+        // The rotation is considered static if every frame is within this angle of the first frame
+        constexpr static float const s_staticRotationTolerance = Math::DegreesToRadians * 0.01f;
+
+    public:
+
+        inline bool IsTranslationComponentStatic( int32_t componentIdx ) const { EE_ASSERT( componentIdx >= 0 && componentIdx < 3 ); return m_translationRangeLength[componentIdx] == 0.0f; }
+
+        // Get the number of uint16_t values stored per frame
+        int32_t GetFrameStride() const;
+
+        void Compress( TVector<Transform> const& transforms );
+        void Decompress( TVector<Transform>& outTransforms ) const;
+
+    public:
+
+        TVector<uint16_t>                       m_data;
+        Float3                                  m_translationRangeStart = Float3::Zero;
+        Float3                                  m_translationRangeLength = Float3::Zero; // A zero length means that the component is static
+        Quaternion                              m_staticRotation = Quaternion::Identity;
+        int32_t                                 m_numFrames = 0;
+        bool                                    m_isRotationStatic = true;
+    };
+
+    //-------------------------------------------------------------------------
+    // Root Motion
+    //-------------------------------------------------------------------------
+    // Only the compressed root motion is serialized, the runtime transforms and lookup tables are created from it on load.
+    // The transforms are cumulative (relative to the start of the animation), so we also store the inverse of each frame's transform
+    // and a delta between two times is a single multiply: delta = to * from^-1
+    // If you modify the transforms, you need to call 'UpdateLookupTables' before querying the root motion.
+
     struct EE_ENGINE_API RootMotionData
     {
-        EE_SERIALIZE( m_transforms, m_averageLinearVelocity, m_averageAngularVelocity, m_totalDelta );
+        EE_SERIALIZE( m_compressedData, m_averageLinearVelocity, m_averageAngularVelocity, m_totalDelta );
 
     public:
 
-        inline bool IsValid() const { return !m_transforms.empty(); }
+        inline bool IsValid() const { return !m_transforms.empty() && m_inverseTransforms.size() == m_transforms.size(); }
 
         void Clear();
 
+        // Compress the current transforms into the serialized data, this will update the transforms to the compressed values
+        void Compress();
+
+        // Decompress the serialized data and create the runtime lookup tables. The compressed data is released once this is done.
+        void Decompress();
+
+        // Recalculate the inverse transforms, needs to be called whenever the transforms are modified
+        void UpdateLookupTables();
+
         // Get the number of root motion transforms
         inline int32_t GetNumFrames() const { return (int32_t) m_transforms.size(); }
 
@@ -41,6 +97,11 @@ namespace EE::Animation
         // Get the delta for the root motion for the given time range. DOES NOT SUPPORT LOOPING!
         inline Transform GetDeltaNoLooping( Percentage fromTime, Percentage toTime ) const;
 
+        #if EE_DEVELOPMENT_TOOLS
+        // Reference implementation of 'GetDeltaNoLooping' that samples both transforms and calculates the delta directly, used to validate the lookup tables
+        inline Transform GetDeltaNoLoopingReference( Percentage fromTime, Percentage toTime ) const;
+        #endif
+
         // Get the average linear velocity of the root for this animation
         inline float GetAverageLinearVelocity() const { return m_averageLinearVelocity; }
 
@@ -66,9 +127,14 @@ namespace EE::Animation
 
         inline FrameTime GetFrameTime( Percentage percentageThrough ) const { return FrameTime( percentageThrough, GetNumFrames() ); }
 
+        // Get the inverse of the root transform at the given frame time, the rotation is never inverted since we slerp the inverse table
+        inline Transform GetInverseTransform( FrameTime const& frameTime ) const;
+
     public:
 
         TVector<Transform>                      m_transforms;
+        TVector<Transform>                      m_inverseTransforms;
+        CompressedRootMotion                    m_compressedData;
         float                                   m_averageLinearVelocity = 0.0f; // In m/s
         Radians                                 m_averageAngularVelocity = 0.0f; // In rad/s, only on the X/Y plane
         Transform                               m_totalDelta;
@@ -104,12 +170,48 @@ namespace EE::Animation
         return displacementTransform;
     }
 
+    inline Transform RootMotionData::GetInverseTransform( FrameTime const& frameTime ) const
+    {
+        EE_ASSERT( IsValid() );
+        EE_ASSERT( frameTime.GetFrameIndex() < m_inverseTransforms.size() );
+
+        if ( frameTime.IsExactlyAtKeyFrame() )
+        {
+            return m_inverseTransforms[frameTime.GetFrameIndex()];
+        }
+
+        // The slerp of the inverse rotations is the inverse of the slerped rotation, but the translation needs to be rotated into the inverse space
+        Transform const& frameStartTransform = m_transforms[frameTime.GetFrameIndex()];
+        Transform const& frameEndTransform = m_transforms[frameTime.GetFrameIndex() + 1];
+        Quaternion const inverseRotation = Quaternion::SLerp( m_inverseTransforms[frameTime.GetFrameIndex()].GetRotation(), m_inverseTransforms[frameTime.GetFrameIndex() + 1].GetRotation(), frameTime.GetPercentageThrough() );
+        Vector const translation = Vector::Lerp( frameStartTransform.GetTranslation(), frameEndTransform.GetTranslation(), frameTime.GetPercentageThrough() );
+        return Transform( inverseRotation, inverseRotation.RotateVector( translation ).GetNegated() );
+    }
+
     EE_FORCE_INLINE Transform RootMotionData::GetDeltaNoLooping( Percentage fromTime, Percentage toTime ) const
     {
+        if ( fromTime.ToFloat() == toTime.ToFloat() )
+        {
+            return Transform::Identity;
+        }
+
+        // Delta = to * from^-1
+        return GetTransform( toTime ) * GetInverseTransform( GetFrameTime( fromTime ) );
+    }
+
+    #if EE_DEVELOPMENT_TOOLS
+    inline Transform RootMotionData::GetDeltaNoLoopingReference( Percentage fromTime, Percentage toTime ) const
+    {
+        if ( fromTime.ToFloat() == toTime.ToFloat() )
+        {
+            return Transform::Identity;
+        }
+
         Transform const startTransform = GetTransform( fromTime );
         Transform const endTransform = GetTransform( toTime );
         return Transform::DeltaNoScale( startTransform, endTransform );
     }
+    #endif
 
     EE_FORCE_INLINE Transform RootMotionData::GetDelta( Percentage fromTime, Percentage toTime ) const
     {
@@ -5,9 +5,100 @@
 
 namespace EE::Animation
 {
+    #if EE_DEVELOPMENT_TOOLS
+    Skeleton* Skeleton::CreateProceduralSkeleton( int32_t numBones )
+    {
+        EE_ASSERT( numBones > 0 );
+
+        Skeleton* pSkeleton = EE::New<Skeleton>();
+        pSkeleton->m_boneIDs.reserve( numBones );
+        pSkeleton->m_parentIndices.reserve( numBones );
+        pSkeleton->m_localReferencePose.reserve( numBones );
+
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            char boneName[32];
+            Printf( boneName, 32, "Bone_%d", boneIdx );
+            pSkeleton->m_boneIDs.emplace_back( StringID( boneName ) );
+
+            // Mostly chains, with every fourth bone branching off an earlier bone so that we get both deep and wide hierarchies
+            int32_t const parentIdx = ( boneIdx == 0 ) ? InvalidIndex : ( ( boneIdx % 4 ) == 1 ) ? boneIdx / 8 : boneIdx - 1;
+            pSkeleton->m_parentIndices.emplace_back( parentIdx );
+
+            Quaternion const rotation( EulerAngles( Degrees( float( boneIdx % 7 ) * 5.0f ), Degrees( float( boneIdx % 5 ) * -7.0f ), Degrees( float( boneIdx % 3 ) * 11.0f ) ) );
+            Vector const translation( 0.01f * ( boneIdx % 3 ), 0.1f, 0.02f * ( boneIdx % 2 ) );
+            pSkeleton->m_localReferencePose.emplace_back( Transform( rotation, translation ) );
+        }
+
+        pSkeleton->m_boneFlags.resize( numBones );
+        pSkeleton->m_numBonesToSampleAtLowLOD = numBones;
+        pSkeleton->CalculateDepthOrderedBoneIndices();
+        pSkeleton->CalculateGlobalReferencePose();
+
+        EE_ASSERT( pSkeleton->IsValid() );
+        return pSkeleton;
+    }
+    #endif
+
+    void Skeleton::CalculateDepthOrderedBoneIndices()
+    {
+        int32_t const numBones = (int32_t) m_parentIndices.size();
+
+        TVector<int32_t> boneDepths;
+        boneDepths.resize( numBones, 0 );
+
+        int32_t numDepthLevels = 0;
+        for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            int32_t const parentIdx = m_parentIndices[boneIdx];
+            if ( parentIdx != InvalidIndex )
+            {
+                EE_ASSERT( parentIdx < boneIdx );
+                boneDepths[boneIdx] = boneDepths[parentIdx] + 1;
+            }
+
+            numDepthLevels = Math::Max( numDepthLevels, boneDepths[boneIdx] + 1 );
+        }
+
+        // Counting sort by depth, bones within a level remain in index order
+        m_depthLevelStartIndices.clear();
+        m_depthLevelStartIndices.resize( numDepthLevels + 1, 0 );
+        for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            m_depthLevelStartIndices[boneDepths[boneIdx] + 1]++;
+        }
+
+        for ( auto levelIdx = 0; levelIdx < numDepthLevels; levelIdx++ )
+        {
+            m_depthLevelStartIndices[levelIdx + 1] += m_depthLevelStartIndices[levelIdx];
+        }
+
+        TVector<int32_t> levelInsertionIndices( m_depthLevelStartIndices.begin(), m_depthLevelStartIndices.end() - 1 );
+        m_depthOrderedBoneIndices.resize( numBones );
+        for ( auto boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            m_depthOrderedBoneIndices[levelInsertionIndices[boneDepths[boneIdx]]++] = boneIdx;
+        }
+    }
+
+    void Skeleton::CalculateGlobalReferencePose()
+    {
+        int32_t const numBones = GetNumBones();
+        m_globalReferencePose.resize( numBones );
+
+        m_globalReferencePose[0] = m_localReferencePose[0];
+        for ( auto boneIdx = 1; boneIdx < numBones; boneIdx++ )
+        {
+            int32_t const parentIdx = GetParentBoneIndex( boneIdx );
+            m_globalReferencePose[boneIdx] = m_localReferencePose[boneIdx] * m_globalReferencePose[parentIdx];
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     bool Skeleton::IsValid() const
     {
-        return !m_boneIDs.empty() && ( m_boneIDs.size() == m_parentIndices.size() ) && ( m_boneIDs.size() == m_localReferencePose.size() );
+        return !m_boneIDs.empty() && ( m_boneIDs.size() == m_parentIndices.size() ) && ( m_boneIDs.size() == m_localReferencePose.size() ) && ( m_boneIDs.size() == m_depthOrderedBoneIndices.size() ) && ( m_numBonesToSampleAtLowLOD > 0 && m_numBonesToSampleAtLowLOD <= m_boneIDs.size() );
     }
 
     Transform Skeleton::GetBoneGlobalTransform( int32_t idx ) const
@@ -25,16 +25,39 @@ namespace EE::Animation
     class EE_ENGINE_API Skeleton : public Resource::IResource
     {
         EE_REGISTER_RESOURCE( 'skel', "Animation Skeleton" );
-        EE_SERIALIZE( m_boneIDs, m_localReferencePose, m_parentIndices, m_boneFlags );
+        EE_SERIALIZE( m_boneIDs, m_localReferencePose, m_parentIndices, m_boneFlags, m_depthOrderedBoneIndices, m_depthLevelStartIndices, m_numBonesToSampleAtLowLOD );
 
         friend class SkeletonCompiler;
         friend class SkeletonLoader;
 
     public:
 
+        // Bone level of detail
+        // Bones are ordered so that all the bones needed for the low LOD come first, at the low LOD only these bones are sampled/blended
+        // The remaining (high LOD only) bones are left untouched by the pose tasks and are set to the reference pose in the final pose
+        enum class LOD : uint8_t
+        {
+            Low,
+            High,
+        };
+
+    public:
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Create a skeleton with the specified number of bones and a branching hierarchy, used to benchmark the pose operations at different skeleton sizes
+        // All bones are part of the low LOD. The caller owns the returned skeleton and needs to delete it
+        static Skeleton* CreateProceduralSkeleton( int32_t numBones );
+        #endif
+
         virtual bool IsValid() const final;
         inline int32_t GetNumBones() const { return (int32_t) m_boneIDs.size(); }
 
+        // Get the number of bones that need to be evaluated for the specified LOD
+        inline int32_t GetNumBones( LOD lod ) const { return ( lod == LOD::High ) ? (int32_t) m_boneIDs.size() : m_numBonesToSampleAtLowLOD; }
+
+        // Is the specified bone only evaluated at the high LOD
+        inline bool IsHighLODBone( int32_t idx ) const { EE_ASSERT( IsValidBoneIndex( idx ) ); return idx >= m_numBonesToSampleAtLowLOD; }
+
         // Bone info
         //-------------------------------------------------------------------------
 
@@ -53,6 +76,15 @@ namespace EE::Animation
             return m_parentIndices[idx];
         }
 
+        // Get all bone indices sorted by their depth in the hierarchy, bones at the same depth are independent of one another
+        inline TVector<int32_t> const& GetDepthOrderedBoneIndices() const { return m_depthOrderedBoneIndices; }
+
+        // Get the start index (into the depth ordered bone indices) for each depth level, there is an additional entry at the end for the total number of bones
+        inline TVector<int32_t> const& GetDepthLevelStartIndices() const { return m_depthLevelStartIndices; }
+
+        // Get the number of depth levels in the hierarchy
+        inline int32_t GetNumDepthLevels() const { return (int32_t) m_depthLevelStartIndices.size() - 1; }
+
         // Find the index of the first child encountered for the specified bone. Returns InvalidIndex if this is a leaf bone.
         int32_t GetFirstChildBoneIndex( int32_t boneIdx ) const;
 
@@ -93,6 +125,14 @@ namespace EE::Animation
         void DrawDebug( Drawing::DrawContext& ctx, Transform const& worldTransform ) const;
         #endif
 
+    private:
+
+        // Sort the bones by their depth in the hierarchy, requires the parent indices to be set
+        void CalculateDepthOrderedBoneIndices();
+
+        // Calculate the global reference pose from the local reference pose
+        void CalculateGlobalReferencePose();
+
     private:
 
         TVector<StringID>                   m_boneIDs;
@@ -100,6 +140,9 @@ namespace EE::Animation
         TVector<Transform>                  m_localReferencePose;
         TVector<Transform>                  m_globalReferencePose;
         TVector<TBitFlags<BoneFlags>>       m_boneFlags;
+        TVector<int32_t>                    m_depthOrderedBoneIndices;
+        TVector<int32_t>                    m_depthLevelStartIndices;
+        int32_t                             m_numBonesToSampleAtLowLOD = 0;
     };
 
     //-------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 #include "AnimationSyncTrack.h"
+#include <eastl/algorithm.h>
 
 //-------------------------------------------------------------------------
 
@@ -139,22 +140,21 @@ namespace EE::Animation
         }
         else // Search the sync track for the event and percent
         {
-            for ( auto syncEventIdx = 0; syncEventIdx < numSyncEvents; syncEventIdx++ )
+            // Find the first event whose end time (i.e. start time of next event) is greater than the playback percent
+            // Sync events are contiguous and sorted so the end times are increasing and we can binary search them
+            auto const endTimeLessThan = [] ( Event const& syncEvent, float percentage ) { return ( syncEvent.m_startTime.ToFloat() + syncEvent.m_duration.ToFloat() ) < percentage; };
+            int32_t const syncEventIdx = int32_t( eastl::lower_bound( m_syncEvents.begin(), m_syncEvents.end(), percentageThrough.ToFloat(), endTimeLessThan ) - m_syncEvents.begin() );
+            if ( syncEventIdx < numSyncEvents )
             {
-                // Find the first event whose end time (i.e. start time of next event) is greater than the playback percent
-                if ( ( m_syncEvents[syncEventIdx].m_startTime + m_syncEvents[syncEventIdx].m_duration ) >= percentageThrough )
-                {
-                    EE_ASSERT( m_syncEvents[syncEventIdx].m_duration > Math::Epsilon );
+                EE_ASSERT( m_syncEvents[syncEventIdx].m_duration > Math::Epsilon );
 
-                    time.m_eventIdx = syncEventIdx;
-                    time.m_percentageThrough = ( percentageThrough - m_syncEvents[syncEventIdx].m_startTime ) / m_syncEvents[syncEventIdx].m_duration;
+                time.m_eventIdx = syncEventIdx;
+                time.m_percentageThrough = ( percentageThrough - m_syncEvents[syncEventIdx].m_startTime ) / m_syncEvents[syncEventIdx].m_duration;
 
-                    // Handle looping sequences
-                    while ( time.m_percentageThrough > 1.0f )
-                    {
-                        time.m_percentageThrough -= 1.0f;
-                    }
-                    break;
+                // Handle looping sequences
+                while ( time.m_percentageThrough > 1.0f )
+                {
+                    time.m_percentageThrough -= 1.0f;
                 }
             }
         }
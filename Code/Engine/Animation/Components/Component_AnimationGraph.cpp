@@ -2,8 +2,10 @@
 #include "Engine/Entity/EntityLog.h"
 #include "Engine/Animation/TaskSystem/Animation_TaskSystem.h"
 #include "Engine/Animation/AnimationPose.h"
+#include "Engine/Animation/AnimationBlender.h"
 #include "Engine/UpdateContext.h"
 #include "Engine/Physics/PhysicsScene.h"
+#include "System/Time/Timers.h"
 
 //-------------------------------------------------------------------------
 
@@ -26,6 +28,8 @@ namespace EE::Animation
 
     void AnimationGraphComponent::Shutdown()
     {
+        EE::Delete( m_pPreviousPose );
+        EE::Delete( m_pInterpolatedPose );
         EE::Delete( m_pGraphInstance );
         EntityComponent::Shutdown();
     }
@@ -48,6 +52,11 @@ namespace EE::Animation
 
     Pose const* AnimationGraphComponent::GetPose() const
     {
+        if ( m_interpolationFrame < m_interpolationPeriod )
+        {
+            return m_pInterpolatedPose;
+        }
+
         return m_pGraphInstance->GetPose();
     }
 
@@ -64,23 +73,192 @@ namespace EE::Animation
         }
     }
 
+    void AnimationGraphComponent::SetSkeletonLOD( Skeleton::LOD lod )
+    {
+        EE_ASSERT( HasGraphInstance() );
+        m_pGraphInstance->SetSkeletonLOD( lod );
+    }
+
+    void AnimationGraphComponent::SetSampleBatch( SampleTaskBatch* pSampleBatch )
+    {
+        EE_ASSERT( HasGraphInstance() );
+        m_pGraphInstance->SetSampleBatch( pSampleBatch );
+    }
+
+    void AnimationGraphComponent::UpdateSkeletonLOD( float distanceFromViewer )
+    {
+        EE_ASSERT( distanceFromViewer >= 0.0f );
+
+        if ( m_lowLODDistance <= 0.0f )
+        {
+            SetSkeletonLOD( Skeleton::LOD::High );
+            return;
+        }
+
+        // Use a smaller distance to switch back to the high LOD so that characters near the LOD distance dont flicker between LODs every frame
+        if ( m_pGraphInstance->GetSkeletonLOD() == Skeleton::LOD::Low )
+        {
+            if ( distanceFromViewer < m_lowLODDistance * s_lowLODHysteresisScale )
+            {
+                SetSkeletonLOD( Skeleton::LOD::High );
+            }
+        }
+        else if ( distanceFromViewer > m_lowLODDistance )
+        {
+            SetSkeletonLOD( Skeleton::LOD::Low );
+        }
+    }
+
+    void AnimationGraphComponent::SetUpdateRate( uint8_t period, uint8_t phase )
+    {
+        EE_ASSERT( period >= 1 && phase < period );
+        m_pendingUpdatePeriod = period;
+        m_pendingUpdatePhase = phase;
+
+        // Changing the rate mid-interpolation could trigger an evaluation before the current period ends and cut the interpolation short
+        if ( m_interpolationFrame >= m_interpolationPeriod )
+        {
+            ApplyPendingUpdateRate();
+        }
+    }
+
+    void AnimationGraphComponent::ApplyPendingUpdateRate()
+    {
+        EE_ASSERT( m_interpolationFrame >= m_interpolationPeriod );
+        m_updatePeriod = m_pendingUpdatePeriod;
+        m_updatePhase = m_pendingUpdatePhase;
+    }
+
     void AnimationGraphComponent::EvaluateGraph( Seconds deltaTime, Transform const& characterWorldTransform, Physics::Scene* pPhysicsScene )
     {
         EE_ASSERT( HasGraph() );
-        auto const result = m_pGraphInstance->EvaluateGraph( deltaTime, characterWorldTransform, pPhysicsScene );
-        m_rootMotionDelta = result.m_rootMotionDelta;
+
+        Timer<PlatformClock> timer;
+
+        // Include all the time that elapsed while we were skipping evaluations
+        Seconds const evaluationDeltaTime = deltaTime + m_accumulatedDeltaTime;
+        m_accumulatedDeltaTime = 0.0f;
+
+        auto const result = m_pGraphInstance->EvaluateGraph( evaluationDeltaTime, characterWorldTransform, pPhysicsScene );
+        m_wasGraphEvaluated = true;
+
+        // If we were still interpolating, the part of the previous root motion that we havent applied yet is added to the new delta so that we dont lose any motion
+        //-------------------------------------------------------------------------
+
+        bool const wasInterpolating = m_interpolationFrame < m_interpolationPeriod;
+        if ( wasInterpolating )
+        {
+            Transform const appliedDelta = Transform::Slerp( Transform::Identity, m_evaluatedRootMotionDelta, float( m_interpolationFrame ) / m_interpolationPeriod );
+            Transform const remainingDelta = m_evaluatedRootMotionDelta * appliedDelta.GetInverse();
+            m_evaluatedRootMotionDelta = result.m_rootMotionDelta * remainingDelta;
+        }
+        else
+        {
+            m_evaluatedRootMotionDelta = result.m_rootMotionDelta;
+        }
+
+        // Store the currently presented pose so that we can interpolate from it to the new pose over the update period
+        // If an interpolation was still running we always blend out of the presented pose, even at full rate, to avoid popping
+        //-------------------------------------------------------------------------
+
+        Pose const* pPresentedPose = m_pGraphInstance->GetPose();
+        bool const canInterpolate = wasInterpolating || ( m_updatePeriod > 1 && pPresentedPose->IsPoseSet() );
+        if ( canInterpolate )
+        {
+            if ( m_pPreviousPose == nullptr )
+            {
+                m_pPreviousPose = EE::New<Pose>( GetSkeleton() );
+                m_pInterpolatedPose = EE::New<Pose>( GetSkeleton() );
+            }
+
+            m_pPreviousPose->CopyFrom( GetPose() );
+            // The update rate cant change mid-interpolation so the period is only ever 1 here if we were evaluated out of schedule, we still need a frame to blend over
+            m_interpolationPeriod = Math::Max( m_updatePeriod, (uint8_t) 2 );
+        }
+        else
+        {
+            m_interpolationPeriod = 1;
+        }
+
+        m_interpolationFrame = 0;
+        UpdateInterpolation();
+
+        m_evaluationCost = timer.GetElapsedTimeMilliseconds();
+    }
+
+    void AnimationGraphComponent::SkipGraphEvaluation( Seconds deltaTime )
+    {
+        EE_ASSERT( HasGraph() );
+        m_accumulatedDeltaTime += deltaTime;
+        m_wasGraphEvaluated = false;
+
+        UpdateInterpolation();
+        UpdateInterpolatedPose();
     }
 
-    void AnimationGraphComponent::ExecutePrePhysicsTasks( Seconds deltaTime, Transform const& characterWorldTransform )
+    void AnimationGraphComponent::UpdateInterpolation()
+    {
+        // Once the interpolation is complete, we hold the last evaluated pose and have no more root motion to apply
+        if ( m_interpolationFrame >= m_interpolationPeriod )
+        {
+            m_rootMotionDelta = Transform::Identity;
+            return;
+        }
+
+        m_interpolationFrame++;
+
+        // The update period has completed, so any requested update rate can now take effect
+        if ( m_interpolationFrame >= m_interpolationPeriod )
+        {
+            ApplyPendingUpdateRate();
+        }
+
+        // Spread the root motion across the update period, each frame gets the delta between two consecutive points on the interpolated root motion
+        if ( m_interpolationPeriod == 1 )
+        {
+            m_rootMotionDelta = m_evaluatedRootMotionDelta;
+        }
+        else
+        {
+            float const periodFraction = 1.0f / m_interpolationPeriod;
+            Transform const startDelta = Transform::Slerp( Transform::Identity, m_evaluatedRootMotionDelta, ( m_interpolationFrame - 1 ) * periodFraction );
+            Transform const endDelta = Transform::Slerp( Transform::Identity, m_evaluatedRootMotionDelta, m_interpolationFrame * periodFraction );
+            m_rootMotionDelta = endDelta * startDelta.GetInverse();
+        }
+    }
+
+    void AnimationGraphComponent::UpdateInterpolatedPose()
+    {
+        if ( m_interpolationFrame < m_interpolationPeriod )
+        {
+            // Always blend the full skeleton, since the previous pose might have been evaluated at a different LOD
+            float const blendWeight = float( m_interpolationFrame ) / m_interpolationPeriod;
+            Blender::Blend( Skeleton::LOD::High, m_pPreviousPose, m_pGraphInstance->GetPose(), blendWeight, TBitFlags<PoseBlendOptions>(), nullptr, m_pInterpolatedPose );
+            m_pInterpolatedPose->CalculateGlobalTransforms();
+        }
+    }
+
+    void AnimationGraphComponent::ExecutePrePhysicsTasks( Seconds deltaTime, Transform const& characterWorldTransform, EE::TaskSystem* pTaskScheduler )
     {
         EE_ASSERT( HasGraph() );
-        m_pGraphInstance->ExecutePrePhysicsPoseTasks( characterWorldTransform );
+        Timer<PlatformClock> timer;
+        m_pGraphInstance->ExecutePrePhysicsPoseTasks( characterWorldTransform, pTaskScheduler );
+        m_evaluationCost += timer.GetElapsedTimeMilliseconds();
     }
 
-    void AnimationGraphComponent::ExecutePostPhysicsTasks()
+    void AnimationGraphComponent::ExecutePostPhysicsTasks( EE::TaskSystem* pTaskScheduler )
     {
         EE_ASSERT( HasGraph() );
-        m_pGraphInstance->ExecutePostPhysicsPoseTasks();
+        Timer<PlatformClock> timer;
+        m_pGraphInstance->ExecutePostPhysicsPoseTasks( pTaskScheduler );
+
+        // Present the first interpolated pose for this update period
+        UpdateInterpolatedPose();
+
+        // Include the time spent sampling our poses in the world's sample batch, since this is not measured by any of our own stages
+        m_evaluationCost += timer.GetElapsedTimeMilliseconds();
+        m_evaluationCost += m_pGraphInstance->GetSampleBatchCost();
+        m_averageEvaluationCost = Math::Lerp( m_averageEvaluationCost.ToFloat(), m_evaluationCost.ToFloat(), 0.1f );
     }
 
     //-------------------------------------------------------------------------
@@ -6,6 +6,13 @@
 
 //-------------------------------------------------------------------------
 
+namespace EE
+{
+    class TaskSystem;
+}
+
+//-------------------------------------------------------------------------
+
 namespace EE::Animation
 {
     enum class TaskSystemDebugMode;
@@ -43,6 +50,7 @@ namespace EE::Animation
         inline void ShouldApplyRootMotionToEntity( bool isEnabled ) { m_applyRootMotionToEntity = isEnabled; }
 
         // Gets the root motion delta for the last update (Note: this delta is in character space!)
+        // When throttled, this is the portion of the last evaluated delta for the current frame
         inline Transform const& GetRootMotionDelta() const { return m_rootMotionDelta; }
 
         // Get the graph variation ID
@@ -51,6 +59,45 @@ namespace EE::Animation
         // This function will change the graph and data-set used! Note: this can only be called for unloaded components
         void SetGraphVariation( ResourceID graphResourceID );
 
+        // LOD
+        //-------------------------------------------------------------------------
+
+        // Explicitly set the skeleton LOD to evaluate the pose at
+        void SetSkeletonLOD( Skeleton::LOD lod );
+
+        // Select the skeleton LOD based on the distance from the viewer to the character
+        // Characters switch to the low LOD beyond the low LOD distance and only switch back once they are closer than 'm_lowLODDistance * s_lowLODHysteresisScale'
+        void UpdateSkeletonLOD( float distanceFromViewer );
+
+        // Set the world's sample batch that the pose sampling should be deferred to, set to null to sample immediately
+        void SetSampleBatch( SampleTaskBatch* pSampleBatch );
+
+        // Update Rate Budgeting
+        //-------------------------------------------------------------------------
+
+        // Set the viewer relationship used by the animation budget manager to determine this component's significance
+        inline void SetViewerInfo( float distanceFromViewer, bool isVisible ) { m_distanceFromViewer = distanceFromViewer; m_isVisibleToViewer = isVisible; }
+        inline float GetDistanceFromViewer() const { return m_distanceFromViewer; }
+        inline bool IsVisibleToViewer() const { return m_isVisibleToViewer; }
+
+        // Set the update rate i.e. the graph is only evaluated every 'period' frames, offset by 'phase' frames
+        // If we are still interpolating towards the last evaluated pose, the new rate only takes effect once the current update period has completed
+        void SetUpdateRate( uint8_t period, uint8_t phase );
+        inline uint8_t GetUpdatePeriod() const { return m_updatePeriod; }
+        inline uint8_t GetUpdatePhase() const { return m_updatePhase; }
+
+        // Should the graph be evaluated this frame
+        inline bool ShouldEvaluateGraph( uint64_t frameID ) const { return ( m_updatePeriod <= 1 ) || ( ( frameID + m_updatePhase ) % m_updatePeriod ) == 0; }
+
+        // Get the smoothed time taken to evaluate the graph and execute its tasks
+        inline Milliseconds GetAverageEvaluationCost() const { return m_averageEvaluationCost; }
+
+        // Was the graph evaluated this frame, if not there are no pose tasks to execute
+        inline bool WasGraphEvaluated() const { return m_wasGraphEvaluated; }
+
+        // Skip the graph evaluation for this frame - accumulates the time delta for the next evaluation and advances the pose interpolation and root motion
+        void SkipGraphEvaluation( Seconds deltaTime );
+
         // Graph evaluation
         //-------------------------------------------------------------------------
 
@@ -61,10 +108,11 @@ namespace EE::Animation
         void EvaluateGraph( Seconds deltaTime, Transform const& characterWorldTransform, Physics::Scene* pPhysicsScene );
 
         // This function will execute all pre-physics tasks - it assumes that the character has already been moved in the scene, so expects the final transform for this frame
-        void ExecutePrePhysicsTasks( Seconds deltaTime, Transform const& characterWorldTransform );
+        // If a task scheduler is provided, large task graphs will have their independent tasks executed in parallel
+        void ExecutePrePhysicsTasks( Seconds deltaTime, Transform const& characterWorldTransform, EE::TaskSystem* pTaskScheduler = nullptr );
 
         // The function will execute the post-physics tasks (if any)
-        void ExecutePostPhysicsTasks();
+        void ExecutePostPhysicsTasks( EE::TaskSystem* pTaskScheduler = nullptr );
 
         // Control Parameters
         //-------------------------------------------------------------------------
@@ -129,12 +177,42 @@ namespace EE::Animation
 
     private:
 
+        // Characters in the low LOD need to get closer than this fraction of the low LOD distance to switch back to the high LOD
+        static constexpr float const s_lowLODHysteresisScale = 0.9f;
+
+    private:
+
+        // Advance the interpolation by a frame and calculate the root motion delta for it
+        void UpdateInterpolation();
+
+        // Blend between the previous and the last evaluated pose for the current interpolation frame
+        void UpdateInterpolatedPose();
+
+        // Apply the requested update rate, only valid once the current interpolation has completed
+        void ApplyPendingUpdateRate();
+
         EE_EXPOSE TResourcePtr<GraphVariation>                  m_pGraphVariation = nullptr;
 
         GraphInstance*                                          m_pGraphInstance = nullptr;
         SampledEventsBuffer                                     m_sampledEventsBuffer;
         Transform                                               m_rootMotionDelta = Transform::Identity;
+        Transform                                               m_evaluatedRootMotionDelta = Transform::Identity; // The full root motion delta from the last graph evaluation
+        Pose*                                                   m_pPreviousPose = nullptr; // The pose presented when the graph was last evaluated, we interpolate from it to the newly evaluated pose
+        Pose*                                                   m_pInterpolatedPose = nullptr;
+        Seconds                                                 m_accumulatedDeltaTime = 0.0f;
+        Milliseconds                                            m_evaluationCost = 0.0f;
+        Milliseconds                                            m_averageEvaluationCost = 0.0f;
+        float                                                   m_distanceFromViewer = 0.0f;
+        uint8_t                                                 m_updatePeriod = 1;
+        uint8_t                                                 m_updatePhase = 0;
+        uint8_t                                                 m_pendingUpdatePeriod = 1; // The requested update rate, applied once the current interpolation completes
+        uint8_t                                                 m_pendingUpdatePhase = 0;
+        uint8_t                                                 m_interpolationPeriod = 1; // The update period at the time of the last evaluation
+        uint8_t                                                 m_interpolationFrame = 1; // The number of frames presented since the last evaluation
+        bool                                                    m_isVisibleToViewer = true;
+        bool                                                    m_wasGraphEvaluated = false;
         EE_EXPOSE bool                                          m_requiresManualUpdate = false;  // Does this component require a manual update via a custom entity system?
         EE_EXPOSE bool                                          m_applyRootMotionToEntity = false; // Should we apply the root motion delta automatically to the character once we evaluate the graph. (Note: only works if we dont require a manual update)
+        EE_EXPOSE float                                         m_lowLODDistance = 30.0f; // Characters further than this distance (in meters) from the viewer will only evaluate their low LOD bones, set to zero to always use the high LOD
     };
 }
\ No newline at end of file
@@ -149,6 +149,20 @@ namespace EE::Animation
 
         // Always use the task system from the context as this is guaranteed to be set
         auto pTaskSystem = pGraphInstance->m_graphContext.m_pTaskSystem;
+
+        // Pose memory, the steady state should never require any heap allocations
+        PoseBufferPool const& posePool = pTaskSystem->m_posePool;
+        ImGui::Text( "Pose Buffers: %d (%.2f KB)", posePool.GetNumBuffers(), posePool.GetArenaSize() / 1024.0f );
+        ImGui::TextColored( ( posePool.GetNumHeapAllocationsLastFrame() > 0 ) ? Colors::Red.ToFloat4() : Colors::LimeGreen.ToFloat4(), "Pose Heap Allocations: %u last frame, %u total", posePool.GetNumHeapAllocationsLastFrame(), posePool.GetNumHeapAllocations() );
+
+        // Duplicate sample requests share a single decoded pose
+        uint32_t const numSampleRequests = pTaskSystem->GetNumSampleTaskRequests();
+        uint64_t const totalNumSampleRequests = pTaskSystem->GetTotalNumSampleTaskRequests();
+        float const sharedSampleRate = ( numSampleRequests > 0 ) ? 100.0f * pTaskSystem->GetNumSharedSampleTasks() / numSampleRequests : 0.0f;
+        float const totalSharedSampleRate = ( totalNumSampleRequests > 0 ) ? 100.0f * pTaskSystem->GetTotalNumSharedSampleTasks() / totalNumSampleRequests : 0.0f;
+        ImGui::Text( "Shared Samples: %u/%u (%.1f%%) this frame, %.1f%% total", pTaskSystem->GetNumSharedSampleTasks(), numSampleRequests, sharedSampleRate, totalSharedSampleRate );
+        ImGui::Separator();
+
         if ( !pTaskSystem->HasTasks() )
         {
             ImGui::Text( "No Active Tasks" );
@@ -372,8 +386,75 @@ namespace EE::Animation
 
     //-------------------------------------------------------------------------
 
+    void AnimationDebugView::DrawGraphInstanceMemoryView()
+    {
+        // Gather all the variations used in this world, child graphs allocate from the pools of their own variations
+        TVector<GraphVariation const*> graphVariations;
+        for ( AnimationGraphComponent* pGraphComponent : m_pAnimationWorldSystem->m_graphComponents )
+        {
+            if ( pGraphComponent->m_pGraphInstance != nullptr && !VectorContains( graphVariations, pGraphComponent->m_pGraphInstance->GetGraphVariation() ) )
+            {
+                graphVariations.emplace_back( pGraphComponent->m_pGraphInstance->GetGraphVariation() );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        size_t totalMemory = 0;
+        int32_t totalInstances = 0;
+
+        if ( ImGui::BeginTable( "GraphInstanceMemoryTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+        {
+            ImGui::TableSetupColumn( "Variation", ImGuiTableColumnFlags_WidthStretch );
+            ImGui::TableSetupColumn( "Instances", ImGuiTableColumnFlags_WidthFixed, 70 );
+            ImGui::TableSetupColumn( "Bytes/Instance", ImGuiTableColumnFlags_WidthFixed, 100 );
+            ImGui::TableSetupColumn( "Slabs", ImGuiTableColumnFlags_WidthFixed, 50 );
+            ImGui::TableSetupColumn( "Total (KB)", ImGuiTableColumnFlags_WidthFixed, 80 );
+            ImGui::TableHeadersRow();
+
+            for ( GraphVariation const* pGraphVariation : graphVariations )
+            {
+                GraphInstanceMemoryPool const& pool = pGraphVariation->GetInstanceMemoryPool();
+                totalMemory += pool.GetTotalMemory();
+                totalInstances += pool.GetNumInstances();
+
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::Text( pGraphVariation->GetResourceID().c_str() );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%d", pool.GetNumInstances() );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%u", pool.GetSlotSize() );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%d", pool.GetNumSlabs() );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.2f", pool.GetTotalMemory() / 1024.0f );
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::Text( "Total: %d instances, %.2f KB", totalInstances, totalMemory / 1024.0f );
+    }
+
+    //-------------------------------------------------------------------------
+
     void AnimationDebugView::DrawMenu( EntityWorldUpdateContext const& context )
     {
+        if ( ImGui::MenuItem( "Show Graph Instance Memory" ) )
+        {
+            m_drawGraphInstanceMemory = true;
+        }
+
+        ImGui::Separator();
+
+        //-------------------------------------------------------------------------
+
         InlineString componentName;
         for ( AnimationGraphComponent* pGraphComponent : m_pAnimationWorldSystem->m_graphComponents )
         {
@@ -478,6 +559,18 @@ namespace EE::Animation
 
     void AnimationDebugView::DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass )
     {
+        if ( m_drawGraphInstanceMemory )
+        {
+            ImGui::SetNextWindowSize( ImVec2( 600, 300 ), ImGuiCond_FirstUseEver );
+            if ( ImGui::Begin( "Graph Instance Memory", &m_drawGraphInstanceMemory, ImGuiWindowFlags_NoSavedSettings ) )
+            {
+                DrawGraphInstanceMemoryView();
+            }
+            ImGui::End();
+        }
+
+        //-------------------------------------------------------------------------
+
         InlineString title;
 
         for ( int32_t i = (int32_t) m_componentRuntimeSettings.size() - 1; i >= 0; i-- )
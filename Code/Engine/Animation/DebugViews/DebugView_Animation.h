@@ -55,6 +55,7 @@ namespace EE::Animation
         virtual void Shutdown() override;
         virtual void DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass ) override;
         void DrawMenu( EntityWorldUpdateContext const& context );
+        void DrawGraphInstanceMemoryView();
 
         ComponentDebugState* GetDebugState( ComponentID ID );
         void DestroyDebugState( ComponentID ID );
@@ -64,6 +65,7 @@ namespace EE::Animation
         EntityWorld const*                      m_pWorld = nullptr;
         AnimationWorldSystem*                   m_pAnimationWorldSystem = nullptr;
         TVector<ComponentDebugState>         m_componentRuntimeSettings;
+        bool                                    m_drawGraphInstanceMemory = false;
     };
 }
 #endif
\ No newline at end of file
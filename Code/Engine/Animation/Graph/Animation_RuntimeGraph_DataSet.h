@@ -34,6 +34,9 @@ namespace EE::Animation
             return nullptr;
         }
 
+        // Get all the resources used by this data set, some slots may not be set
+        inline TVector<Resource::ResourcePtr> const& GetResources() const { return m_resources; }
+
     private:
 
         StringID                                    m_variationID;
@@ -1,6 +1,7 @@
 #pragma once
 #include "Animation_RuntimeGraph_Node.h"
 #include "Animation_RuntimeGraph_DataSet.h"
+#include "Animation_RuntimeGraph_InstanceMemoryPool.h"
 #include "System/Resource/ResourcePtr.h"
 
 //-------------------------------------------------------------------------
@@ -101,9 +102,19 @@ namespace EE::Animation
             return m_pGraphDefinition.GetPtr();
         }
 
+        inline GraphDataSet const* GetDataSet() const
+        {
+            EE_ASSERT( IsValid() );
+            return &m_dataSet;
+        }
+
+        // Get the pool that all graph instances of this variation allocate their node memory from
+        inline GraphInstanceMemoryPool const& GetInstanceMemoryPool() const { return m_instanceMemoryPool; }
+
     protected:
 
         TResourcePtr<GraphDefinition>               m_pGraphDefinition = nullptr;
         GraphDataSet                                m_dataSet;
+        mutable GraphInstanceMemoryPool             m_instanceMemoryPool;
     };
 }
\ No newline at end of file
@@ -32,7 +32,8 @@ namespace EE::Animation
         size_t const numNodes = pGraphDef->m_instanceNodeStartOffsets.size();
         EE_ASSERT( pGraphDef->m_nodeSettings.size() == numNodes );
 
-        m_pAllocatedInstanceMemory = reinterpret_cast<uint8_t*>( EE::Alloc( pGraphDef->m_instanceRequiredMemory, pGraphDef->m_instanceRequiredAlignment ) );
+        // All instances of a variation share a pooled allocator, this keeps identical characters contiguous in memory
+        m_pAllocatedInstanceMemory = reinterpret_cast<uint8_t*>( m_pGraphVariation->m_instanceMemoryPool.Allocate( pGraphDef->m_instanceRequiredMemory, pGraphDef->m_instanceRequiredAlignment ) );
 
         m_nodes.reserve( numNodes );
 
@@ -153,7 +154,8 @@ namespace EE::Animation
         }
         m_childGraphs.clear();
 
-        EE::Free( m_pAllocatedInstanceMemory );
+        m_pGraphVariation->m_instanceMemoryPool.Free( m_pAllocatedInstanceMemory );
+        m_pAllocatedInstanceMemory = nullptr;
         EE::Delete( m_pTaskSystem );
     }
 
@@ -329,7 +331,31 @@ namespace EE::Animation
         return m_pRootNode->Update( m_graphContext, updateRange );
     }
 
-    void GraphInstance::ExecutePrePhysicsPoseTasks( Transform const& endWorldTransform )
+    void GraphInstance::SetSkeletonLOD( Skeleton::LOD lod )
+    {
+        EE_ASSERT( m_pTaskSystem != nullptr );
+        m_pTaskSystem->SetSkeletonLOD( lod );
+    }
+
+    void GraphInstance::SetSampleBatch( SampleTaskBatch* pSampleBatch )
+    {
+        EE_ASSERT( m_pTaskSystem != nullptr );
+        m_pTaskSystem->SetSampleBatch( pSampleBatch );
+    }
+
+    Milliseconds GraphInstance::GetSampleBatchCost() const
+    {
+        EE_ASSERT( m_pTaskSystem != nullptr );
+        return m_pTaskSystem->GetSampleBatchCost();
+    }
+
+    Skeleton::LOD GraphInstance::GetSkeletonLOD() const
+    {
+        EE_ASSERT( m_pTaskSystem != nullptr );
+        return m_pTaskSystem->GetSkeletonLOD();
+    }
+
+    void GraphInstance::ExecutePrePhysicsPoseTasks( Transform const& endWorldTransform, EE::TaskSystem* pTaskScheduler )
     {
         EE_PROFILE_SCOPE_ANIMATION( "Graph Instance: Pre-Physics Tasks" );
 
@@ -356,13 +382,13 @@ namespace EE::Animation
 
         //-------------------------------------------------------------------------
 
-        m_pTaskSystem->UpdatePrePhysics( m_graphContext.m_deltaTime, endWorldTransform, endWorldTransform.GetInverse() );
+        m_pTaskSystem->UpdatePrePhysics( m_graphContext.m_deltaTime, endWorldTransform, endWorldTransform.GetInverse(), pTaskScheduler );
     }
 
-    void GraphInstance::ExecutePostPhysicsPoseTasks()
+    void GraphInstance::ExecutePostPhysicsPoseTasks( EE::TaskSystem* pTaskScheduler )
     {
         EE_PROFILE_SCOPE_ANIMATION( "Graph Instance: Post-Physics Tasks" );
-        m_pTaskSystem->UpdatePostPhysics();
+        m_pTaskSystem->UpdatePostPhysics( pTaskScheduler );
     }
 
     //-------------------------------------------------------------------------
@@ -6,6 +6,11 @@
 
 //-------------------------------------------------------------------------
 
+namespace EE
+{
+    class TaskSystem;
+}
+
 namespace EE::Physics
 {
     class Scene;
@@ -17,6 +22,7 @@ namespace EE::Animation
 {
     class GraphContext;
     class TaskSystem;
+    class SampleTaskBatch;
     class GraphNode;
     class PoseNode;
     enum class TaskSystemDebugMode;
@@ -71,6 +77,7 @@ namespace EE::Animation
         // Info 
         //-------------------------------------------------------------------------
 
+        inline GraphVariation const* GetGraphVariation() const { return m_pGraphVariation; }
         inline StringID const& GetVariationID() const { return m_pGraphVariation->m_dataSet.m_variationID; }
         inline ResourceID const& GetResourceID() const { return m_pGraphVariation->GetResourceID(); }
         inline ResourceID const& GetDefinitionResourceID() const { return m_pGraphVariation->m_pGraphDefinition->GetResourceID(); }
@@ -80,6 +87,16 @@ namespace EE::Animation
 
         Pose const* GetPose();
 
+        // Set the skeleton LOD that the pose tasks will be executed at
+        void SetSkeletonLOD( Skeleton::LOD lod );
+        Skeleton::LOD GetSkeletonLOD() const;
+
+        // Set the batch that the pose sampling should be deferred to (see TaskSystem::SetSampleBatch)
+        void SetSampleBatch( SampleTaskBatch* pSampleBatch );
+
+        // Get the time the sample batch spent sampling this instance's poses this frame (see TaskSystem::GetSampleBatchCost)
+        Milliseconds GetSampleBatchCost() const;
+
         // Graph State
         //-------------------------------------------------------------------------
 
@@ -96,10 +113,11 @@ namespace EE::Animation
         GraphPoseNodeResult EvaluateGraph( Seconds const deltaTime, Transform const& startWorldTransform, Physics::Scene* pPhysicsScene, SyncTrackTimeRange const& updateRange );
 
         // Execute any pre-physics pose tasks (assumes the character is at its final position for this frame)
-        void ExecutePrePhysicsPoseTasks( Transform const& endWorldTransform );
+        // If a task scheduler is provided, large task graphs will be executed in parallel
+        void ExecutePrePhysicsPoseTasks( Transform const& endWorldTransform, EE::TaskSystem* pTaskScheduler = nullptr );
 
         // Execute any post-physics pose tasks
-        void ExecutePostPhysicsPoseTasks();
+        void ExecutePostPhysicsPoseTasks( EE::TaskSystem* pTaskScheduler = nullptr );
 
         // Get the sampled events for the last update
         SampledEventsBuffer const& GetSampledEvents() const { return m_graphContext.m_sampledEventsBuffer; }
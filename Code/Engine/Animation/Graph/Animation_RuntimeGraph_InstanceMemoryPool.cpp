@@ -0,0 +1,74 @@
+#include "Animation_RuntimeGraph_InstanceMemoryPool.h"
+#include "System/Math/Math.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    GraphInstanceMemoryPool::~GraphInstanceMemoryPool()
+    {
+        EE_ASSERT( m_numInstances == 0 );
+
+        for ( auto pSlab : m_slabs )
+        {
+            EE::Free( pSlab );
+        }
+    }
+
+    void GraphInstanceMemoryPool::AllocateSlab()
+    {
+        EE_ASSERT( m_pFreeList == nullptr && m_slotSize > 0 );
+
+        auto pSlab = reinterpret_cast<uint8_t*>( EE::Alloc( size_t( m_slotSize ) * s_numInstancesPerSlab, m_instanceAlignment ) );
+        m_slabs.emplace_back( pSlab );
+
+        // Link the slots in order so that consecutive allocations are contiguous
+        for ( int32_t i = s_numInstancesPerSlab - 1; i >= 0; i-- )
+        {
+            void* pSlot = pSlab + ( size_t( i ) * m_slotSize );
+            *reinterpret_cast<void**>( pSlot ) = m_pFreeList;
+            m_pFreeList = pSlot;
+        }
+    }
+
+    void* GraphInstanceMemoryPool::Allocate( uint32_t instanceSize, uint32_t instanceAlignment )
+    {
+        EE_ASSERT( instanceSize > 0 && instanceAlignment > 0 );
+
+        Threading::ScopeLock lock( m_mutex );
+
+        // The slot layout is set by the first allocation
+        if ( m_slotSize == 0 )
+        {
+            m_instanceSize = instanceSize;
+            m_instanceAlignment = Math::Max( instanceAlignment, (uint32_t) alignof( void* ) );
+            m_slotSize = Math::RoundUpToNearestMultiple32( Math::Max( instanceSize, (uint32_t) sizeof( void* ) ), m_instanceAlignment );
+        }
+        else
+        {
+            EE_ASSERT( instanceSize == m_instanceSize && Math::Max( instanceAlignment, (uint32_t) alignof( void* ) ) == m_instanceAlignment );
+        }
+
+        if ( m_pFreeList == nullptr )
+        {
+            AllocateSlab();
+        }
+
+        void* pInstanceMemory = m_pFreeList;
+        m_pFreeList = *reinterpret_cast<void**>( pInstanceMemory );
+        m_numInstances++;
+        return pInstanceMemory;
+    }
+
+    void GraphInstanceMemoryPool::Free( void* pInstanceMemory )
+    {
+        EE_ASSERT( pInstanceMemory != nullptr );
+
+        Threading::ScopeLock lock( m_mutex );
+        EE_ASSERT( m_numInstances > 0 );
+
+        *reinterpret_cast<void**>( pInstanceMemory ) = m_pFreeList;
+        m_pFreeList = pInstanceMemory;
+        m_numInstances--;
+    }
+}
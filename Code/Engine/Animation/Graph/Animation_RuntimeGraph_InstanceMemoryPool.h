@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "System/Threading/Threading.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Graph Instance Memory Pool
+//-------------------------------------------------------------------------
+// Pooled allocator for the node memory of graph instances that share a graph variation
+// Instances are allocated from slabs of contiguous fixed size slots, this keeps identical characters close together in memory
+// and avoids fragmenting the heap when large numbers of characters using the same variation are spawned/destroyed
+
+namespace EE::Animation
+{
+    class EE_ENGINE_API GraphInstanceMemoryPool
+    {
+    public:
+
+        constexpr static int32_t const s_numInstancesPerSlab = 16;
+
+    public:
+
+        GraphInstanceMemoryPool() = default;
+        GraphInstanceMemoryPool( GraphInstanceMemoryPool const& ) = delete;
+        ~GraphInstanceMemoryPool();
+
+        GraphInstanceMemoryPool& operator=( GraphInstanceMemoryPool const& ) = delete;
+
+        // Allocate the memory for a single instance - threadsafe
+        // All allocations from a pool need to have the same size and alignment
+        void* Allocate( uint32_t instanceSize, uint32_t instanceAlignment );
+
+        // Return the memory for an instance to the pool - threadsafe
+        void Free( void* pInstanceMemory );
+
+        #if EE_DEVELOPMENT_TOOLS
+        inline uint32_t GetInstanceSize() const { return m_instanceSize; }
+        inline uint32_t GetSlotSize() const { return m_slotSize; }
+        inline int32_t GetNumInstances() const { return m_numInstances; }
+        inline int32_t GetNumSlabs() const { return (int32_t) m_slabs.size(); }
+        inline size_t GetTotalMemory() const { return size_t( m_slabs.size() ) * m_slotSize * s_numInstancesPerSlab; }
+        #endif
+
+    private:
+
+        // Allocate a new slab and add all its slots to the free list
+        void AllocateSlab();
+
+    private:
+
+        TInlineVector<void*, 4>                 m_slabs;
+        void*                                   m_pFreeList = nullptr;      // Intrusive list of free slots, each free slot stores the ptr to the next one
+        uint32_t                                m_instanceSize = 0;
+        uint32_t                                m_instanceAlignment = 0;
+        uint32_t                                m_slotSize = 0;
+        int32_t                                 m_numInstances = 0;
+        Threading::Mutex                        m_mutex;
+    };
+}
@@ -236,7 +236,7 @@ namespace EE::Animation::GraphNodes
         //-------------------------------------------------------------------------
 
         Percentage const sampleTime = m_shouldPlayInReverse ? Percentage( 1.0f - m_currentTime.ToFloat() ) : m_currentTime;
-        result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::SampleTask>( GetNodeIndex(), m_pAnimation, sampleTime );
+        result.m_taskIdx = context.m_pTaskSystem->RegisterSampleTask( GetNodeIndex(), m_pAnimation, sampleTime );
         return result;
     }
 }
\ No newline at end of file
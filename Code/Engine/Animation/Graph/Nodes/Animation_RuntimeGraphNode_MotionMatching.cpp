@@ -0,0 +1,359 @@
+#include "Animation_RuntimeGraphNode_MotionMatching.h"
+#include "Engine/Animation/Graph/Animation_RuntimeGraph_RootMotionDebugger.h"
+#include "Engine/Animation/Graph/Animation_RuntimeGraph_DataSet.h"
+#include "Engine/Animation/TaskSystem/Animation_TaskSystem.h"
+#include "Engine/Animation/TaskSystem/Tasks/Animation_Task_Blend.h"
+#include "Engine/Animation/AnimationBlender.h"
+#include "System/Profiling.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation::GraphNodes
+{
+    void MotionMatchingNode::Settings::InstantiateNode( InstantiationContext const& context, InstantiationOptions options ) const
+    {
+        auto pNode = CreateNode<MotionMatchingNode>( context, options );
+        context.SetOptionalNodePtrFromIndex( m_desiredVelocityValueNodeIdx, pNode->m_pDesiredVelocityValueNode );
+        context.SetOptionalNodePtrFromIndex( m_desiredFacingValueNodeIdx, pNode->m_pDesiredFacingValueNode );
+        pNode->m_pDatabase = context.GetResource<MotionDatabase>( m_dataSlotIdx );
+    }
+
+    bool MotionMatchingNode::IsValid() const
+    {
+        return PoseNode::IsValid() && m_pDatabase != nullptr && m_pDatabase->IsValid();
+    }
+
+    void MotionMatchingNode::InitializeInternal( GraphContext& context, SyncTrackTime const& initialTime )
+    {
+        PoseNode::InitializeInternal( context, initialTime );
+
+        if ( m_pDesiredVelocityValueNode != nullptr )
+        {
+            m_pDesiredVelocityValueNode->Initialize( context );
+        }
+
+        if ( m_pDesiredFacingValueNode != nullptr )
+        {
+            m_pDesiredFacingValueNode->Initialize( context );
+        }
+
+        // Start at the beginning of the first clip, the first update will immediately search for a better match
+        if ( IsValid() )
+        {
+            m_query.resize( m_pDatabase->GetQuerySize() );
+            m_currentClipIdx = 0;
+            m_duration = m_pDatabase->GetClip( m_currentClipIdx )->GetDuration();
+            m_currentTime = m_previousTime = 0.0f;
+        }
+
+        m_blendSources.clear();
+        m_blendElapsedTime = 0.0f;
+        m_timeSinceLastSearch = GetSettings<MotionMatchingNode>()->m_searchInterval;
+    }
+
+    void MotionMatchingNode::ShutdownInternal( GraphContext& context )
+    {
+        if ( m_pDesiredFacingValueNode != nullptr )
+        {
+            m_pDesiredFacingValueNode->Shutdown( context );
+        }
+
+        if ( m_pDesiredVelocityValueNode != nullptr )
+        {
+            m_pDesiredVelocityValueNode->Shutdown( context );
+        }
+
+        m_currentClipIdx = InvalidIndex;
+        m_blendSources.clear();
+        m_currentTime = m_previousTime = 0.0f;
+        PoseNode::ShutdownInternal( context );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void MotionMatchingNode::CalculateDesiredTrajectory( GraphContext& context, MotionDatabase::TrajectorySample* pOutTrajectory ) const
+    {
+        Vector desiredVelocity = Vector::Zero;
+        if ( m_pDesiredVelocityValueNode != nullptr )
+        {
+            desiredVelocity = context.m_worldTransformInverse.RotateVector( m_pDesiredVelocityValueNode->GetValue<Vector>( context ) ).Get2D();
+        }
+
+        // If no facing is supplied, we face the direction of travel
+        Vector desiredFacing = Vector::WorldForward;
+        if ( m_pDesiredFacingValueNode != nullptr )
+        {
+            Vector const facing = context.m_worldTransformInverse.RotateVector( m_pDesiredFacingValueNode->GetValue<Vector>( context ) ).Get2D();
+            if ( !facing.IsNearZero2() )
+            {
+                desiredFacing = facing.GetNormalized2();
+            }
+        }
+        else if ( desiredVelocity.GetLength2() > 0.1f )
+        {
+            desiredFacing = desiredVelocity.GetNormalized2();
+        }
+
+        // The facing is turned from the current facing to the desired facing over the duration of the trajectory
+        int32_t const numSamples = m_pDatabase->GetNumTrajectorySamples();
+        Seconds const trajectoryDuration = m_pDatabase->GetTrajectorySampleTime( numSamples - 1 );
+        for ( int32_t i = 0; i < numSamples; i++ )
+        {
+            Seconds const sampleTime = m_pDatabase->GetTrajectorySampleTime( i );
+            Vector const position = desiredVelocity * sampleTime.ToFloat();
+            Vector facing = Vector::Lerp( Vector::WorldForward, desiredFacing, sampleTime.ToFloat() / trajectoryDuration.ToFloat() );
+            facing = facing.IsNearZero2() ? desiredFacing : facing.GetNormalized2();
+
+            pOutTrajectory[i].m_position = Float2( position.GetX(), position.GetY() );
+            pOutTrajectory[i].m_facing = Float2( facing.GetX(), facing.GetY() );
+        }
+    }
+
+    bool MotionMatchingNode::PerformSearch( GraphContext& context, bool forceTransition )
+    {
+        EE_PROFILE_SCOPE_ANIMATION( "Motion Matching Search" );
+
+        auto pSettings = GetSettings<MotionMatchingNode>();
+        m_timeSinceLastSearch = 0.0f;
+
+        MotionDatabase::TrajectorySample desiredTrajectory[MotionDatabase::s_maxTrajectorySamples];
+        CalculateDesiredTrajectory( context, desiredTrajectory );
+
+        int32_t const currentEntryIdx = m_pDatabase->GetEntryIndex( m_currentClipIdx, m_currentTime );
+        m_pDatabase->CreateQuery( currentEntryIdx, desiredTrajectory, m_query.data() );
+
+        MotionDatabase::SearchResult const bestMatch = m_pDatabase->FindBestMatch( m_query.data(), pSettings->m_useAccelerationStructure );
+        if ( !bestMatch.IsValid() )
+        {
+            return false;
+        }
+
+        // Only jump if the match is somewhere else and noticeably better than just continuing playback
+        //-------------------------------------------------------------------------
+
+        MotionDatabase::Entry const& bestEntry = m_pDatabase->GetEntry( bestMatch.m_entryIdx );
+        Percentage const bestEntryTime = m_pDatabase->GetEntryTime( bestMatch.m_entryIdx );
+
+        if ( bestEntry.m_clipIdx == m_currentClipIdx && Math::Abs( ( bestEntryTime - m_currentTime ).ToFloat() * m_duration ) < s_sameClipTimeThreshold )
+        {
+            return false;
+        }
+
+        if ( !forceTransition )
+        {
+            float const currentCost = m_pDatabase->CalculateCost( m_query.data(), currentEntryIdx );
+            if ( bestMatch.m_cost >= currentCost * ( 1.0f - pSettings->m_minCostImprovement ) )
+            {
+                return false;
+            }
+        }
+
+        // Cross-fade from the current clip to the new one
+        //-------------------------------------------------------------------------
+        // If we are still blending, the current clip is pushed on top of the existing sources so that we blend out of the blended result
+
+        if ( pSettings->m_blendTime > 0.0f )
+        {
+            if ( m_blendSources.size() == s_maxBlendSources )
+            {
+                // Wait for one of the existing blends to complete unless we have run out of clip
+                if ( !forceTransition )
+                {
+                    return false;
+                }
+
+                m_blendSources.erase( m_blendSources.begin() );
+            }
+
+            BlendSource& blendSource = m_blendSources.emplace_back();
+            blendSource.m_clipIdx = m_currentClipIdx;
+            blendSource.m_previousTime = m_previousTime;
+            blendSource.m_currentTime = m_currentTime;
+            blendSource.m_blendInTime = m_blendElapsedTime;
+            m_blendElapsedTime = 0.0f;
+        }
+
+        m_currentClipIdx = bestEntry.m_clipIdx;
+        m_duration = m_pDatabase->GetClip( m_currentClipIdx )->GetDuration();
+        m_currentTime = m_previousTime = bestEntryTime;
+        m_loopCount = 0;
+        return true;
+    }
+
+    void MotionMatchingNode::SampleEvents( GraphContext& context, int32_t clipIdx, Percentage previousTime, Percentage currentTime, GraphPoseNodeResult& result ) const
+    {
+        result.m_sampledEventRange = context.m_sampledEventsBuffer.GetNumEvents();
+
+        AnimationClip const* pClip = m_pDatabase->GetClip( clipIdx );
+        TInlineVector<Event const*, 10> sampledAnimationEvents;
+        pClip->GetEventsForRangeNoLooping( previousTime * pClip->GetDuration(), currentTime * pClip->GetDuration(), sampledAnimationEvents );
+
+        bool const isFromInactiveBranch = ( context.m_branchState == BranchState::Inactive );
+        for ( auto pEvent : sampledAnimationEvents )
+        {
+            Percentage percentageThroughEvent = 1.0f;
+            if ( pEvent->IsDurationEvent() )
+            {
+                percentageThroughEvent = pEvent->GetTimeRange().GetPercentageThrough( currentTime * pClip->GetDuration() );
+            }
+
+            auto& createdEvent = context.m_sampledEventsBuffer.EmplaceAnimEvent( GetNodeIndex(), pEvent, percentageThroughEvent );
+            if ( isFromInactiveBranch )
+            {
+                createdEvent.GetFlags().SetFlag( SampledEvent::Flags::FromInactiveBranch );
+            }
+        }
+
+        result.m_sampledEventRange.m_endIdx = context.m_sampledEventsBuffer.GetNumEvents();
+    }
+
+    GraphPoseNodeResult MotionMatchingNode::Update( GraphContext& context )
+    {
+        EE_ASSERT( context.IsValid() );
+
+        if ( !IsValid() )
+        {
+            return GraphPoseNodeResult();
+        }
+
+        MarkNodeActive( context );
+        auto pSettings = GetSettings<MotionMatchingNode>();
+
+        // Update playback
+        //-------------------------------------------------------------------------
+        // Database clips are never looped, once we reach the last searchable frame we are forced to transition
+
+        m_previousTime = m_currentTime;
+        if ( m_duration > 0.0f )
+        {
+            m_currentTime = ( m_currentTime + Percentage( context.m_deltaTime / m_duration ) ).GetClamped( false );
+        }
+
+        m_blendElapsedTime += context.m_deltaTime;
+        for ( auto& blendSource : m_blendSources )
+        {
+            blendSource.m_blendInTime += context.m_deltaTime;
+            blendSource.m_previousTime = blendSource.m_currentTime;
+
+            Seconds const sourceDuration = m_pDatabase->GetClip( blendSource.m_clipIdx )->GetDuration();
+            if ( sourceDuration > 0.0f )
+            {
+                blendSource.m_currentTime = ( blendSource.m_currentTime + Percentage( context.m_deltaTime / sourceDuration ) ).GetClamped( false );
+            }
+        }
+
+        // Once a clip is fully blended in, nothing below it contributes to the pose anymore
+        if ( GetBlendWeight( m_blendElapsedTime ) >= 1.0f )
+        {
+            m_blendSources.clear();
+        }
+        else
+        {
+            for ( int32_t i = (int32_t) m_blendSources.size() - 1; i > 0; i-- )
+            {
+                if ( GetBlendWeight( m_blendSources[i].m_blendInTime ) >= 1.0f )
+                {
+                    m_blendSources.erase( m_blendSources.begin(), m_blendSources.begin() + i );
+                    break;
+                }
+            }
+        }
+
+        // Search
+        //-------------------------------------------------------------------------
+        // When we jump, the new clip hasnt played yet this frame so the events and root motion for this frame come from the clip we jumped from
+
+        m_timeSinceLastSearch += context.m_deltaTime;
+
+        int32_t const preSearchClipIdx = m_currentClipIdx;
+        Percentage const preSearchPreviousTime = m_previousTime;
+        Percentage const preSearchCurrentTime = m_currentTime;
+
+        bool hasJumped = false;
+        int32_t const currentFrameIdx = (int32_t) m_pDatabase->GetClip( m_currentClipIdx )->GetFrameTime( m_currentTime ).GetNearestFrameIndex();
+        bool const hasReachedEndOfClip = currentFrameIdx >= m_pDatabase->GetLastSearchableFrameIdx( m_currentClipIdx );
+        if ( hasReachedEndOfClip || m_timeSinceLastSearch >= pSettings->m_searchInterval )
+        {
+            hasJumped = PerformSearch( context, hasReachedEndOfClip );
+        }
+
+        // Result
+        //-------------------------------------------------------------------------
+
+        GraphPoseNodeResult result;
+        if ( hasJumped )
+        {
+            SampleEvents( context, preSearchClipIdx, preSearchPreviousTime, preSearchCurrentTime, result );
+        }
+        else
+        {
+            SampleEvents( context, m_currentClipIdx, m_previousTime, m_currentTime, result );
+        }
+
+        AnimationClip const* pCurrentClip = m_pDatabase->GetClip( m_currentClipIdx );
+        TaskIndex const currentClipTaskIdx = context.m_pTaskSystem->RegisterSampleTask( GetNodeIndex(), pCurrentClip, m_currentTime );
+
+        if ( !m_blendSources.empty() )
+        {
+            // Blend up the stack, from the oldest source to the current clip
+            AnimationClip const* pSourceClip = m_pDatabase->GetClip( m_blendSources[0].m_clipIdx );
+            result.m_taskIdx = context.m_pTaskSystem->RegisterSampleTask( GetNodeIndex(), pSourceClip, m_blendSources[0].m_currentTime );
+
+            if ( pSettings->m_sampleRootMotion )
+            {
+                result.m_rootMotionDelta = pSourceClip->GetRootMotionDeltaNoLooping( m_blendSources[0].m_previousTime, m_blendSources[0].m_currentTime );
+            }
+
+            for ( int32_t i = 1; i < (int32_t) m_blendSources.size(); i++ )
+            {
+                BlendSource const& blendSource = m_blendSources[i];
+                pSourceClip = m_pDatabase->GetClip( blendSource.m_clipIdx );
+                float const blendWeight = GetBlendWeight( blendSource.m_blendInTime );
+
+                TaskIndex const sourceClipTaskIdx = context.m_pTaskSystem->RegisterSampleTask( GetNodeIndex(), pSourceClip, blendSource.m_currentTime );
+                result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::BlendTask>( GetNodeIndex(), result.m_taskIdx, sourceClipTaskIdx, blendWeight );
+
+                if ( pSettings->m_sampleRootMotion )
+                {
+                    Transform const sourceDelta = pSourceClip->GetRootMotionDeltaNoLooping( blendSource.m_previousTime, blendSource.m_currentTime );
+                    result.m_rootMotionDelta = Blender::BlendRootMotionDeltas( result.m_rootMotionDelta, sourceDelta, blendWeight );
+                }
+            }
+
+            // On the frame we jump the blend weight of the current clip is zero so the root motion is that of the clip we jumped from
+            float const blendWeight = GetBlendWeight( m_blendElapsedTime );
+            result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::BlendTask>( GetNodeIndex(), result.m_taskIdx, currentClipTaskIdx, blendWeight );
+
+            if ( pSettings->m_sampleRootMotion )
+            {
+                Transform const targetDelta = pCurrentClip->GetRootMotionDeltaNoLooping( m_previousTime, m_currentTime );
+                result.m_rootMotionDelta = Blender::BlendRootMotionDeltas( result.m_rootMotionDelta, targetDelta, blendWeight );
+            }
+        }
+        else
+        {
+            result.m_taskIdx = currentClipTaskIdx;
+
+            if ( pSettings->m_sampleRootMotion )
+            {
+                if ( hasJumped )
+                {
+                    result.m_rootMotionDelta = m_pDatabase->GetClip( preSearchClipIdx )->GetRootMotionDeltaNoLooping( preSearchPreviousTime, preSearchCurrentTime );
+                }
+                else
+                {
+                    result.m_rootMotionDelta = pCurrentClip->GetRootMotionDeltaNoLooping( m_previousTime, m_currentTime );
+                }
+            }
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        if ( pSettings->m_sampleRootMotion )
+        {
+            context.GetRootMotionDebugger()->RecordSampling( GetNodeIndex(), result.m_rootMotionDelta );
+        }
+        #endif
+
+        return result;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Engine/Animation/Graph/Animation_RuntimeGraph_Node.h"
+#include "Engine/Animation/AnimationMotionDatabase.h"
+
+//-------------------------------------------------------------------------
+// Motion Matching
+//-------------------------------------------------------------------------
+// Plays back frames from a motion database, at a fixed interval the database is searched for the frame that best matches the current pose
+// and the desired trajectory (created from the desired velocity and facing inputs), if a sufficiently better frame is found we cross-fade to it
+
+namespace EE::Animation::GraphNodes
+{
+    class EE_ENGINE_API MotionMatchingNode final : public PoseNode
+    {
+        // Dont jump to frames in the same clip that are this close to the current time
+        constexpr static float const s_sameClipTimeThreshold = 0.2f;
+
+        // The max number of clips we can be blending out of at once, when a jump happens while we are still blending we blend out of the blended result
+        constexpr static int32_t const s_maxBlendSources = 3;
+
+        // The playback state of a clip we are blending out of
+        struct BlendSource
+        {
+            int32_t                                     m_clipIdx = InvalidIndex;
+            Percentage                                  m_previousTime = 0.0f;
+            Percentage                                  m_currentTime = 0.0f;
+            Seconds                                     m_blendInTime = 0.0f;   // How long ago we started blending into this clip
+        };
+
+    public:
+
+        struct EE_ENGINE_API Settings final : public PoseNode::Settings
+        {
+            EE_REGISTER_TYPE( Settings );
+            EE_SERIALIZE_GRAPHNODESETTINGS( PoseNode::Settings, m_desiredVelocityValueNodeIdx, m_desiredFacingValueNodeIdx, m_dataSlotIdx, m_searchInterval, m_blendTime, m_minCostImprovement, m_useAccelerationStructure, m_sampleRootMotion );
+
+            virtual void InstantiateNode( InstantiationContext const& context, InstantiationOptions options ) const override;
+
+            int16_t                                     m_desiredVelocityValueNodeIdx = InvalidIndex;
+            int16_t                                     m_desiredFacingValueNodeIdx = InvalidIndex;
+            int16_t                                     m_dataSlotIdx = InvalidIndex;
+            Seconds                                     m_searchInterval = 0.1f;
+            Seconds                                     m_blendTime = 0.2f;
+            float                                       m_minCostImprovement = 0.1f; // How much cheaper (as a fraction of the current cost) does a match need to be for us to jump to it
+            bool                                        m_useAccelerationStructure = true;
+            bool                                        m_sampleRootMotion = true;
+        };
+
+    public:
+
+        virtual bool IsValid() const override;
+
+        virtual GraphPoseNodeResult Update( GraphContext& context ) override;
+
+        // Motion matching is not synchronizable, the update range is ignored
+        virtual GraphPoseNodeResult Update( GraphContext& context, SyncTrackTimeRange const& updateRange ) override { return Update( context ); }
+
+        virtual SyncTrack const& GetSyncTrack() const override { return SyncTrack::s_defaultTrack; }
+
+    private:
+
+        virtual void InitializeInternal( GraphContext& context, SyncTrackTime const& initialTime ) override;
+        virtual void ShutdownInternal( GraphContext& context ) override;
+
+        void CalculateDesiredTrajectory( GraphContext& context, MotionDatabase::TrajectorySample* pOutTrajectory ) const;
+        // Returns true if we jumped to a new clip/time
+        bool PerformSearch( GraphContext& context, bool forceTransition );
+        void SampleEvents( GraphContext& context, int32_t clipIdx, Percentage previousTime, Percentage currentTime, GraphPoseNodeResult& result ) const;
+
+        inline float GetBlendWeight( Seconds blendInTime ) const
+        {
+            Seconds const blendTime = GetSettings<MotionMatchingNode>()->m_blendTime;
+            return ( blendTime > 0.0f ) ? Math::Clamp( blendInTime.ToFloat() / blendTime.ToFloat(), 0.0f, 1.0f ) : 1.0f;
+        }
+
+    private:
+
+        MotionDatabase const*                           m_pDatabase = nullptr;
+        VectorValueNode*                                m_pDesiredVelocityValueNode = nullptr;
+        VectorValueNode*                                m_pDesiredFacingValueNode = nullptr;
+        TVector<float>                                  m_query;
+
+        int32_t                                         m_currentClipIdx = InvalidIndex;
+        Seconds                                         m_blendElapsedTime = 0.0f;              // How long ago we started blending into the current clip
+        TInlineVector<BlendSource, s_maxBlendSources>   m_blendSources;                         // Ordered from the oldest to the most recent
+        Seconds                                         m_timeSinceLastSearch = 0.0f;
+    };
+}
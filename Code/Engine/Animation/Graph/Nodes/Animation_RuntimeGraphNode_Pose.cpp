@@ -105,7 +105,7 @@ namespace EE::Animation::GraphNodes
         //-------------------------------------------------------------------------
 
         result.m_sampledEventRange = SampledEventRange( context.m_sampledEventsBuffer.GetNumEvents() );
-        result.m_taskIdx = context.m_pTaskSystem->RegisterTask<Tasks::SampleTask>( GetNodeIndex(), m_pAnimation, m_currentTime );
+        result.m_taskIdx = context.m_pTaskSystem->RegisterSampleTask( GetNodeIndex(), m_pAnimation, m_currentTime );
         return result;
     }
 
@@ -691,6 +691,9 @@ namespace EE::Animation::GraphNodes
             WarpTranslationFeaturePreserving( warpSection, finalWarpTarget );
         }
 
+        // The warped transforms have been written directly so we need to update the delta lookups
+        m_warpedRootMotion.UpdateLookupTables();
+
         return true;
     }
 
@@ -7,7 +7,7 @@
 
 namespace EE::Animation
 {
-    class BoneMaskLoader final : public Resource::ResourceLoader
+    class EE_ENGINE_API BoneMaskLoader final : public Resource::ResourceLoader
     {
     public:
 
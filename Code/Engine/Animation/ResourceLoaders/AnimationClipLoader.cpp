@@ -24,6 +24,7 @@ namespace EE::Animation
 
         auto pAnimation = EE::New<AnimationClip>();
         archive << *pAnimation;
+        pAnimation->m_rootMotion.Decompress();
         pResourceRecord->SetResourceData( pAnimation );
 
         // Read sync events
@@ -41,6 +42,7 @@ namespace EE::Animation
 
         collectionDesc.CalculateCollectionRequirements( *m_pTypeRegistry );
         TypeSystem::TypeDescriptorCollection::InstantiateStaticCollection( *m_pTypeRegistry, collectionDesc, pAnimation->m_events );
+        EE_ASSERT( pAnimation->m_eventStartTimes.size() == pAnimation->m_events.size() );
 
         return true;
     }
@@ -11,7 +11,7 @@ namespace EE::TypeSystem { class TypeRegistry; }
 
 namespace EE::Animation
 {
-    class GraphLoader final : public Resource::ResourceLoader
+    class EE_ENGINE_API GraphLoader final : public Resource::ResourceLoader
     {
     public:
 
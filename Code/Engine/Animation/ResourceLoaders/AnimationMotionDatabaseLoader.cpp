@@ -0,0 +1,40 @@
+#include "AnimationMotionDatabaseLoader.h"
+#include "Engine/Animation/AnimationMotionDatabase.h"
+#include "System/Serialization/BinarySerialization.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    MotionDatabaseLoader::MotionDatabaseLoader()
+    {
+        m_loadableTypes.push_back( MotionDatabase::GetStaticResourceTypeID() );
+    }
+
+    bool MotionDatabaseLoader::LoadInternal( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    {
+        MotionDatabase* pDatabase = EE::New<MotionDatabase>();
+        archive << *pDatabase;
+        pResourceRecord->SetResourceData( pDatabase );
+        return true;
+    }
+
+    Resource::InstallResult MotionDatabaseLoader::Install( ResourceID const& resID, Resource::ResourceRecord* pResourceRecord, Resource::InstallDependencyList const& installDependencies ) const
+    {
+        auto pDatabase = pResourceRecord->GetResourceData<MotionDatabase>();
+        EE_ASSERT( pDatabase->m_skeleton.GetResourceID().IsValid() );
+
+        pDatabase->m_skeleton = GetInstallDependency( installDependencies, pDatabase->m_skeleton.GetResourceID() );
+
+        for ( auto& clip : pDatabase->m_clips )
+        {
+            EE_ASSERT( clip.GetResourceID().IsValid() );
+            clip = GetInstallDependency( installDependencies, clip.GetResourceID() );
+        }
+
+        EE_ASSERT( pDatabase->IsValid() );
+
+        ResourceLoader::Install( resID, pResourceRecord, installDependencies );
+        return Resource::InstallResult::Succeeded;
+    }
+}
@@ -17,22 +17,7 @@ namespace EE::Animation
         archive << *pSkeleton;
         EE_ASSERT( pSkeleton->IsValid() );
         pResourceRecord->SetResourceData( pSkeleton );
-
-        // Calculate global reference pose
-        //-------------------------------------------------------------------------
-
-        int32_t const numBones = pSkeleton->GetNumBones();
-        pSkeleton->m_globalReferencePose.resize( numBones );
-
-        pSkeleton->m_globalReferencePose[0] = pSkeleton->m_localReferencePose[0];
-        for ( auto boneIdx = 1; boneIdx < numBones; boneIdx++ )
-        {
-            int32_t const parentIdx = pSkeleton->GetParentBoneIndex( boneIdx );
-            pSkeleton->m_globalReferencePose[boneIdx] = pSkeleton->m_localReferencePose[boneIdx] * pSkeleton->m_globalReferencePose[parentIdx];
-        }
-
-        //-------------------------------------------------------------------------
-
+        pSkeleton->CalculateGlobalReferencePose();
         return true;
     }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace EE::Animation
 {
-    class SkeletonLoader final : public Resource::ResourceLoader
+    class EE_ENGINE_API SkeletonLoader final : public Resource::ResourceLoader
     {
     public:
 
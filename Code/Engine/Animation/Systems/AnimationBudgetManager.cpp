@@ -0,0 +1,163 @@
+#include "AnimationBudgetManager.h"
+#include "Engine/Animation/Components/Component_AnimationGraph.h"
+#include "System/IniFile.h"
+#include "System/Profiling.h"
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    static AnimationBudgetManager::Settings g_defaultSettings;
+
+    //-------------------------------------------------------------------------
+
+    void AnimationBudgetManager::Settings::ReadSettings( IniFile const& ini )
+    {
+        float frameBudget = 0.0f;
+        if ( ini.TryGetFloat( "Animation:GraphUpdateBudgetMS", frameBudget ) )
+        {
+            m_frameBudget = Math::Max( frameBudget, 0.0f );
+        }
+
+        float fullRateDistance = 0.0f;
+        if ( ini.TryGetFloat( "Animation:FullUpdateRateDistance", fullRateDistance ) )
+        {
+            m_fullRateDistance = Math::Max( fullRateDistance, 0.0f );
+        }
+
+        uint32_t maxUpdatePeriod = 0;
+        if ( ini.TryGetUInt( "Animation:MaxUpdatePeriod", maxUpdatePeriod ) )
+        {
+            m_maxUpdatePeriod = (uint8_t) Math::Clamp( maxUpdatePeriod, 1u, (uint32_t) s_maxSupportedUpdatePeriod );
+        }
+
+        uint32_t offscreenUpdatePeriod = 0;
+        if ( ini.TryGetUInt( "Animation:OffscreenUpdatePeriod", offscreenUpdatePeriod ) )
+        {
+            m_offscreenMinUpdatePeriod = (uint8_t) Math::Clamp( offscreenUpdatePeriod, 1u, (uint32_t) s_maxSupportedUpdatePeriod );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AnimationBudgetManager::SetDefaultSettings( Settings const& settings )
+    {
+        EE_ASSERT( settings.m_frameBudget >= 0.0f );
+        EE_ASSERT( settings.m_maxUpdatePeriod >= 1 && settings.m_maxUpdatePeriod <= s_maxSupportedUpdatePeriod );
+        EE_ASSERT( settings.m_offscreenMinUpdatePeriod >= 1 );
+        EE_ASSERT( settings.m_offscreenDistanceScale >= 1.0f );
+        g_defaultSettings = settings;
+    }
+
+    AnimationBudgetManager::AnimationBudgetManager()
+        : m_settings( g_defaultSettings )
+    {}
+
+    void AnimationBudgetManager::SetSettings( Settings const& settings )
+    {
+        EE_ASSERT( settings.m_frameBudget >= 0.0f );
+        EE_ASSERT( settings.m_maxUpdatePeriod >= 1 && settings.m_maxUpdatePeriod <= s_maxSupportedUpdatePeriod );
+        EE_ASSERT( settings.m_offscreenMinUpdatePeriod >= 1 );
+        EE_ASSERT( settings.m_offscreenDistanceScale >= 1.0f );
+        m_settings = settings;
+    }
+
+    void AnimationBudgetManager::Update( TVector<AnimationGraphComponent*> const& graphComponents )
+    {
+        EE_PROFILE_SCOPE_ANIMATION( "Animation Budget Manager" );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_estimatedFrameCost = 0.0f;
+        m_numThrottledComponents = 0;
+        #endif
+
+        // Gather all budgeted components
+        //-------------------------------------------------------------------------
+
+        m_sortedComponents.clear();
+
+        for ( auto pComponent : graphComponents )
+        {
+            if ( !pComponent->HasGraphInstance() || pComponent->RequiresManualUpdate() )
+            {
+                continue;
+            }
+
+            if ( !m_settings.m_isEnabled )
+            {
+                pComponent->SetUpdateRate( 1, 0 );
+                continue;
+            }
+
+            auto& info = m_sortedComponents.emplace_back();
+            info.m_pComponent = pComponent;
+            info.m_significance = pComponent->GetDistanceFromViewer() * ( pComponent->IsVisibleToViewer() ? 1.0f : m_settings.m_offscreenDistanceScale );
+            info.m_estimatedCost = pComponent->GetAverageEvaluationCost();
+        }
+
+        if ( m_sortedComponents.empty() )
+        {
+            return;
+        }
+
+        eastl::sort( m_sortedComponents.begin(), m_sortedComponents.end(), [] ( ComponentInfo const& a, ComponentInfo const& b ) { return a.m_significance < b.m_significance; } );
+
+        // Calculate the minimum cost of all the less significant components, this is reserved so that every component can always be updated at the max period
+        //-------------------------------------------------------------------------
+
+        float const maxPeriod = float( m_settings.m_maxUpdatePeriod );
+        float reservedCost = 0.0f;
+        for ( auto const& info : m_sortedComponents )
+        {
+            reservedCost += info.m_estimatedCost / maxPeriod;
+        }
+
+        // Assign update rates in order of significance
+        //-------------------------------------------------------------------------
+
+        float remainingBudget = m_settings.m_frameBudget;
+
+        for ( auto const& info : m_sortedComponents )
+        {
+            AnimationGraphComponent* pComponent = info.m_pComponent;
+            bool const isVisible = pComponent->IsVisibleToViewer();
+            float const cost = info.m_estimatedCost;
+            reservedCost -= cost / maxPeriod;
+
+            uint8_t period = 1;
+            if ( !isVisible )
+            {
+                period = Math::Min( m_settings.m_offscreenMinUpdatePeriod, m_settings.m_maxUpdatePeriod );
+            }
+
+            // Visible characters that are close to the viewer are never throttled, and nothing is throttled to fit an unlimited budget
+            bool const hasBudget = m_settings.m_frameBudget > 0.0f;
+            if ( hasBudget && ( !isVisible || pComponent->GetDistanceFromViewer() > m_settings.m_fullRateDistance ) )
+            {
+                float const availableBudget = Math::Max( remainingBudget - reservedCost, 0.0f );
+                while ( period < m_settings.m_maxUpdatePeriod && ( cost / period ) > availableBudget )
+                {
+                    period++;
+                }
+            }
+
+            remainingBudget -= cost / period;
+
+            // Only re-assign the phase when the period changes, so that components dont jump between update slots every frame
+            uint8_t phase = pComponent->GetUpdatePhase();
+            if ( period != pComponent->GetUpdatePeriod() )
+            {
+                phase = m_phaseCounters[period];
+                m_phaseCounters[period] = ( m_phaseCounters[period] + 1 ) % period;
+            }
+
+            pComponent->SetUpdateRate( period, phase );
+
+            #if EE_DEVELOPMENT_TOOLS
+            m_estimatedFrameCost += cost / period;
+            m_numThrottledComponents += ( period > 1 ) ? 1 : 0;
+            #endif
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "System/Time/Time.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Animation Budget Manager
+//-------------------------------------------------------------------------
+// Distributes a global per-frame time budget across all the animation graph components in a world
+// Components are sorted by significance (distance from the viewer with off-screen characters treated as further away)
+// The most significant components are updated every frame, less significant ones get progressively reduced update rates until the estimated cost fits the budget
+// Components sharing the same update period are staggered across frames so that the cost is evenly distributed
+//
+// The budget is unlimited and off-screen throttling is disabled by default, both are set via the [Animation] section of the ini file
+
+namespace EE { class IniFile; }
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    class AnimationGraphComponent;
+
+    //-------------------------------------------------------------------------
+
+    class EE_ENGINE_API AnimationBudgetManager
+    {
+    public:
+
+        constexpr static uint8_t const s_maxSupportedUpdatePeriod = 16;
+
+        struct EE_ENGINE_API Settings
+        {
+            // Read the settings from the ini file, any settings that are not present keep their default values
+            void ReadSettings( IniFile const& ini );
+
+            Milliseconds                        m_frameBudget = 0.0f;               // The total time we are allowed to spend evaluating graphs per frame, zero means unlimited
+            float                               m_fullRateDistance = 10.0f;         // Visible characters closer than this distance (in meters) will always be updated every frame
+            float                               m_offscreenDistanceScale = 4.0f;    // Off-screen characters are treated as being this many times further away when calculating significance
+            uint8_t                             m_maxUpdatePeriod = 8;              // The max number of frames between two graph evaluations
+            uint8_t                             m_offscreenMinUpdatePeriod = 1;     // Off-screen characters will be updated at most every N frames, one means off-screen characters are not throttled
+            bool                                m_isEnabled = true;
+        };
+
+    private:
+
+        struct ComponentInfo
+        {
+            AnimationGraphComponent*            m_pComponent = nullptr;
+            float                               m_significance = 0.0f;
+            Milliseconds                        m_estimatedCost = 0.0f;
+        };
+
+    public:
+
+        // Set the settings that all newly created budget managers use, this is set once at startup from the ini file
+        static void SetDefaultSettings( Settings const& settings );
+
+        AnimationBudgetManager();
+
+        inline Settings const& GetSettings() const { return m_settings; }
+        void SetSettings( Settings const& settings );
+
+        // Assign update periods and phases for the next frame, needs to be called once per frame after all the graphs have been evaluated
+        void Update( TVector<AnimationGraphComponent*> const& graphComponents );
+
+        #if EE_DEVELOPMENT_TOOLS
+        inline Milliseconds GetEstimatedFrameCost() const { return m_estimatedFrameCost; }
+        inline int32_t GetNumThrottledComponents() const { return m_numThrottledComponents; }
+        #endif
+
+    private:
+
+        Settings                                m_settings;
+        TVector<ComponentInfo>                  m_sortedComponents;
+        uint8_t                                 m_phaseCounters[s_maxSupportedUpdatePeriod + 1] = { 0 };
+
+        #if EE_DEVELOPMENT_TOOLS
+        Milliseconds                            m_estimatedFrameCost = 0.0f;
+        int32_t                                 m_numThrottledComponents = 0;
+        #endif
+    };
+}
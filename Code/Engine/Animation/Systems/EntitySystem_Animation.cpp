@@ -4,7 +4,9 @@
 #include "Engine/Render/Components/Component_SkeletalMesh.h"
 #include "Engine/Physics/Systems/WorldSystem_Physics.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
+#include "Engine/Render/RenderViewport.h"
 #include "Engine/Animation/AnimationPose.h"
+#include "System/Threading/TaskSystem.h"
 #include "System/Profiling.h"
 #include "System/Log.h"
 
@@ -171,6 +173,7 @@ namespace EE::Animation
         if ( updateStage == UpdateStage::PrePhysics )
         {
             auto pPhysicsWorldSystem = ctx.GetWorldSystem<Physics::PhysicsWorldSystem>();
+            Render::Viewport const* pViewport = ctx.GetViewport();
 
             for ( auto pAnimComponent : m_animGraphs )
             {
@@ -179,10 +182,27 @@ namespace EE::Animation
                     continue;
                 }
 
+                // Select the LOD to evaluate the pose tasks at and update the info needed to budget the update rate
+                if ( pViewport != nullptr )
+                {
+                    float const distanceFromViewer = pViewport->GetViewPosition().GetDistance3( characterWorldTransform.GetTranslation() );
+                    pAnimComponent->UpdateSkeletonLOD( distanceFromViewer );
+                    pAnimComponent->SetViewerInfo( distanceFromViewer, pViewport->IsWorldSpacePointVisible( characterWorldTransform.GetTranslation() ) );
+                }
+
                 if ( !pAnimComponent->RequiresManualUpdate() )
                 {
-                    // Evaluate the graph nodes and calculate the root motion delta
-                    pAnimComponent->EvaluateGraph( ctx.GetDeltaTime(), characterWorldTransform, pPhysicsWorldSystem->GetScene() );
+                    // Throttled graphs only present an interpolated pose and apply a portion of their last root motion delta
+                    bool const shouldEvaluateGraph = pAnimComponent->ShouldEvaluateGraph( ctx.GetFrameID() );
+                    if ( shouldEvaluateGraph )
+                    {
+                        // Evaluate the graph nodes and calculate the root motion delta
+                        pAnimComponent->EvaluateGraph( ctx.GetDeltaTime(), characterWorldTransform, pPhysicsWorldSystem->GetScene() );
+                    }
+                    else
+                    {
+                        pAnimComponent->SkipGraphEvaluation( ctx.GetDeltaTime() );
+                    }
 
                     // Apply the root motion if desired
                     Transform adjustedCharacterTransform = characterWorldTransform;
@@ -198,7 +218,10 @@ namespace EE::Animation
                     }
 
                     // Calculate pose tasks
-                    pAnimComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), adjustedCharacterTransform );
+                    if ( shouldEvaluateGraph )
+                    {
+                        pAnimComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), adjustedCharacterTransform, ctx.GetSystem<EE::TaskSystem>() );
+                    }
                 }
             }
         }
@@ -212,9 +235,9 @@ namespace EE::Animation
                 }
 
                 // Calculate the final pose tasks
-                if ( !pAnimComponent->RequiresManualUpdate() )
+                if ( !pAnimComponent->RequiresManualUpdate() && pAnimComponent->WasGraphEvaluated() )
                 {
-                    pAnimComponent->ExecutePostPhysicsTasks();
+                    pAnimComponent->ExecutePostPhysicsTasks( ctx.GetSystem<EE::TaskSystem>() );
                 }
 
                 // Set poses
@@ -2,6 +2,7 @@
 #include "Engine/Animation/Components/Component_AnimationGraph.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
 #include "System/Drawing/DebugDrawing.h"
+#include "System/Threading/TaskSystem.h"
 
 //-------------------------------------------------------------------------
 
@@ -10,6 +11,7 @@ namespace EE::Animation
     void AnimationWorldSystem::ShutdownSystem()
     {
         EE_ASSERT( m_graphComponents.empty() );
+        EE_ASSERT( m_sampleBatch.IsEmpty() );
     }
 
     void AnimationWorldSystem::RegisterComponent( Entity const* pEntity, EntityComponent* pComponent )
@@ -17,6 +19,11 @@ namespace EE::Animation
         if ( auto pGraphComponent = TryCast<AnimationGraphComponent>( pComponent ) )
         {
             m_graphComponents.Add( pGraphComponent );
+
+            if ( pGraphComponent->HasGraphInstance() )
+            {
+                pGraphComponent->SetSampleBatch( &m_sampleBatch );
+            }
         }
     }
 
@@ -24,12 +31,31 @@ namespace EE::Animation
     {
         if ( auto pGraphComponent = TryCast<AnimationGraphComponent>( pComponent ) )
         {
+            if ( pGraphComponent->HasGraphInstance() )
+            {
+                pGraphComponent->SetSampleBatch( nullptr );
+            }
+
             m_graphComponents.Remove( pGraphComponent->GetID() );
         }
     }
 
     void AnimationWorldSystem::UpdateSystem( EntityWorldUpdateContext const& ctx )
     {
+        // Sample the poses for all the graphs that were evaluated this frame, their remaining pose tasks will run in the post-physics update
+        if ( ctx.GetUpdateStage() == UpdateStage::PrePhysics )
+        {
+            m_sampleBatch.Execute( ctx.GetSystem<EE::TaskSystem>() );
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Calculate the graph update rates for the next frame
+        m_budgetManager.Update( m_graphComponents.GetVector() );
+
+        //-------------------------------------------------------------------------
+
         #if EE_DEVELOPMENT_TOOLS
         Drawing::DrawContext drawingCtx = ctx.GetDrawingContext();
         for ( auto pComponent : m_graphComponents )
@@ -2,6 +2,8 @@
 
 #include "Engine/_Module/API.h"
 #include "Engine/Entity/EntityWorldSystem.h"
+#include "AnimationBudgetManager.h"
+#include "Engine/Animation/TaskSystem/Animation_TaskSampleBatch.h"
 #include "System/Types/IDVector.h"
 
 //-------------------------------------------------------------------------
@@ -18,12 +20,16 @@ namespace EE::Animation
 
     public:
 
-        EE_REGISTER_ENTITY_WORLD_SYSTEM( AnimationWorldSystem, RequiresUpdate( UpdateStage::FrameEnd ) );
+        EE_REGISTER_ENTITY_WORLD_SYSTEM( AnimationWorldSystem, RequiresUpdate( UpdateStage::PrePhysics ), RequiresUpdate( UpdateStage::FrameEnd ) );
 
         #if EE_DEVELOPMENT_TOOLS
         inline TVector<AnimationGraphComponent*> const& GetRegisteredGraphComponents() const { return m_graphComponents.GetVector(); }
         #endif
 
+        // Get the budget manager controlling the graph update rates
+        inline AnimationBudgetManager& GetBudgetManager() { return m_budgetManager; }
+        inline AnimationBudgetManager const& GetBudgetManager() const { return m_budgetManager; }
+
     private:
 
         virtual void ShutdownSystem() override final;
@@ -34,5 +40,7 @@ namespace EE::Animation
     private:
 
         TIDVector<ComponentID, AnimationGraphComponent*>          m_graphComponents;
+        AnimationBudgetManager                                    m_budgetManager;
+        SampleTaskBatch                                           m_sampleBatch;
     };
 } 
\ No newline at end of file
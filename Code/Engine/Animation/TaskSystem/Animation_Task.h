@@ -2,12 +2,14 @@
 
 #include "Animation_TaskPosePool.h"
 #include "System/Types/Color.h"
+#include "System/Time/Time.h"
 
 //-------------------------------------------------------------------------
 
 namespace EE::Animation
 {
     class Task;
+    class SampleTaskBatch;
 
     //-------------------------------------------------------------------------
 
@@ -37,6 +39,9 @@ namespace EE::Animation
         TInlineVector<Task*, 2>         m_dependencies = { nullptr, nullptr };
         float                           m_deltaTime = 0;
         TaskUpdateStage                 m_updateStage = TaskUpdateStage::Any;
+        Skeleton::LOD                   m_skeletonLOD = Skeleton::LOD::High;
+        SampleTaskBatch*                m_pSampleBatch = nullptr; // If set, sample tasks will be deferred to this batch instead of being executed immediately
+        Milliseconds*                   m_pSampleBatchCost = nullptr; // The time spent by the batch sampling the deferred tasks is added to this
         PoseBufferPool&                 m_posePool;
     };
 
@@ -44,6 +49,7 @@ namespace EE::Animation
 
     class Task
     {
+        friend class TaskSystem;
 
     public:
 
@@ -57,6 +63,9 @@ namespace EE::Animation
         inline TaskDependencies const& GetDependencyIndices() const { return m_dependencies; }
         inline int32_t GetNumDependencies() const { return (int32_t) m_dependencies.size(); }
 
+        // Is this task's result shared by more than one of the tasks that still need to run?
+        inline bool HasSharedResult() const { return m_numPendingConsumers > 1; }
+
         // Get the stage that this task is required to run in
         inline TaskUpdateStage GetRequiredUpdateStage() const { return m_updateStage; }
 
@@ -66,6 +75,10 @@ namespace EE::Animation
         // Do we have a dependency on the physics simulation?
         inline bool	HasPhysicsDependency() const { return m_updateStage != TaskUpdateStage::Any; }
 
+        // Can this task be executed on a worker thread concurrently with other independent tasks?
+        // Tasks that touch state shared outside of their dependency chain (cached poses, physics objects) need to return false
+        virtual bool SupportsParallelExecution() const { return true; }
+
         #if EE_DEVELOPMENT_TOOLS
         virtual String GetDebugText() const { return String(); }
         virtual Color GetDebugColor() const { return Colors::White; }
@@ -95,6 +108,17 @@ namespace EE::Animation
             auto pDependencyTask = context.m_dependencies[dependencyIdx];
             EE_ASSERT( pDependencyTask != nullptr && pDependencyTask->m_isComplete && pDependencyTask->m_bufferIdx != InvalidIndex );
 
+            // Other tasks still need the shared result, so we need to work on a copy
+            if ( pDependencyTask->HasSharedResult() )
+            {
+                pDependencyTask->m_numPendingConsumers--;
+                m_bufferIdx = context.m_posePool.RequestPoseBuffer();
+                PoseBuffer* pBuffer = context.m_posePool.GetBuffer( m_bufferIdx );
+                pBuffer->CopyFrom( context.m_posePool.GetBuffer( pDependencyTask->m_bufferIdx ) );
+                return pBuffer;
+            }
+
+            pDependencyTask->m_numPendingConsumers = 0;
             m_bufferIdx = pDependencyTask->m_bufferIdx;
             pDependencyTask->m_bufferIdx = InvalidIndex;
             return context.m_posePool.GetBuffer( m_bufferIdx );
@@ -113,6 +137,15 @@ namespace EE::Animation
         {
             auto pDependencyTask = context.m_dependencies[dependencyIdx];
             EE_ASSERT( pDependencyTask != nullptr && pDependencyTask->m_isComplete && pDependencyTask->m_bufferIdx != InvalidIndex );
+
+            // Shared results are only released by their last consumer
+            if ( pDependencyTask->HasSharedResult() )
+            {
+                pDependencyTask->m_numPendingConsumers--;
+                return;
+            }
+
+            pDependencyTask->m_numPendingConsumers = 0;
             pDependencyTask->ReleasePoseBuffer( context );
         }
 
@@ -155,6 +188,7 @@ namespace EE::Animation
         int8_t                          m_bufferIdx = InvalidIndex;
         TaskDependencies                m_dependencies;
         TaskUpdateStage                 m_actualUpdateStage = TaskUpdateStage::Any;
+        int8_t                          m_numPendingConsumers = 0; // The number of registered tasks that depend on this task's result and have not consumed it yet
         bool                            m_isComplete = false;
     };
 }
@@ -4,8 +4,8 @@
 
 namespace EE::Animation
 {
-    PoseBuffer::PoseBuffer( Skeleton const* pSkeleton )
-        : m_pose( pSkeleton )
+    PoseBuffer::PoseBuffer( Skeleton const* pSkeleton, void* pMemory )
+        : m_pose( pSkeleton, pMemory )
     {}
 
     void PoseBuffer::Reset()
@@ -27,20 +27,85 @@ namespace EE::Animation
     {
         EE_ASSERT( m_pSkeleton != nullptr );
 
-        for ( auto i = 0; i < s_numInitialBuffers; i++ )
-        {
-            m_poseBuffers.emplace_back( PoseBuffer( m_pSkeleton ) );
-            m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pSkeleton ) );
+        // Round up the per-pose memory so that every pose in a block starts on an aligned address
+        m_poseMemorySize = Math::RoundUpToNearestMultiple32( (uint32_t) Pose::GetRequiredMemorySize( m_pSkeleton ), (uint32_t) s_arenaAlignment );
 
-            #if EE_DEVELOPMENT_TOOLS
-            m_debugBuffers.emplace_back( PoseBuffer( m_pSkeleton ) );
-            #endif
-        }
+        // Create all the initial buffers from a single contiguous block
+        #if EE_DEVELOPMENT_TOOLS
+        int32_t const numInitialPoses = s_numInitialBuffers * 3;
+        #else
+        int32_t const numInitialPoses = s_numInitialBuffers * 2;
+        #endif
+
+        uint8_t* pMemory = AllocateArenaBlock( numInitialPoses );
+        pMemory = CreateBuffers( m_poseBuffers, s_numInitialBuffers, pMemory );
+        pMemory = CreateBuffers( m_cachedBuffers, s_numInitialBuffers, pMemory );
+
+        #if EE_DEVELOPMENT_TOOLS
+        pMemory = CreateBuffers( m_debugBuffers, s_numInitialBuffers, pMemory );
+        #endif
     }
 
     PoseBufferPool::~PoseBufferPool()
     {
         Reset();
+
+        // The buffers need to be destroyed before releasing the memory they reference
+        m_poseBuffers.clear();
+        m_cachedBuffers.clear();
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_debugBuffers.clear();
+        #endif
+
+        for ( auto& pArenaBlock : m_arenaBlocks )
+        {
+            EE::Free( pArenaBlock );
+        }
+    }
+
+    uint8_t* PoseBufferPool::AllocateArenaBlock( int32_t numPoses )
+    {
+        EE_ASSERT( !m_isParallelAccessEnabled && numPoses > 0 );
+
+        size_t const blockSize = m_poseMemorySize * numPoses;
+        auto pArenaBlock = (uint8_t*) EE::Alloc( blockSize, s_arenaAlignment );
+        m_arenaBlocks.emplace_back( pArenaBlock );
+        m_arenaSize += blockSize;
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_numHeapAllocations++;
+        m_numHeapAllocationsThisFrame++;
+        #endif
+
+        return pArenaBlock;
+    }
+
+    template<typename T>
+    uint8_t* PoseBufferPool::CreateBuffers( TVector<T>& buffers, int32_t numBuffers, uint8_t* pMemory )
+    {
+        #if EE_DEVELOPMENT_TOOLS
+        if ( buffers.capacity() < buffers.size() + numBuffers )
+        {
+            m_numHeapAllocations++;
+            m_numHeapAllocationsThisFrame++;
+        }
+        #endif
+
+        buffers.reserve( buffers.size() + numBuffers );
+        for ( auto i = 0; i < numBuffers; i++ )
+        {
+            buffers.emplace_back( T( m_pSkeleton, pMemory ) );
+            pMemory += m_poseMemorySize;
+        }
+
+        return pMemory;
+    }
+
+    template<typename T>
+    void PoseBufferPool::GrowBuffers( TVector<T>& buffers, int32_t numBuffers )
+    {
+        CreateBuffers( buffers, numBuffers, AllocateArenaBlock( numBuffers ) );
     }
 
     void PoseBufferPool::Reset()
@@ -69,17 +134,23 @@ namespace EE::Animation
         // Dont reset the actual debug buffers as we want to still access them this frame, only reset the free index
         #if EE_DEVELOPMENT_TOOLS
         m_firstFreeDebugBuffer = 0;
+        m_numHeapAllocationsLastFrame = m_numHeapAllocationsThisFrame;
+        m_numHeapAllocationsThisFrame = 0;
         #endif
     }
 
     int8_t PoseBufferPool::RequestPoseBuffer()
     {
+        Threading::Lock lock( m_mutex, std::defer_lock );
+        if ( m_isParallelAccessEnabled )
+        {
+            lock.lock();
+        }
+
         if ( m_firstFreeBuffer == m_poseBuffers.size() )
         {
-            for ( auto i = 0; i < s_bufferGrowAmount; i++ )
-            {
-                m_poseBuffers.emplace_back( PoseBuffer( m_pSkeleton ) );
-            }
+            EE_ASSERT( !m_isParallelAccessEnabled );
+            GrowBuffers( m_poseBuffers, s_bufferGrowAmount );
             EE_ASSERT( m_poseBuffers.size() < 255 );
         }
 
@@ -102,22 +173,52 @@ namespace EE::Animation
 
     void PoseBufferPool::ReleasePoseBuffer( int8_t BufferIdx )
     {
+        Threading::Lock lock( m_mutex, std::defer_lock );
+        if ( m_isParallelAccessEnabled )
+        {
+            lock.lock();
+        }
+
         EE_ASSERT( m_poseBuffers[BufferIdx].m_isUsed );
         m_poseBuffers[BufferIdx].m_isUsed = false;
         m_firstFreeBuffer = Math::Min( BufferIdx, m_firstFreeBuffer );
     }
 
+    void PoseBufferPool::BeginParallelAccess( int32_t numRequiredFreeBuffers )
+    {
+        EE_ASSERT( !m_isParallelAccessEnabled && numRequiredFreeBuffers >= 0 );
+
+        int32_t numFreeBuffers = 0;
+        for ( auto const& poseBuffer : m_poseBuffers )
+        {
+            numFreeBuffers += poseBuffer.m_isUsed ? 0 : 1;
+        }
+
+        // Grow the pool up front since no allocations are allowed once parallel access is enabled
+        while ( numFreeBuffers < numRequiredFreeBuffers )
+        {
+            GrowBuffers( m_poseBuffers, s_bufferGrowAmount );
+            numFreeBuffers += s_bufferGrowAmount;
+            EE_ASSERT( m_poseBuffers.size() < 128 );
+        }
+
+        m_isParallelAccessEnabled = true;
+    }
+
+    void PoseBufferPool::EndParallelAccess()
+    {
+        EE_ASSERT( m_isParallelAccessEnabled );
+        m_isParallelAccessEnabled = false;
+    }
+
     UUID PoseBufferPool::CreateCachedPoseBuffer()
     {
         CachedPoseBuffer* pCachedPoseBuffer = nullptr;
 
         if ( m_firstFreeCachedBuffer == m_cachedBuffers.size() )
         {
-            for ( auto i = 0; i < s_bufferGrowAmount; i++ )
-            {
-                pCachedPoseBuffer = &m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pSkeleton ) );
-            }
-
+            GrowBuffers( m_cachedBuffers, s_bufferGrowAmount );
+            pCachedPoseBuffer = &m_cachedBuffers[m_firstFreeCachedBuffer];
             EE_ASSERT( m_cachedBuffers.size() < 255 );
         }
         else
@@ -195,11 +296,7 @@ namespace EE::Animation
         // If we are out of buffers, add additional debug buffers
         if ( m_firstFreeDebugBuffer == m_debugBuffers.size() )
         {
-            for ( auto i = 0; i < s_bufferGrowAmount; i++ )
-            {
-                m_debugBuffers.emplace_back( PoseBuffer( m_pSkeleton ) );
-            }
-
+            GrowBuffers( m_debugBuffers, s_bufferGrowAmount );
             EE_ASSERT( m_debugBuffers.size() < 255 );
         }
 
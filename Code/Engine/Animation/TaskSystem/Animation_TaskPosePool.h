@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Animation/AnimationPose.h"
+#include "System/Threading/Threading.h"
 
 //-------------------------------------------------------------------------
 
@@ -12,7 +13,7 @@ namespace EE::Animation
 
     public:
 
-        PoseBuffer( Skeleton const* pSkeleton );
+        PoseBuffer( Skeleton const* pSkeleton, void* pMemory );
         void Reset();
 
         void CopyFrom( PoseBuffer const& RHS );
@@ -52,10 +53,14 @@ namespace EE::Animation
 
     //-------------------------------------------------------------------------
 
+    // All pose transforms are stored in arena blocks owned by the pool, the initial buffers all share a single contiguous block
+    // Growing the pool allocates an additional block, so once the pool has reached its working size no more heap allocations occur
+
     class PoseBufferPool
     {
         constexpr static int8_t const s_numInitialBuffers = 6;
         constexpr static int8_t const s_bufferGrowAmount = 3;
+        constexpr static size_t const s_arenaAlignment = 32;
 
     public:
 
@@ -70,6 +75,14 @@ namespace EE::Animation
         int8_t RequestPoseBuffer();
         void ReleasePoseBuffer( int8_t bufferIdx );
 
+        // Parallel Access
+        //-------------------------------------------------------------------------
+        // While enabled, buffer requests and releases are threadsafe. The pool cannot grow while in this mode, since tasks hold pointers to the buffers,
+        // so we need to ensure that we have enough free buffers for all the tasks that will run before enabling it
+
+        void BeginParallelAccess( int32_t numRequiredFreeBuffers );
+        void EndParallelAccess();
+
         inline PoseBuffer* GetBuffer( int8_t bufferIdx )
         {
             EE_ASSERT( m_poseBuffers[bufferIdx].m_isUsed );
@@ -87,6 +100,11 @@ namespace EE::Animation
         //-------------------------------------------------------------------------
 
         #if EE_DEVELOPMENT_TOOLS
+        inline int32_t GetNumBuffers() const { return (int32_t) ( m_poseBuffers.size() + m_cachedBuffers.size() + m_debugBuffers.size() ); }
+        inline size_t GetArenaSize() const { return m_arenaSize; }
+        inline uint32_t GetNumHeapAllocations() const { return m_numHeapAllocations; }
+        inline uint32_t GetNumHeapAllocationsLastFrame() const { return m_numHeapAllocationsLastFrame; }
+
         inline bool IsRecordingEnabled() const { return m_isDebugRecordingEnabled; }
         inline void EnableRecording( bool enabled ) const { m_isDebugRecordingEnabled = enabled; }
         inline bool HasRecordedData() const { return m_firstFreeDebugBuffer != 0; }
@@ -94,19 +112,40 @@ namespace EE::Animation
         PoseBuffer const* GetRecordedPose( int8_t debugBufferIdx ) const;
         #endif
 
+    private:
+
+        // Allocate a new arena block big enough for the specified number of poses
+        uint8_t* AllocateArenaBlock( int32_t numPoses );
+
+        // Create buffers using the arena memory starting at 'pMemory', returns the end of the memory used
+        template<typename T>
+        uint8_t* CreateBuffers( TVector<T>& buffers, int32_t numBuffers, uint8_t* pMemory );
+
+        // Add additional buffers to a set, this allocates a new arena block
+        template<typename T>
+        void GrowBuffers( TVector<T>& buffers, int32_t numBuffers );
+
     private:
 
         Skeleton const*                             m_pSkeleton = nullptr;
+        TInlineVector<void*, 8>                     m_arenaBlocks;
+        size_t                                      m_poseMemorySize = 0;
+        size_t                                      m_arenaSize = 0;
         TVector<PoseBuffer>                         m_poseBuffers;
         TVector<CachedPoseBuffer>                   m_cachedBuffers;
         TInlineVector<UUID, 5>                      m_cachedPoseBuffersToDestroy;
         int8_t                                        m_firstFreeCachedBuffer = 0;
         int8_t                                        m_firstFreeBuffer = 0;
+        Threading::Mutex                            m_mutex;
+        bool                                        m_isParallelAccessEnabled = false;
 
         #if EE_DEVELOPMENT_TOOLS
         TVector<PoseBuffer>                         m_debugBuffers;
         int8_t                                        m_firstFreeDebugBuffer = 0;
         mutable bool                                m_isDebugRecordingEnabled = false;
+        uint32_t                                    m_numHeapAllocations = 0;
+        uint32_t                                    m_numHeapAllocationsThisFrame = 0;
+        uint32_t                                    m_numHeapAllocationsLastFrame = 0;
         #endif
     };
 }
\ No newline at end of file
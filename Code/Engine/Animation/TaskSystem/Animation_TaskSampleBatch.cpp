@@ -0,0 +1,148 @@
+#include "Animation_TaskSampleBatch.h"
+#include "Tasks/Animation_Task_Sample.h"
+#include "System/Threading/TaskSystem.h"
+#include "System/Time/Timers.h"
+#include "System/Profiling.h"
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    void SampleTaskBatch::AddTask( Tasks::SampleTask* pTask, TaskContext const& context )
+    {
+        EE_ASSERT( pTask != nullptr && !pTask->IsComplete() && pTask->GetResultBufferIndex() != InvalidIndex );
+
+        Threading::ScopeLock lock( m_mutex );
+        auto& batchedTask = m_batchedTasks.emplace_back();
+        batchedTask.m_pAnimation = pTask->m_pAnimation;
+        batchedTask.m_pTask = pTask;
+        batchedTask.m_pContext = &context;
+        batchedTask.m_pCost = context.m_pSampleBatchCost;
+    }
+
+    void SampleTaskBatch::Execute( EE::TaskSystem* pTaskScheduler )
+    {
+        EE_PROFILE_SCOPE_ANIMATION( "Sample Task Batch" );
+
+        if ( m_batchedTasks.empty() )
+        {
+            return;
+        }
+
+        struct ClipGroupSamplingTask final : public ITaskSet
+        {
+            ClipGroupSamplingTask( SampleTaskBatch* pBatch, uint32_t numGroups )
+                : m_pBatch( pBatch )
+            {
+                m_SetSize = numGroups;
+            }
+
+            virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+            {
+                for ( uint64_t i = range.start; i < range.end; ++i )
+                {
+                    m_pBatch->ExecuteClipGroup( m_pBatch->m_clipGroupStartIndices[i], m_pBatch->m_clipGroupStartIndices[i + 1] );
+                }
+            }
+
+        private:
+
+            SampleTaskBatch*                        m_pBatch = nullptr;
+        };
+
+        // Group the tasks by clip, and sort each group by time so that neighbouring requests read neighbouring frame blocks
+        //-------------------------------------------------------------------------
+
+        auto SortPredicate = [] ( BatchedTask const& a, BatchedTask const& b )
+        {
+            if ( a.m_pAnimation != b.m_pAnimation )
+            {
+                return a.m_pAnimation < b.m_pAnimation;
+            }
+
+            return a.m_pTask->m_time < b.m_pTask->m_time;
+        };
+
+        eastl::sort( m_batchedTasks.begin(), m_batchedTasks.end(), SortPredicate );
+
+        // Create the sample requests and find the clip group ranges
+        //-------------------------------------------------------------------------
+
+        int32_t const numBatchedTasks = (int32_t) m_batchedTasks.size();
+        m_sampleRequests.resize( numBatchedTasks );
+        m_sampleCosts.resize( numBatchedTasks );
+        m_clipGroupStartIndices.clear();
+
+        for ( int32_t i = 0; i < numBatchedTasks; i++ )
+        {
+            BatchedTask const& batchedTask = m_batchedTasks[i];
+            if ( i == 0 || batchedTask.m_pAnimation != m_batchedTasks[i - 1].m_pAnimation )
+            {
+                m_clipGroupStartIndices.emplace_back( i );
+            }
+
+            // The pose buffer is only resolved now since the pools may have grown while the tasks were being added
+            auto& request = m_sampleRequests[i];
+            request.m_frameTime = batchedTask.m_pAnimation->GetFrameTime( batchedTask.m_pTask->m_time );
+            request.m_pPose = &batchedTask.m_pContext->m_posePool.GetBuffer( batchedTask.m_pTask->GetResultBufferIndex() )->m_pose;
+            request.m_lod = batchedTask.m_pContext->m_skeletonLOD;
+        }
+
+        int32_t const numClipGroups = (int32_t) m_clipGroupStartIndices.size();
+        m_clipGroupStartIndices.emplace_back( numBatchedTasks );
+
+        // Sample all groups
+        //-------------------------------------------------------------------------
+
+        if ( pTaskScheduler != nullptr && numClipGroups > 1 )
+        {
+            ClipGroupSamplingTask samplingTask( this, (uint32_t) numClipGroups );
+            pTaskScheduler->ScheduleTask( &samplingTask );
+            pTaskScheduler->WaitForTask( &samplingTask );
+        }
+        else
+        {
+            for ( int32_t i = 0; i < numClipGroups; i++ )
+            {
+                ExecuteClipGroup( m_clipGroupStartIndices[i], m_clipGroupStartIndices[i + 1] );
+            }
+        }
+
+        // Attribute the sampling cost back to the tasks' owners, this is done serially since multiple clip groups can contain tasks from the same owner
+        //-------------------------------------------------------------------------
+
+        for ( int32_t i = 0; i < numBatchedTasks; i++ )
+        {
+            if ( m_batchedTasks[i].m_pCost != nullptr )
+            {
+                *m_batchedTasks[i].m_pCost += m_sampleCosts[i];
+            }
+        }
+
+        m_batchedTasks.clear();
+        m_sampleRequests.clear();
+        m_sampleCosts.clear();
+    }
+
+    void SampleTaskBatch::ExecuteClipGroup( int32_t startIdx, int32_t endIdx )
+    {
+        EE_ASSERT( startIdx >= 0 && startIdx < endIdx && endIdx <= m_batchedTasks.size() );
+
+        Timer<PlatformClock> timer;
+
+        AnimationClip const* pAnimation = m_batchedTasks[startIdx].m_pAnimation;
+        pAnimation->GetPoses( &m_sampleRequests[startIdx], endIdx - startIdx );
+
+        for ( int32_t i = startIdx; i < endIdx; i++ )
+        {
+            m_batchedTasks[i].m_pTask->MarkTaskComplete( *m_batchedTasks[i].m_pContext );
+        }
+
+        Milliseconds const costPerTask = timer.GetElapsedTimeMilliseconds() / float( endIdx - startIdx );
+        for ( int32_t i = startIdx; i < endIdx; i++ )
+        {
+            m_sampleCosts[i] = costPerTask;
+        }
+    }
+}
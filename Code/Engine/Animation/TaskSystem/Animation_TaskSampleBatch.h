@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Engine/Animation/AnimationClip.h"
+#include "System/Threading/Threading.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE { class TaskSystem; }
+
+//-------------------------------------------------------------------------
+// Sample Task Batch
+//-------------------------------------------------------------------------
+// Collects the sample tasks of all characters in a world for a frame and executes them together
+// Requests are grouped by animation clip so that each clip's compressed data is only brought into the cache once,
+// and the frame independent decoding data for each clip is shared across all the characters sampling it
+
+namespace EE::Animation
+{
+    struct TaskContext;
+    namespace Tasks { class SampleTask; }
+
+    //-------------------------------------------------------------------------
+
+    class SampleTaskBatch
+    {
+        struct BatchedTask
+        {
+            AnimationClip const*                    m_pAnimation = nullptr;
+            Tasks::SampleTask*                      m_pTask = nullptr;
+            TaskContext const*                      m_pContext = nullptr;
+            Milliseconds*                           m_pCost = nullptr;
+        };
+
+    public:
+
+        inline bool IsEmpty() const { return m_batchedTasks.empty(); }
+        inline int32_t GetNumBatchedTasks() const { return (int32_t) m_batchedTasks.size(); }
+
+        // Add a sample task to the batch, the task needs to have already acquired its result buffer - threadsafe
+        // Note: the context needs to remain valid until the batch is executed
+        void AddTask( Tasks::SampleTask* pTask, TaskContext const& context );
+
+        // Sample all the batched tasks and mark them as complete, clip groups will be sampled in parallel if a task scheduler is provided
+        // The time spent sampling is attributed back to each task's context (see 'TaskContext::m_pSampleBatchCost')
+        void Execute( EE::TaskSystem* pTaskScheduler = nullptr );
+
+    private:
+
+        // Sample a group of tasks that all use the same animation clip
+        void ExecuteClipGroup( int32_t startIdx, int32_t endIdx );
+
+    private:
+
+        TVector<BatchedTask>                        m_batchedTasks;
+        TVector<AnimationClip::PoseSampleRequest>   m_sampleRequests;
+        TVector<Milliseconds>                       m_sampleCosts; // The cost of each batched task, clip groups are timed as a whole and the cost is split evenly between its tasks
+        TVector<int32_t>                            m_clipGroupStartIndices;
+        Threading::Mutex                            m_mutex;
+    };
+}
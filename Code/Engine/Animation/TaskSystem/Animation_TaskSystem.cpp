@@ -1,8 +1,10 @@
 #include "Animation_TaskSystem.h"
 #include "Tasks/Animation_Task_DefaultPose.h"
+#include "Tasks/Animation_Task_Sample.h"
 #include "Engine/Animation/AnimationBlender.h"
 #include "System/Log.h"
 #include "System/Drawing/DebugDrawing.h"
+#include "System/Threading/TaskSystem.h"
 #include "System/Profiling.h"
 
 //-------------------------------------------------------------------------
@@ -31,8 +33,15 @@ namespace EE::Animation
         }
 
         m_tasks.clear();
+        m_sampleTaskRecords.clear();
         m_posePool.Reset();
         m_hasPhysicsDependency = false;
+        m_hasSerialOnlyTasks = false;
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_numSampleTaskRequests = 0;
+        m_numSharedSampleTasks = 0;
+        #endif
     }
 
     //-------------------------------------------------------------------------
@@ -43,9 +52,54 @@ namespace EE::Animation
 
         for ( int16_t t = (int16_t) m_tasks.size() - 1; t >= marker; t-- )
         {
+            for ( auto depTaskIdx : m_tasks[t]->GetDependencyIndices() )
+            {
+                m_tasks[depTaskIdx]->m_numPendingConsumers--;
+            }
+
             EE::Delete( m_tasks[t] );
             m_tasks.erase( m_tasks.begin() + t );
         }
+
+        // Rolled back sample tasks can no longer be shared
+        for ( int32_t i = (int32_t) m_sampleTaskRecords.size() - 1; i >= 0; i-- )
+        {
+            if ( m_sampleTaskRecords[i].m_taskIdx >= marker )
+            {
+                m_sampleTaskRecords.erase_unsorted( m_sampleTaskRecords.begin() + i );
+            }
+        }
+    }
+
+    TaskIndex TaskSystem::RegisterSampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time )
+    {
+        EE_ASSERT( pAnimation != nullptr );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_numSampleTaskRequests++;
+        m_totalNumSampleTaskRequests++;
+        #endif
+
+        // All tasks are evaluated at the same skeleton LOD, so the same clip at the same frame time will always produce the same pose
+        FrameTime const frameTime = pAnimation->GetFrameTime( time );
+        for ( SampleTaskRecord const& record : m_sampleTaskRecords )
+        {
+            if ( record.m_pAnimation == pAnimation && record.m_frameTime.GetFrameIndex() == frameTime.GetFrameIndex() && record.m_frameTime.GetPercentageThrough() == frameTime.GetPercentageThrough() )
+            {
+                #if EE_DEVELOPMENT_TOOLS
+                m_numSharedSampleTasks++;
+                m_totalNumSharedSampleTasks++;
+                #endif
+
+                return record.m_taskIdx;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        TaskIndex const taskIdx = RegisterTask<Tasks::SampleTask>( sourceID, pAnimation, time );
+        m_sampleTaskRecords.push_back( { pAnimation, frameTime, taskIdx } );
+        return taskIdx;
     }
 
     //-------------------------------------------------------------------------
@@ -75,14 +129,15 @@ namespace EE::Animation
         // Cant add the same task twice, i.e. codependency
         if ( VectorContains( m_prePhysicsTaskIndices, taskIdx ) )
         {
-            return false;
+            // Shared sample results are expected to be reached from multiple task chains
+            return pTask->HasSharedResult() && pTask->GetNumDependencies() == 0;
         }
 
         m_prePhysicsTaskIndices.emplace_back( taskIdx );
         return true;
     }
 
-    void TaskSystem::UpdatePrePhysics( float deltaTime, Transform const& worldTransform, Transform const& worldTransformInverse )
+    void TaskSystem::UpdatePrePhysics( float deltaTime, Transform const& worldTransform, Transform const& worldTransformInverse, EE::TaskSystem* pTaskScheduler )
     {
         EE_PROFILE_SCOPE_ANIMATION( "Anim Pre-Physics Tasks" );
 
@@ -93,6 +148,8 @@ namespace EE::Animation
 
         m_prePhysicsTaskIndices.clear();
         m_hasCodependentPhysicsTasks = false;
+        m_hasDeferredTasks = false;
+        m_sampleBatchCost = 0.0f;
 
         // Conditionally execute all pre-physics tasks
         //-------------------------------------------------------------------------
@@ -124,25 +181,36 @@ namespace EE::Animation
             {
                 for ( TaskIndex prePhysicsTaskIdx : m_prePhysicsTaskIndices )
                 {
-                    // Set dependencies
-                    m_taskContext.m_dependencies.clear();
-                    for ( auto depTaskIdx : m_tasks[prePhysicsTaskIdx]->GetDependencyIndices() )
-                    {
-                        EE_ASSERT( m_tasks[depTaskIdx]->IsComplete() );
-                        m_taskContext.m_dependencies.emplace_back( m_tasks[depTaskIdx] );
-                    }
+                    ExecuteTask( prePhysicsTaskIdx, m_taskContext );
+                }
+            }
+        }
+        else if ( CanDeferTasksToSampleBatch() ) // Only run the leaf tasks now, sample tasks will be added to the batch and everything else is executed post-physics
+        {
+            m_taskContext.m_pSampleBatch = m_pSampleBatch;
+            m_taskContext.m_pSampleBatchCost = &m_sampleBatchCost;
 
-                    m_tasks[prePhysicsTaskIdx]->Execute( m_taskContext );
+            // Tasks that access shared state (e.g. cached poses) are left in place to preserve their execution order relative to other tasks
+            auto const numTasks = (int8_t) m_tasks.size();
+            for ( TaskIndex i = 0; i < numTasks; i++ )
+            {
+                if ( m_tasks[i]->GetNumDependencies() == 0 && m_tasks[i]->SupportsParallelExecution() )
+                {
+                    ExecuteTask( i, m_taskContext );
                 }
             }
+
+            m_taskContext.m_pSampleBatch = nullptr;
+            m_taskContext.m_pSampleBatchCost = nullptr;
+            m_hasDeferredTasks = true;
         }
         else // If we have no physics dependent tasks, execute all tasks now
         {
-            ExecuteTasks();
+            ExecuteTasks( pTaskScheduler );
         }
     }
 
-    void TaskSystem::UpdatePostPhysics()
+    void TaskSystem::UpdatePostPhysics( EE::TaskSystem* pTaskScheduler )
     {
         EE_PROFILE_SCOPE_ANIMATION( "Anim Post-Physics Tasks" );
 
@@ -156,11 +224,11 @@ namespace EE::Animation
 
         // Execute tasks
         //-------------------------------------------------------------------------
-        // Only run tasks if we have a physics dependency, else all tasks were already executed in the first update stage
+        // Only run tasks if we have a physics dependency or deferred tasks, else all tasks were already executed in the first update stage
 
-        if ( m_hasPhysicsDependency )
+        if ( m_hasPhysicsDependency || m_hasDeferredTasks )
         {
-            ExecuteTasks();
+            ExecuteTasks( pTaskScheduler );
         }
 
         // Reflect animation pose out
@@ -178,11 +246,17 @@ namespace EE::Animation
             {
                 m_finalPose.Reset( Pose::Type::ReferencePose );
                 TBitFlags<PoseBlendOptions> blendOptions( PoseBlendOptions::Additive );
-                Blender::Blend( &m_finalPose, pResultPose, 1.0f, blendOptions, nullptr, &m_finalPose );
+                Blender::Blend( m_taskContext.m_skeletonLOD, &m_finalPose, pResultPose, 1.0f, blendOptions, nullptr, &m_finalPose );
             }
             else // Just copy the pose
             {
                 m_finalPose.CopyFrom( pResultPoseBuffer->m_pose );
+
+                // The high LOD bones were not evaluated so reset them to the reference pose
+                if ( m_taskContext.m_skeletonLOD == Skeleton::LOD::Low )
+                {
+                    m_finalPose.SetHighLODBonesToReferencePose();
+                }
             }
 
             // Calculate the global transforms and release the task pose buffer
@@ -195,25 +269,202 @@ namespace EE::Animation
         }
     }
 
-    void TaskSystem::ExecuteTasks()
+    bool TaskSystem::CanDeferTasksToSampleBatch() const
+    {
+        if ( m_pSampleBatch == nullptr || m_tasks.empty() )
+        {
+            return false;
+        }
+
+        // Pose recording relies on the tasks completing in registration order
+        #if EE_DEVELOPMENT_TOOLS
+        if ( m_posePool.IsRecordingEnabled() )
+        {
+            return false;
+        }
+        #endif
+
+        return true;
+    }
+
+    void TaskSystem::ExecuteTask( TaskIndex taskIdx, TaskContext& context )
+    {
+        EE_ASSERT( taskIdx >= 0 && taskIdx < m_tasks.size() );
+
+        // Set dependencies
+        context.m_dependencies.clear();
+        for ( auto depTaskIdx : m_tasks[taskIdx]->GetDependencyIndices() )
+        {
+            EE_ASSERT( m_tasks[depTaskIdx]->IsComplete() );
+            context.m_dependencies.emplace_back( m_tasks[depTaskIdx] );
+        }
+
+        // Execute task
+        m_tasks[taskIdx]->Execute( context );
+    }
+
+    void TaskSystem::ExecuteTasks( EE::TaskSystem* pTaskScheduler )
     {
         int16_t const numTasks = (int8_t) m_tasks.size();
+
+        // Only go wide for large task graphs, for small graphs the scheduling overhead outweighs any gains
+        bool canExecuteInParallel = ( pTaskScheduler != nullptr ) && !m_hasSerialOnlyTasks && ( numTasks >= m_parallelExecutionThreshold );
+
+        // Pose recording relies on the tasks completing in registration order
+        #if EE_DEVELOPMENT_TOOLS
+        canExecuteInParallel &= !m_posePool.IsRecordingEnabled();
+        #endif
+
+        if ( canExecuteInParallel )
+        {
+            ExecuteTasksInParallel( pTaskScheduler );
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
         for ( TaskIndex i = 0; i < numTasks; i++ )
         {
             if ( !m_tasks[i]->IsComplete() )
             {
-                // Set dependencies
-                m_taskContext.m_dependencies.clear();
-                for ( auto DepTaskIdx : m_tasks[i]->GetDependencyIndices() )
+                ExecuteTask( i, m_taskContext );
+            }
+        }
+    }
+
+    void TaskSystem::ExecuteTasksInParallel( EE::TaskSystem* pTaskScheduler )
+    {
+        EE_PROFILE_SCOPE_ANIMATION( "Anim Tasks - Parallel" );
+
+        struct TaskLevelExecutionTask final : public ITaskSet
+        {
+            TaskLevelExecutionTask( TaskSystem* pTaskSystem, TaskIndex const* pTaskIndices, uint32_t numTasks )
+                : m_pTaskSystem( pTaskSystem )
+                , m_pTaskIndices( pTaskIndices )
+            {
+                m_SetSize = numTasks;
+            }
+
+            virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+            {
+                // Each worker needs its own context since the dependency list is set per task
+                TaskContext context = m_pTaskSystem->m_taskContext;
+                for ( uint64_t i = range.start; i < range.end; ++i )
+                {
+                    m_pTaskSystem->ExecuteTask( m_pTaskIndices[i], context );
+                }
+            }
+
+        private:
+
+            TaskSystem*                 m_pTaskSystem = nullptr;
+            TaskIndex const*            m_pTaskIndices = nullptr;
+        };
+
+        // Build the task DAG levels - each pending task is placed one level above its deepest pending dependency, so all tasks within a level are independent
+        //-------------------------------------------------------------------------
+        // Note: dependencies are always registered before the tasks that use them
+        // Consumers of a shared result are placed on different levels, since the consumption of a shared result is not threadsafe
+
+        int32_t const numTasks = (int32_t) m_tasks.size();
+        int16_t numLevels = 0;
+        int32_t numPendingTasks = 0;
+
+        m_taskLevels.resize( numTasks );
+        m_sharedResultConsumerLevels.clear();
+        m_sharedResultConsumerLevels.resize( numTasks, InvalidIndex );
+        for ( int32_t i = 0; i < numTasks; i++ )
+        {
+            if ( m_tasks[i]->IsComplete() )
+            {
+                m_taskLevels[i] = InvalidIndex;
+                continue;
+            }
+
+            int16_t level = 0;
+            for ( auto depTaskIdx : m_tasks[i]->GetDependencyIndices() )
+            {
+                EE_ASSERT( depTaskIdx < i );
+                level = Math::Max( level, int16_t( m_taskLevels[depTaskIdx] + 1 ) );
+
+                if ( m_tasks[depTaskIdx]->HasSharedResult() )
+                {
+                    level = Math::Max( level, int16_t( m_sharedResultConsumerLevels[depTaskIdx] + 1 ) );
+                }
+            }
+
+            for ( auto depTaskIdx : m_tasks[i]->GetDependencyIndices() )
+            {
+                if ( m_tasks[depTaskIdx]->HasSharedResult() )
                 {
-                    EE_ASSERT( m_tasks[DepTaskIdx]->IsComplete() );
-                    m_taskContext.m_dependencies.emplace_back( m_tasks[DepTaskIdx] );
+                    m_sharedResultConsumerLevels[depTaskIdx] = level;
                 }
+            }
+
+            m_taskLevels[i] = level;
+            numLevels = Math::Max( numLevels, int16_t( level + 1 ) );
+            numPendingTasks++;
+        }
+
+        if ( numPendingTasks == 0 )
+        {
+            return;
+        }
+
+        // Sort the pending tasks by level, keeping the registration order within a level
+        //-------------------------------------------------------------------------
+
+        m_levelStartIndices.clear();
+        m_levelStartIndices.resize( numLevels + 1, 0 );
+        for ( int32_t i = 0; i < numTasks; i++ )
+        {
+            if ( m_taskLevels[i] != InvalidIndex )
+            {
+                m_levelStartIndices[m_taskLevels[i] + 1]++;
+            }
+        }
+
+        for ( int16_t level = 1; level <= numLevels; level++ )
+        {
+            m_levelStartIndices[level] += m_levelStartIndices[level - 1];
+        }
+
+        TInlineVector<int16_t, 16> levelInsertionIndices = m_levelStartIndices;
+        m_parallelExecutionOrder.resize( numPendingTasks );
+        for ( int32_t i = 0; i < numTasks; i++ )
+        {
+            if ( m_taskLevels[i] != InvalidIndex )
+            {
+                m_parallelExecutionOrder[levelInsertionIndices[m_taskLevels[i]]++] = (TaskIndex) i;
+            }
+        }
+
+        // Execute levels
+        //-------------------------------------------------------------------------
+        // Each pending task holds at most a single result buffer, so reserve enough buffers to prevent the pool from growing while tasks are in flight
+
+        m_posePool.BeginParallelAccess( numPendingTasks );
+
+        for ( int16_t level = 0; level < numLevels; level++ )
+        {
+            int32_t const levelStartIdx = m_levelStartIndices[level];
+            int32_t const numLevelTasks = m_levelStartIndices[level + 1] - levelStartIdx;
+            TaskIndex const* pLevelTaskIndices = &m_parallelExecutionOrder[levelStartIdx];
 
-                // Execute task
-                m_tasks[i]->Execute( m_taskContext );
+            // Dont bother scheduling a single task, just run it on this thread
+            if ( numLevelTasks == 1 )
+            {
+                ExecuteTask( pLevelTaskIndices[0], m_taskContext );
+            }
+            else
+            {
+                TaskLevelExecutionTask levelTask( this, pLevelTaskIndices, (uint32_t) numLevelTasks );
+                pTaskScheduler->ScheduleTask( &levelTask );
+                pTaskScheduler->WaitForTask( &levelTask );
             }
         }
+
+        m_posePool.EndParallelAccess();
     }
 
     //-------------------------------------------------------------------------
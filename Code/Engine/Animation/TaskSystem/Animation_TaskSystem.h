@@ -1,11 +1,20 @@
 #pragma once
 
 #include "Animation_Task.h"
+#include "Engine/Animation/AnimationFrameTime.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE { class TaskSystem; }
 
 //-------------------------------------------------------------------------
 
 namespace EE::Animation
 {
+    class AnimationClip;
+
+    //-------------------------------------------------------------------------
+
     #if EE_DEVELOPMENT_TOOLS
     enum class TaskSystemDebugMode
     {
@@ -22,6 +31,18 @@ namespace EE::Animation
     {
         friend class AnimationDebugView;
 
+        struct SampleTaskRecord
+        {
+            AnimationClip const*        m_pAnimation = nullptr;
+            FrameTime                   m_frameTime;
+            TaskIndex                   m_taskIdx = InvalidIndex;
+        };
+
+    public:
+
+        // The minimum number of tasks a character needs to have before we execute them in parallel
+        constexpr static int32_t const s_defaultParallelExecutionThreshold = 12;
+
     public:
 
         TaskSystem( Skeleton const* pSkeleton );
@@ -43,11 +64,26 @@ namespace EE::Animation
 
         inline bool HasPhysicsDependency() const { return m_hasPhysicsDependency; }
 
-        // Run all pre-physics tasks
-        void UpdatePrePhysics( float deltaTime, Transform const& worldTransform, Transform const& worldTransformInverse );
+        // Set the skeleton LOD to evaluate the tasks at, at the low LOD the high LOD bones are set to the reference pose in the final pose
+        inline void SetSkeletonLOD( Skeleton::LOD lod ) { m_taskContext.m_skeletonLOD = lod; }
+        inline Skeleton::LOD GetSkeletonLOD() const { return m_taskContext.m_skeletonLOD; }
+
+        // Set the number of tasks above which independent tasks will be dispatched to the task scheduler (if one is provided)
+        inline void SetParallelExecutionThreshold( int32_t threshold ) { EE_ASSERT( threshold > 0 ); m_parallelExecutionThreshold = threshold; }
+        inline int32_t GetParallelExecutionThreshold() const { return m_parallelExecutionThreshold; }
+
+        // Set the batch that sample tasks should be deferred to. When set, graphs without physics dependencies will only sample their poses in the pre-physics update,
+        // the batch is expected to be executed before the post-physics update which will then execute all the remaining tasks
+        inline void SetSampleBatch( SampleTaskBatch* pSampleBatch ) { m_pSampleBatch = pSampleBatch; }
+
+        // Get the time the sample batch spent sampling this frame's deferred sample tasks, only valid once the batch has been executed
+        inline Milliseconds GetSampleBatchCost() const { return m_sampleBatchCost; }
 
-        // Run all post-physics tasks and fill out the final pose buffer
-        void UpdatePostPhysics();
+        // Run all pre-physics tasks, large task graphs will be executed in parallel if a task scheduler is provided
+        void UpdatePrePhysics( float deltaTime, Transform const& worldTransform, Transform const& worldTransformInverse, EE::TaskSystem* pTaskScheduler = nullptr );
+
+        // Run all post-physics tasks and fill out the final pose buffer, large task graphs will be executed in parallel if a task scheduler is provided
+        void UpdatePostPhysics( EE::TaskSystem* pTaskScheduler = nullptr );
 
         // Cached Pose storage
         //-------------------------------------------------------------------------
@@ -66,10 +102,20 @@ namespace EE::Animation
         {
             EE_ASSERT( m_tasks.size() < 0xFF );
             auto pNewTask = m_tasks.emplace_back( EE::New<T>( std::forward<ConstructorParams>( params )... ) );
+            for ( auto depTaskIdx : pNewTask->GetDependencyIndices() )
+            {
+                EE_ASSERT( depTaskIdx >= 0 && depTaskIdx < (TaskIndex) ( m_tasks.size() - 1 ) );
+                m_tasks[depTaskIdx]->m_numPendingConsumers++;
+            }
+
             m_hasPhysicsDependency |= pNewTask->HasPhysicsDependency();
+            m_hasSerialOnlyTasks |= !pNewTask->SupportsParallelExecution();
             return (TaskIndex) ( m_tasks.size() - 1 );
         }
 
+        // Register a sample task, if the same clip has already been requested at the same frame time this frame, the existing task is returned and its result is shared
+        TaskIndex RegisterSampleTask( TaskSourceID sourceID, AnimationClip const* pAnimation, Percentage time );
+
         TaskIndex GetCurrentTaskIndexMarker() const { return (TaskIndex) m_tasks.size(); }
         void RollbackToTaskIndexMarker( TaskIndex const marker );
 
@@ -79,13 +125,22 @@ namespace EE::Animation
         #if EE_DEVELOPMENT_TOOLS
         void SetDebugMode( TaskSystemDebugMode mode );
         TaskSystemDebugMode GetDebugMode() const { return m_debugMode; }
+        inline uint32_t GetNumSampleTaskRequests() const { return m_numSampleTaskRequests; }
+        inline uint32_t GetNumSharedSampleTasks() const { return m_numSharedSampleTasks; }
+        inline uint64_t GetTotalNumSampleTaskRequests() const { return m_totalNumSampleTaskRequests; }
+        inline uint64_t GetTotalNumSharedSampleTasks() const { return m_totalNumSharedSampleTasks; }
         void DrawDebug( Drawing::DrawContext& drawingContext );
         #endif
 
     private:
 
         bool AddTaskChainToPrePhysicsList( TaskIndex taskIdx );
-        void ExecuteTasks();
+        void ExecuteTasks( EE::TaskSystem* pTaskScheduler );
+        void ExecuteTask( TaskIndex taskIdx, TaskContext& context );
+        bool CanDeferTasksToSampleBatch() const;
+
+        // Execute all pending tasks by splitting the task DAG into levels of independent tasks and dispatching each level to the task scheduler
+        void ExecuteTasksInParallel( EE::TaskSystem* pTaskScheduler );
 
         #if EE_DEVELOPMENT_TOOLS
         void CalculateTaskOffset( TaskIndex taskIdx, Float2 const& currentOffset, TInlineVector<Float2, 16>& offsets );
@@ -97,12 +152,26 @@ namespace EE::Animation
         PoseBufferPool                  m_posePool;
         TaskContext                     m_taskContext;
         TInlineVector<TaskIndex, 16>    m_prePhysicsTaskIndices;
+        TInlineVector<TaskIndex, 32>    m_parallelExecutionOrder;
+        TInlineVector<int16_t, 32>      m_taskLevels;
+        TInlineVector<int16_t, 16>      m_levelStartIndices;
+        TInlineVector<int16_t, 32>      m_sharedResultConsumerLevels;
+        TInlineVector<SampleTaskRecord, 8> m_sampleTaskRecords;
+        int32_t                         m_parallelExecutionThreshold = s_defaultParallelExecutionThreshold;
         Pose                            m_finalPose;
         bool                            m_hasPhysicsDependency = false;
         bool                            m_hasCodependentPhysicsTasks = false;
+        bool                            m_hasSerialOnlyTasks = false;
+        bool                            m_hasDeferredTasks = false;
+        SampleTaskBatch*                m_pSampleBatch = nullptr;
+        Milliseconds                    m_sampleBatchCost = 0.0f;
 
         #if EE_DEVELOPMENT_TOOLS
         TaskSystemDebugMode             m_debugMode = TaskSystemDebugMode::Off;
+        uint32_t                        m_numSampleTaskRequests = 0;
+        uint32_t                        m_numSharedSampleTasks = 0;
+        uint64_t                        m_totalNumSampleTaskRequests = 0;
+        uint64_t                        m_totalNumSharedSampleTasks = 0;
         #endif
     };
 }
\ No newline at end of file
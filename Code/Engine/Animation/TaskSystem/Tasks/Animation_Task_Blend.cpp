@@ -25,7 +25,7 @@ namespace EE::Animation::Tasks
         auto pTargetBuffer = AccessDependencyPoseBuffer( context, 1 );
         auto pFinalBuffer = pSourceBuffer;
 
-        Blender::Blend( &pSourceBuffer->m_pose, &pTargetBuffer->m_pose, m_blendWeight, m_blendOptions, m_pBoneMask, &pFinalBuffer->m_pose );
+        Blender::Blend( context.m_skeletonLOD, &pSourceBuffer->m_pose, &pTargetBuffer->m_pose, m_blendWeight, m_blendOptions, m_pBoneMask, &pFinalBuffer->m_pose );
 
         ReleaseDependencyPoseBuffer( context, 1 );
         MarkTaskComplete( context );
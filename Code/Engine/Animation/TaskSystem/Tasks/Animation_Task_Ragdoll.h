@@ -28,6 +28,7 @@ namespace EE::Animation::Tasks
 
         RagdollSetPoseTask( Physics::Ragdoll* pRagdoll, TaskSourceID sourceID, TaskIndex sourceTaskIdx, InitOption initOption = InitOption::DoNothing );
         virtual void Execute( TaskContext const& context ) override;
+        virtual bool SupportsParallelExecution() const override { return false; }
 
         #if EE_DEVELOPMENT_TOOLS
         virtual String GetDebugText() const override { return "Set Ragdoll Pose"; }
@@ -50,6 +51,7 @@ namespace EE::Animation::Tasks
         RagdollGetPoseTask( Physics::Ragdoll* pRagdoll, TaskSourceID sourceID, TaskIndex sourceTaskIdx, float const physicsBlendWeight = 1.0f );
         RagdollGetPoseTask( Physics::Ragdoll* pRagdoll, TaskSourceID sourceID );
         virtual void Execute( TaskContext const& context ) override;
+        virtual bool SupportsParallelExecution() const override { return false; }
 
         #if EE_DEVELOPMENT_TOOLS
         virtual String GetDebugText() const override;
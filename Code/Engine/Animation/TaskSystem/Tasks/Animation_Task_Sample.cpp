@@ -1,4 +1,5 @@
 #include "Animation_Task_Sample.h"
+#include "Engine/Animation/TaskSystem/Animation_TaskSampleBatch.h"
 
 //-------------------------------------------------------------------------
 
@@ -17,7 +18,15 @@ namespace EE::Animation::Tasks
         EE_ASSERT( m_pAnimation != nullptr );
 
         auto pResultBuffer = GetNewPoseBuffer( context );
-        m_pAnimation->GetPose( m_time, &pResultBuffer->m_pose );
+
+        // Defer the sampling to the world's sample batch, the batch will complete this task
+        if ( context.m_pSampleBatch != nullptr )
+        {
+            context.m_pSampleBatch->AddTask( this, context );
+            return;
+        }
+
+        m_pAnimation->GetPose( m_time, &pResultBuffer->m_pose, context.m_skeletonLOD );
         MarkTaskComplete( context );
     }
 
@@ -5,10 +5,15 @@
 
 //-------------------------------------------------------------------------
 
+namespace EE::Animation { class SampleTaskBatch; }
+
+//-------------------------------------------------------------------------
+
 namespace EE::Animation::Tasks
 {
     class SampleTask : public Task
     {
+        friend class Animation::SampleTaskBatch;
 
     public:
 
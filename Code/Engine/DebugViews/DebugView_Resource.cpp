@@ -1,5 +1,6 @@
 #include "DebugView_Resource.h"
 #include "System/Resource/ResourceSystem.h"
+#include "System/Resource/ResourceSettings.h"
 #include "System/Systems.h"
 #include "System/Imgui/ImguiX.h"
 
@@ -95,7 +96,14 @@ namespace EE::Resource
 
                 case LoadingStatus::Loaded:
                 {
-                    ImGui::TextColored( Colors::LimeGreen.ToFloat4(), "Loaded" );
+                    if ( pRecord->m_isCached )
+                    {
+                        ImGui::TextColored( Colors::Aqua.ToFloat4(), "Cached" );
+                    }
+                    else
+                    {
+                        ImGui::TextColored( Colors::LimeGreen.ToFloat4(), "Loaded" );
+                    }
                 }
                 break;
 
@@ -171,6 +179,70 @@ namespace EE::Resource
 
             ImGui::Separator();
 
+            auto const& ioStats = pResourceSystem->m_ioQueue.GetStats();
+            ImGui::Text( "I/O Queued: %d, In Flight: %d", ioStats.m_numQueuedReads, ioStats.m_numInFlightReads );
+            ImGui::Text( "I/O Reads: %llu, Failed: %llu, Read: %.2fMB", ioStats.m_numCompletedReads, ioStats.m_numFailedReads, float( ioStats.m_numBytesRead ) / ( 1024.0f * 1024.0f ) );
+            ImGui::Text( "I/O Throughput: %.2fMB/s, Avg Latency: %.3fms, Max Latency: %.3fms", ioStats.GetThroughput(), ioStats.GetAverageLatency().ToFloat(), ioStats.m_maxLatency.ToFloat() );
+
+            auto const& settings = pResourceSystem->GetSettings();
+            ImGui::Text( "Install Budget: %.2fms, %uKB - Deferred Loads/Installs: %d", settings.m_maxInstallTimePerFrame.ToFloat(), settings.m_maxInstallBytesPerFrame / 1024, pResourceSystem->m_numDeferredInstalls );
+
+            float const bytesToMB = 1.0f / ( 1024.0f * 1024.0f );
+            ImGui::Text( "Unreferenced Cache: %.2fMB / %.2fMB, %d Resources - Hits: %u, Evictions: %u", pResourceSystem->m_unreferencedCacheSize * bytesToMB, pResourceSystem->m_unreferencedCacheBudget * bytesToMB, (int32_t) pResourceSystem->m_unreferencedResources.size(), pResourceSystem->m_numCacheHits, pResourceSystem->m_numCacheEvictions );
+
+            ImGui::Separator();
+
+            if ( ImGui::CollapsingHeader( "Resident Memory" ) )
+            {
+                if ( ImGui::BeginTable( "Resident Memory Table", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+                {
+                    ImGui::TableSetupColumn( "Type", ImGuiTableColumnFlags_WidthStretch );
+                    ImGui::TableSetupColumn( "Resident", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+                    ImGui::TableSetupColumn( "Resident Size", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 90 );
+                    ImGui::TableSetupColumn( "Cached", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+                    ImGui::TableSetupColumn( "Cached Size", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 90 );
+
+                    ImGui::TableHeadersRow();
+
+                    //-------------------------------------------------------------------------
+
+                    size_t totalResidentBytes = 0;
+                    for ( auto const& statsTuple : pResourceSystem->m_residentMemoryStats )
+                    {
+                        auto const& stats = statsTuple.second;
+                        if ( stats.m_numResident == 0 && stats.m_numCached == 0 )
+                        {
+                            continue;
+                        }
+
+                        ImGui::TableNextRow();
+
+                        ImGui::TableSetColumnIndex( 0 );
+                        ImGui::Text( statsTuple.first.ToString().c_str() );
+
+                        ImGui::TableSetColumnIndex( 1 );
+                        ImGui::Text( "%d", stats.m_numResident );
+
+                        ImGui::TableSetColumnIndex( 2 );
+                        ImGui::Text( "%.2fMB", stats.m_residentBytes * bytesToMB );
+
+                        ImGui::TableSetColumnIndex( 3 );
+                        ImGui::Text( "%d", stats.m_numCached );
+
+                        ImGui::TableSetColumnIndex( 4 );
+                        ImGui::Text( "%.2fMB", stats.m_cachedBytes * bytesToMB );
+
+                        totalResidentBytes += stats.m_residentBytes;
+                    }
+
+                    ImGui::EndTable();
+
+                    ImGui::Text( "Total Resident: %.2fMB", totalResidentBytes * bytesToMB );
+                }
+            }
+
+            ImGui::Separator();
+
             if ( ImGui::BeginTable( "Resource Reference Tracker Table", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
             {
                 ImGui::TableSetupColumn( "Type", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 30 );
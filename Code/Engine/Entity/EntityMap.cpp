@@ -276,7 +276,8 @@ namespace EE::EntityModel
         }
         else // Request loading of map resource
         {
-            loadingContext.m_pResourceSystem->LoadResource( m_pMapDesc );
+            // Nothing else in the map can be loaded until we have the descriptor
+            loadingContext.m_pResourceSystem->LoadResource( m_pMapDesc, Resource::ResourceRequesterID(), Resource::LoadPriority::High );
             m_status = Status::Loading;
         }
     }
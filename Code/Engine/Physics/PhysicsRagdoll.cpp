@@ -1239,8 +1239,8 @@ namespace EE::Physics
         //-------------------------------------------------------------------------
 
         int32_t const numBones = pPose->GetNumBones();
-        m_globalBoneTransforms.resize( numBones );
-        m_globalBoneTransforms = pPose->GetGlobalTransforms();
+        Transform const* pGlobalTransforms = pPose->GetGlobalTransforms();
+        m_globalBoneTransforms.assign( pGlobalTransforms, pGlobalTransforms + numBones );
 
         //-------------------------------------------------------------------------
 
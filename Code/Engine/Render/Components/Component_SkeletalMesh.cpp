@@ -1,5 +1,6 @@
 #include "Component_SkeletalMesh.h"
 #include "Engine/Animation/AnimationPose.h"
+#include "Engine/Animation/AnimationPoseSoA.h"
 #include "System/Drawing/DebugDrawing.h"
 #include "System/Profiling.h"
 
@@ -27,18 +28,15 @@ namespace EE::Render
             m_boneTransforms.resize( m_mesh->GetNumBones() );
             ResetPose();
 
-            //-------------------------------------------------------------------------
-
-            // Allocate skinning transforms and calculate initial values
-            m_skinningTransforms.resize( m_boneTransforms.size() );
+            // Calculate the initial bounds, the skinning palette is only allocated once we are registered with the renderer
             FinalizePose();
         }
     }
 
     void SkeletalMeshComponent::Shutdown()
     {
+        EE_ASSERT( !HasSkinningPalette() );
         m_boneTransforms.clear();
-        m_skinningTransforms.clear();
         m_animToMeshBoneMap.clear();
         MeshComponent::Shutdown();
     }
@@ -106,14 +104,14 @@ namespace EE::Render
         EE_ASSERT( !m_animToMeshBoneMap.empty() );
         EE_ASSERT( pPose != nullptr && pPose->HasGlobalTransforms() );
 
+        Transform const* pGlobalTransforms = pPose->GetGlobalTransforms();
         int32_t const numAnimBones = pPose->GetNumBones();
         for ( auto animBoneIdx = 0; animBoneIdx < numAnimBones; animBoneIdx++ )
         {
             int32_t const meshBoneIdx = m_animToMeshBoneMap[animBoneIdx];
             if ( meshBoneIdx != InvalidIndex )
             {
-                Transform const boneTransform = pPose->GetGlobalTransform( animBoneIdx );
-                m_boneTransforms[meshBoneIdx] = boneTransform;
+                m_boneTransforms[meshBoneIdx] = pGlobalTransforms[animBoneIdx];
             }
         }
     }
@@ -140,38 +138,161 @@ namespace EE::Render
         EE_ASSERT( m_mesh.IsSet() && m_mesh.IsLoaded() );
 
         NotifySocketsUpdated();
-        UpdateBounds();
-        UpdateSkinningTransforms();
+        UpdateBoundsAndSkinningPalette();
     }
 
     //-------------------------------------------------------------------------
 
-    void SkeletalMeshComponent::UpdateBounds()
+    void SkeletalMeshComponent::AllocateSkinningPalette( SkinningPaletteBuffer* pPaletteBuffer )
     {
-        EE_ASSERT( m_mesh.IsSet() && m_mesh.IsLoaded() );
+        EE_ASSERT( IsInitialized() && HasMeshResourceSet() );
+        EE_ASSERT( pPaletteBuffer != nullptr && !HasSkinningPalette() );
+
+        m_pSkinningPaletteBuffer = pPaletteBuffer;
+        m_skinningPaletteRange = m_pSkinningPaletteBuffer->Allocate( m_skinningPaletteFormat, (int32_t) m_boneTransforms.size() );
+        UpdateBoundsAndSkinningPalette();
+    }
+
+    void SkeletalMeshComponent::ReleaseSkinningPalette()
+    {
+        EE_ASSERT( HasSkinningPalette() );
+        m_pSkinningPaletteBuffer->Release( m_skinningPaletteRange );
+        m_pSkinningPaletteBuffer = nullptr;
+    }
+
+    //-------------------------------------------------------------------------
 
-        AABB newBounds;
-        for ( auto const& boneTransform : m_boneTransforms )
+    // Write a single bone's skinning transform into the palette
+    static void WriteSkinningPaletteEntry( SkinningPaletteFormat format, Vector* pBoneData, int32_t numBones, int32_t boneIdx, Transform const& skinningTransform )
+    {
+        switch ( format )
         {
-            newBounds.AddPoint( boneTransform.GetTranslation() );
-        }
+            case SkinningPaletteFormat::Matrix4x4:
+            {
+                Matrix const skinningMatrix = skinningTransform.ToMatrix();
+                Vector* pRows = &pBoneData[boneIdx * 4];
+                pRows[0] = skinningMatrix.m_rows[0];
+                pRows[1] = skinningMatrix.m_rows[1];
+                pRows[2] = skinningMatrix.m_rows[2];
+                pRows[3] = skinningMatrix.m_rows[3];
+            }
+            break;
+
+            case SkinningPaletteFormat::Matrix3x4:
+            {
+                Matrix const skinningMatrix = skinningTransform.ToMatrix().GetTransposed();
+                Vector* pColumns = &pBoneData[boneIdx * 3];
+                pColumns[0] = skinningMatrix.m_rows[0];
+                pColumns[1] = skinningMatrix.m_rows[1];
+                pColumns[2] = skinningMatrix.m_rows[2];
+            }
+            break;
+
+            case SkinningPaletteFormat::DualQuaternion:
+            {
+                // Dual part is 0.5 * t * q (with t as a pure quaternion)
+                Float4 const q = skinningTransform.GetRotation().ToFloat4();
+                Float3 const t = skinningTransform.GetTranslation().ToFloat3();
+                Vector* pDualQuaternion = &pBoneData[boneIdx * 2];
+                pDualQuaternion[0] = skinningTransform.GetRotation().ToVector();
+                pDualQuaternion[1] = Vector( q.m_w * t.m_x + t.m_y * q.m_z - t.m_z * q.m_y, q.m_w * t.m_y + t.m_z * q.m_x - t.m_x * q.m_z, q.m_w * t.m_z + t.m_x * q.m_y - t.m_y * q.m_x, -( t.m_x * q.m_x + t.m_y * q.m_y + t.m_z * q.m_z ) ) * Vector::Half;
+
+                Vector& scales = pBoneData[numBones * 2 + ( boneIdx / 4 )];
+                Float4 packedScales = scales.ToFloat4();
+                packedScales[boneIdx % 4] = skinningTransform.GetScale();
+                scales = Vector( packedScales );
+            }
+            break;
 
-        SetLocalBounds( OBB( newBounds ) );
+            default:
+            {
+                EE_UNREACHABLE_CODE();
+            }
+            break;
+        }
     }
 
-    void SkeletalMeshComponent::UpdateSkinningTransforms()
+    void SkeletalMeshComponent::UpdateBoundsAndSkinningPalette()
     {
         EE_ASSERT( m_mesh.IsSet() && m_mesh.IsLoaded() );
 
-        auto const numBones = m_boneTransforms.size();
-        EE_ASSERT( m_skinningTransforms.size() == numBones );
+        int32_t const numBones = (int32_t) m_boneTransforms.size();
+        EE_ASSERT( numBones > 0 );
+
+        Transform const* pInverseBindPose = m_mesh->GetInverseBindPose().data();
+        Transform const* pBoneTransforms = m_boneTransforms.data();
+
+        // The palette is only available while we are registered with the renderer, the bone data starts after the palette header
+        Vector* pBoneData = HasSkinningPalette() ? m_pSkinningPaletteBuffer->GetPalette( m_skinningPaletteRange ) + 1 : nullptr;
+        Vector* pPackedScales = ( pBoneData != nullptr ) ? pBoneData + numBones * 2 : nullptr;
 
-        auto const& inverseBindPose = m_mesh->GetInverseBindPose();
-        for ( auto i = 0; i < numBones; i++ )
+        // Process groups of four bones, the bounds are accumulated per lane and combined at the end
+        //-------------------------------------------------------------------------
+
+        Vector minX = Vector::Infinity, minY = Vector::Infinity, minZ = Vector::Infinity;
+        Vector maxX = -Vector::Infinity, maxY = -Vector::Infinity, maxZ = -Vector::Infinity;
+
+        Animation::TransformSoA4 inverseBindTransforms, boneTransforms;
+
+        int32_t const numSIMDBones = numBones & ~3;
+        for ( auto i = 0; i < numSIMDBones; i += 4 )
         {
-            Transform const skinningTransform = inverseBindPose[i] * m_boneTransforms[i];
-            m_skinningTransforms[i] = ( skinningTransform ).ToMatrix();
+            boneTransforms.Load( &pBoneTransforms[i] );
+
+            minX = Vector::Min( minX, boneTransforms.m_translation.m_x );
+            minY = Vector::Min( minY, boneTransforms.m_translation.m_y );
+            minZ = Vector::Min( minZ, boneTransforms.m_translation.m_z );
+            maxX = Vector::Max( maxX, boneTransforms.m_translation.m_x );
+            maxY = Vector::Max( maxY, boneTransforms.m_translation.m_y );
+            maxZ = Vector::Max( maxZ, boneTransforms.m_translation.m_z );
+
+            if ( pBoneData == nullptr )
+            {
+                continue;
+            }
+
+            inverseBindTransforms.Load( &pInverseBindPose[i] );
+
+            // Negative scales require the full transform multiplication
+            if ( inverseBindTransforms.HasNegativeScale() || boneTransforms.HasNegativeScale() )
+            {
+                for ( auto j = i; j < i + 4; j++ )
+                {
+                    WriteSkinningPaletteEntry( m_skinningPaletteFormat, pBoneData, numBones, j, pInverseBindPose[j] * pBoneTransforms[j] );
+                }
+                continue;
+            }
+
+            Animation::TransformSoA4 const skinningTransforms = Animation::TransformSoA4::Multiply( inverseBindTransforms, boneTransforms );
+            switch ( m_skinningPaletteFormat )
+            {
+                case SkinningPaletteFormat::Matrix4x4: skinningTransforms.StoreMatrices( reinterpret_cast<Matrix*>( &pBoneData[i * 4] ) ); break;
+                case SkinningPaletteFormat::Matrix3x4: skinningTransforms.StoreMatrices3x4( &pBoneData[i * 3] ); break;
+                case SkinningPaletteFormat::DualQuaternion: skinningTransforms.StoreDualQuaternions( &pBoneData[i * 2], pPackedScales[i / 4] ); break;
+                default: EE_UNREACHABLE_CODE(); break;
+            }
         }
+
+        Float4 const minXs = minX.ToFloat4(), minYs = minY.ToFloat4(), minZs = minZ.ToFloat4();
+        Float4 const maxXs = maxX.ToFloat4(), maxYs = maxY.ToFloat4(), maxZs = maxZ.ToFloat4();
+        Vector boundsMin( Math::Min( Math::Min( minXs.m_x, minXs.m_y ), Math::Min( minXs.m_z, minXs.m_w ) ), Math::Min( Math::Min( minYs.m_x, minYs.m_y ), Math::Min( minYs.m_z, minYs.m_w ) ), Math::Min( Math::Min( minZs.m_x, minZs.m_y ), Math::Min( minZs.m_z, minZs.m_w ) ), 0.0f );
+        Vector boundsMax( Math::Max( Math::Max( maxXs.m_x, maxXs.m_y ), Math::Max( maxXs.m_z, maxXs.m_w ) ), Math::Max( Math::Max( maxYs.m_x, maxYs.m_y ), Math::Max( maxYs.m_z, maxYs.m_w ) ), Math::Max( Math::Max( maxZs.m_x, maxZs.m_y ), Math::Max( maxZs.m_z, maxZs.m_w ) ), 0.0f );
+
+        // Process the remaining bones
+        //-------------------------------------------------------------------------
+
+        for ( auto i = numSIMDBones; i < numBones; i++ )
+        {
+            boundsMin = Vector::Min( boundsMin, pBoneTransforms[i].GetTranslation() );
+            boundsMax = Vector::Max( boundsMax, pBoneTransforms[i].GetTranslation() );
+
+            if ( pBoneData != nullptr )
+            {
+                WriteSkinningPaletteEntry( m_skinningPaletteFormat, pBoneData, numBones, i, pInverseBindPose[i] * pBoneTransforms[i] );
+            }
+        }
+
+        SetLocalBounds( OBB( AABB::FromMinMax( boundsMin, boundsMax ) ) );
     }
 
     void SkeletalMeshComponent::GenerateAnimationBoneMap()
@@ -2,6 +2,7 @@
 
 #include "Component_RenderMesh.h"
 #include "Engine/Render/Mesh/SkeletalMesh.h"
+#include "Engine/Render/Mesh/SkinningPalette.h"
 #include "Engine/Animation/AnimationSkeleton.h"
 
 //-------------------------------------------------------------------------
@@ -16,6 +17,8 @@ namespace EE::Render
     {
         EE_REGISTER_ENTITY_COMPONENT( SkeletalMeshComponent );
 
+        friend class RendererWorldSystem;
+
     public:
 
         using MeshComponent::MeshComponent;
@@ -55,8 +58,25 @@ namespace EE::Render
         // Only run this function once per frame once you have set the final global pose
         void FinalizePose();
 
-        // Get the skinning transforms for this mesh - these are the global transforms relative to the bind pose
-        inline TVector<Matrix> const& GetSkinningTransforms() const { return m_skinningTransforms; }
+        // Skinning Palette
+        //-------------------------------------------------------------------------
+
+        inline SkinningPaletteFormat GetSkinningPaletteFormat() const { return m_skinningPaletteFormat; }
+
+        inline void SetSkinningPaletteFormat( SkinningPaletteFormat format )
+        {
+            EE_ASSERT( IsUnloaded() );
+            m_skinningPaletteFormat = format;
+        }
+
+        // Do we have a skinning palette allocated, this is only the case while the component is registered with the renderer
+        inline bool HasSkinningPalette() const { return m_skinningPaletteRange.IsValid(); }
+
+        // Get the skinning palette for this mesh - these are the global transforms relative to the bind pose, stored in the palette format
+        inline Vector const* GetSkinningPalette() const { EE_ASSERT( HasSkinningPalette() ); return m_pSkinningPaletteBuffer->GetPalette( m_skinningPaletteRange ); }
+
+        // Get the size of the skinning palette in bytes (including the header)
+        inline uint32_t GetSkinningPaletteByteSize() const { return m_skinningPaletteRange.m_size * sizeof( Vector ); }
 
         // Animation Pose
         //-------------------------------------------------------------------------
@@ -80,8 +100,8 @@ namespace EE::Render
 
         virtual TVector<TResourcePtr<Render::Material>> const& GetDefaultMaterials() const override final;
 
-        void UpdateBounds();
-        void UpdateSkinningTransforms();
+        // Calculate the skinning palette and the mesh bounds in a single pass over the bone transforms
+        void UpdateBoundsAndSkinningPalette();
         void GenerateAnimationBoneMap();
 
         virtual void Initialize() override;
@@ -90,13 +110,19 @@ namespace EE::Render
         virtual bool TryFindAttachmentSocketTransform( StringID socketID, Transform& outSocketWorldTransform ) const override final;
         virtual bool HasSocket( StringID socketID ) const override final;
 
+        // Called by the renderer world system on registration, allocates the palette from the shared world palette buffer
+        void AllocateSkinningPalette( SkinningPaletteBuffer* pPaletteBuffer );
+        void ReleaseSkinningPalette();
+
     protected:
 
         EE_EXPOSE TResourcePtr<SkeletalMesh>            m_mesh;
         EE_EXPOSE TResourcePtr<Animation::Skeleton>     m_skeleton = nullptr;
         TVector<int32_t>                                m_animToMeshBoneMap;
+        EE_EXPOSE SkinningPaletteFormat                 m_skinningPaletteFormat = SkinningPaletteFormat::Matrix4x4;
         TVector<Transform>                              m_boneTransforms;
-        TVector<Matrix>                                 m_skinningTransforms;
+        SkinningPaletteBuffer*                          m_pSkinningPaletteBuffer = nullptr;
+        SkinningPaletteBuffer::Range                    m_skinningPaletteRange;
     };
 
     //-------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+#include "SkinningPalette.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Render
+{
+    uint32_t SkinningPaletteBuffer::GetRequiredPaletteSize( SkinningPaletteFormat format, int32_t numBones )
+    {
+        EE_ASSERT( numBones > 0 && numBones <= s_maxSupportedBones );
+
+        uint32_t paletteSize = 1;
+        switch ( format )
+        {
+            case SkinningPaletteFormat::Matrix4x4: paletteSize += 4 * numBones; break;
+            case SkinningPaletteFormat::Matrix3x4: paletteSize += 3 * numBones; break;
+            case SkinningPaletteFormat::DualQuaternion: paletteSize += 2 * numBones + ( ( numBones + 3 ) / 4 ); break;
+            default: EE_UNREACHABLE_CODE(); break;
+        }
+
+        return paletteSize;
+    }
+
+    void SkinningPaletteBuffer::WritePaletteHeader( Vector* pPalette, SkinningPaletteFormat format, int32_t numBones )
+    {
+        EE_ASSERT( pPalette != nullptr );
+        int32_t const scalesOffset = ( format == SkinningPaletteFormat::DualQuaternion ) ? 2 * numBones : 0;
+        pPalette[0] = _mm_castsi128_ps( _mm_setr_epi32( (int32_t) format, numBones, scalesOffset, 0 ) );
+    }
+
+    //-------------------------------------------------------------------------
+
+    SkinningPaletteBuffer::~SkinningPaletteBuffer()
+    {
+        #if EE_DEVELOPMENT_TOOLS
+        EE_ASSERT( m_numAllocatedRanges == 0 );
+        #endif
+    }
+
+    SkinningPaletteBuffer::Range SkinningPaletteBuffer::Allocate( SkinningPaletteFormat format, int32_t numBones )
+    {
+        Range range;
+        range.m_size = GetRequiredPaletteSize( format, numBones );
+
+        // Find the smallest free range that fits
+        //-------------------------------------------------------------------------
+
+        int32_t bestFitIdx = InvalidIndex;
+        for ( int32_t i = 0; i < (int32_t) m_freeRanges.size(); i++ )
+        {
+            if ( m_freeRanges[i].m_size >= range.m_size && ( bestFitIdx == InvalidIndex || m_freeRanges[i].m_size < m_freeRanges[bestFitIdx].m_size ) )
+            {
+                bestFitIdx = i;
+            }
+        }
+
+        if ( bestFitIdx != InvalidIndex )
+        {
+            Range& freeRange = m_freeRanges[bestFitIdx];
+            range.m_offset = freeRange.m_offset;
+            freeRange.m_offset += range.m_size;
+            freeRange.m_size -= range.m_size;
+
+            if ( freeRange.m_size == 0 )
+            {
+                m_freeRanges.erase_unsorted( m_freeRanges.begin() + bestFitIdx );
+            }
+        }
+        else // Grow the buffer
+        {
+            range.m_offset = (uint32_t) m_data.size();
+            m_data.resize( m_data.size() + range.m_size, Vector::Zero );
+        }
+
+        //-------------------------------------------------------------------------
+
+        WritePaletteHeader( &m_data[range.m_offset], format, numBones );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_allocatedSize += range.m_size;
+        m_numAllocatedRanges++;
+        #endif
+
+        return range;
+    }
+
+    void SkinningPaletteBuffer::Release( Range& range )
+    {
+        EE_ASSERT( range.IsValid() && ( range.m_offset + range.m_size ) <= m_data.size() );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_allocatedSize -= range.m_size;
+        m_numAllocatedRanges--;
+        #endif
+
+        // Merge with any adjacent free ranges
+        //-------------------------------------------------------------------------
+
+        Range freedRange = range;
+        for ( int32_t i = (int32_t) m_freeRanges.size() - 1; i >= 0; i-- )
+        {
+            Range const& freeRange = m_freeRanges[i];
+            if ( freeRange.m_offset + freeRange.m_size == freedRange.m_offset )
+            {
+                freedRange.m_offset = freeRange.m_offset;
+                freedRange.m_size += freeRange.m_size;
+                m_freeRanges.erase_unsorted( m_freeRanges.begin() + i );
+            }
+            else if ( freedRange.m_offset + freedRange.m_size == freeRange.m_offset )
+            {
+                freedRange.m_size += freeRange.m_size;
+                m_freeRanges.erase_unsorted( m_freeRanges.begin() + i );
+            }
+        }
+
+        // Shrink the buffer if the range is at the end, otherwise keep it for reuse
+        if ( freedRange.m_offset + freedRange.m_size == m_data.size() )
+        {
+            m_data.resize( freedRange.m_offset );
+        }
+        else
+        {
+            m_freeRanges.emplace_back( freedRange );
+        }
+
+        range = Range();
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "System/TypeSystem/RegisteredType.h"
+#include "System/Math/Vector.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Skinning Palette
+//-------------------------------------------------------------------------
+// The skinning palette is the per-bone data uploaded to the skinning vertex shader
+// Every palette starts with a header vector (format, num bones, offset of the packed scales) followed by the per-bone data:
+//
+// Matrix4x4        - 4 vectors per bone (the rows of the full skinning matrix)
+// Matrix3x4        - 3 vectors per bone (the first three columns of the skinning matrix)
+// DualQuaternion   - 2 vectors per bone (real and dual parts) followed by the uniform scales packed 4 per vector
+//
+// All palettes in a world live in a single shared buffer, each mesh component is allocated a range in this buffer
+
+namespace EE::Render
+{
+    enum class SkinningPaletteFormat : uint8_t
+    {
+        EE_REGISTER_ENUM
+
+        Matrix4x4 = 0,
+        Matrix3x4 = 1,
+        DualQuaternion = 2,
+    };
+
+    //-------------------------------------------------------------------------
+
+    class EE_ENGINE_API SkinningPaletteBuffer
+    {
+    public:
+
+        // The max number of bones the skinning shader supports
+        constexpr static int32_t const s_maxSupportedBones = 255;
+
+        struct Range
+        {
+            inline bool IsValid() const { return m_size > 0; }
+
+            uint32_t                        m_offset = 0;
+            uint32_t                        m_size = 0;
+        };
+
+    public:
+
+        // Get the number of vectors needed to store a palette (including the header)
+        static uint32_t GetRequiredPaletteSize( SkinningPaletteFormat format, int32_t numBones );
+
+        // Write the palette header, needs to be done once after allocating the palette
+        static void WritePaletteHeader( Vector* pPalette, SkinningPaletteFormat format, int32_t numBones );
+
+        //-------------------------------------------------------------------------
+
+        ~SkinningPaletteBuffer();
+
+        // Allocate a range for a palette, this is not threadsafe and may move the buffer so it may only be called while no palettes are being written
+        Range Allocate( SkinningPaletteFormat format, int32_t numBones );
+
+        // Release a previously allocated range
+        void Release( Range& range );
+
+        inline Vector* GetPalette( Range const& range ) { EE_ASSERT( range.IsValid() && ( range.m_offset + range.m_size ) <= m_data.size() ); return &m_data[range.m_offset]; }
+        inline Vector const* GetPalette( Range const& range ) const { EE_ASSERT( range.IsValid() && ( range.m_offset + range.m_size ) <= m_data.size() ); return &m_data[range.m_offset]; }
+
+        #if EE_DEVELOPMENT_TOOLS
+        inline uint32_t GetBufferSize() const { return (uint32_t) m_data.size(); }
+        inline uint32_t GetAllocatedSize() const { return m_allocatedSize; }
+        inline int32_t GetNumAllocatedRanges() const { return m_numAllocatedRanges; }
+        #endif
+
+    private:
+
+        TVector<Vector>                     m_data;
+        TVector<Range>                      m_freeRanges;
+
+        #if EE_DEVELOPMENT_TOOLS
+        uint32_t                            m_allocatedSize = 0;
+        int32_t                             m_numAllocatedRanges = 0;
+        #endif
+    };
+}
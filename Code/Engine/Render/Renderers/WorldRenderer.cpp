@@ -95,8 +95,8 @@ namespace EE::Render
         // Create Skeletal Mesh Vertex Shader
         //-------------------------------------------------------------------------
 
-        // Vertex shader constant buffer - contains the world view projection matrix and bone transforms
-        buffer.m_byteSize = sizeof( Matrix ) * 255; // ( 1 WVP matrix + 255 bone matrices )
+        // Vertex shader constant buffer - contains the skinning palette ( 1 header vector + up to 255 bone matrices )
+        buffer.m_byteSize = sizeof( Vector ) * ( 1 + 4 * SkinningPaletteBuffer::s_maxSupportedBones );
         buffer.m_byteStride = sizeof( Matrix ); // Vector4 aligned
         buffer.m_usage = RenderBuffer::Usage::CPU_and_GPU;
         buffer.m_type = RenderBuffer::Type::Constant;
@@ -618,9 +618,8 @@ namespace EE::Render
             renderContext.WriteToBuffer( m_vertexShaderSkeletal.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
             auto const& bonesConstBuffer = m_vertexShaderSkeletal.GetConstBuffer( 1 );
-            auto const& boneTransforms = pMeshComponent->GetSkinningTransforms();
-            EE_ASSERT( boneTransforms.size() == pCurrentMesh->GetNumBones() );
-            renderContext.WriteToBuffer( bonesConstBuffer, boneTransforms.data(), sizeof( Matrix ) * pCurrentMesh->GetNumBones() );
+            EE_ASSERT( pMeshComponent->HasSkinningPalette() );
+            renderContext.WriteToBuffer( bonesConstBuffer, pMeshComponent->GetSkinningPalette(), pMeshComponent->GetSkinningPaletteByteSize() );
 
             if ( renderTarget.HasPickingRT() )
             {
@@ -737,9 +736,8 @@ namespace EE::Render
             renderContext.WriteToBuffer( m_vertexShaderSkeletal.GetConstBuffer( 0 ), &transforms, sizeof( transforms ) );
 
             auto const& bonesConstBuffer = m_vertexShaderSkeletal.GetConstBuffer( 1 );
-            auto const& boneTransforms = pMeshComponent->GetSkinningTransforms();
-            EE_ASSERT( boneTransforms.size() == pMesh->GetNumBones() );
-            renderContext.WriteToBuffer( bonesConstBuffer, boneTransforms.data(), sizeof( Matrix ) * pMesh->GetNumBones() );
+            EE_ASSERT( pMeshComponent->HasSkinningPalette() );
+            renderContext.WriteToBuffer( bonesConstBuffer, pMeshComponent->GetSkinningPalette(), pMeshComponent->GetSkinningPaletteByteSize() );
 
             renderContext.SetVertexBuffer( pMesh->GetVertexBuffer() );
             renderContext.SetIndexBuffer( pMesh->GetIndexBuffer() );
@@ -1,8 +1,14 @@
 #include "Common_Lit.hlsli"
 
+// Matches EE::Render::SkinningPaletteFormat
+#define PALETTE_FORMAT_MATRIX4X4 0
+#define PALETTE_FORMAT_MATRIX3X4 1
+#define PALETTE_FORMAT_DUAL_QUATERNION 2
+
 cbuffer Skeleton : register( b1 )
 {
-    matrix m_boneTransforms[255];
+    uint4 m_paletteHeader; // x: format, y: num bones, z: offset of the packed scales (dual quaternions only)
+    float4 m_palette[1020];
 };
 
 struct VertexShaderInput
@@ -15,20 +21,102 @@ struct VertexShaderInput
     float4 m_boneWeights : BLENDWEIGHTS0;
 };
 
-PixelShaderInput main( VertexShaderInput vsInput )
+//-------------------------------------------------------------------------
+
+void SkinMatrix4x4( VertexShaderInput vsInput, out float3 blendPos, out float3 blendNormal )
 {
-    float3 blendPos = float3(0, 0, 0);
-    float3 blendNormal = float3(0, 0, 0);
+    blendPos = float3( 0, 0, 0 );
+    blendNormal = float3( 0, 0, 0 );
 
     for ( int i = 0; i < 4; ++i )
     {
         if ( vsInput.m_boneIndices[i] != -1 )
         {
-            matrix boneTransform = m_boneTransforms[vsInput.m_boneIndices[i]];
-            blendPos += mul( boneTransform, float4(vsInput.m_pos, 1.0) ).xyz * vsInput.m_boneWeights[i];
-            blendNormal += mul( boneTransform, float4(vsInput.m_normal, 0.0) ).xyz * vsInput.m_boneWeights[i]; // HACK: check idea, assumes orthonormal matrix, without scaling
+            int const rowIdx = vsInput.m_boneIndices[i] * 4;
+            float4x4 boneTransform = float4x4( m_palette[rowIdx], m_palette[rowIdx + 1], m_palette[rowIdx + 2], m_palette[rowIdx + 3] );
+            blendPos += mul( float4( vsInput.m_pos, 1.0 ), boneTransform ).xyz * vsInput.m_boneWeights[i];
+            blendNormal += mul( float4( vsInput.m_normal, 0.0 ), boneTransform ).xyz * vsInput.m_boneWeights[i]; // HACK: check idea, assumes orthonormal matrix, without scaling
         }
     }
+}
+
+void SkinMatrix3x4( VertexShaderInput vsInput, out float3 blendPos, out float3 blendNormal )
+{
+    // Blend the matrices first, each bone stores the first three columns of its skinning matrix
+    float4 blendedColumns[3] = { float4( 0, 0, 0, 0 ), float4( 0, 0, 0, 0 ), float4( 0, 0, 0, 0 ) };
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        if ( vsInput.m_boneIndices[i] != -1 )
+        {
+            int const columnIdx = vsInput.m_boneIndices[i] * 3;
+            blendedColumns[0] += m_palette[columnIdx] * vsInput.m_boneWeights[i];
+            blendedColumns[1] += m_palette[columnIdx + 1] * vsInput.m_boneWeights[i];
+            blendedColumns[2] += m_palette[columnIdx + 2] * vsInput.m_boneWeights[i];
+        }
+    }
+
+    float4 const pos = float4( vsInput.m_pos, 1.0 );
+    float4 const normal = float4( vsInput.m_normal, 0.0 );
+    blendPos = float3( dot( blendedColumns[0], pos ), dot( blendedColumns[1], pos ), dot( blendedColumns[2], pos ) );
+    blendNormal = float3( dot( blendedColumns[0], normal ), dot( blendedColumns[1], normal ), dot( blendedColumns[2], normal ) );
+}
+
+void SkinDualQuaternion( VertexShaderInput vsInput, out float3 blendPos, out float3 blendNormal )
+{
+    float4 blendReal = float4( 0, 0, 0, 0 );
+    float4 blendDual = float4( 0, 0, 0, 0 );
+    float blendScale = 0.0;
+
+    // Flip any quaternions that are not in the same hemisphere as the first influence to ensure we take the shortest path
+    float4 const referenceReal = m_palette[max( vsInput.m_boneIndices[0], 0 ) * 2];
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        if ( vsInput.m_boneIndices[i] != -1 )
+        {
+            int const dqIdx = vsInput.m_boneIndices[i] * 2;
+            float4 const real = m_palette[dqIdx];
+            float const weight = ( dot( real, referenceReal ) < 0.0 ) ? -vsInput.m_boneWeights[i] : vsInput.m_boneWeights[i];
+            blendReal += real * weight;
+            blendDual += m_palette[dqIdx + 1] * weight;
+
+            uint const boneIdx = (uint) vsInput.m_boneIndices[i];
+            blendScale += m_palette[m_paletteHeader.z + ( boneIdx >> 2 )][boneIdx & 3] * vsInput.m_boneWeights[i];
+        }
+    }
+
+    float const invLength = 1.0 / length( blendReal );
+    blendReal *= invLength;
+    blendDual *= invLength;
+
+    // Scale, then rotate and translate
+    float3 const pos = vsInput.m_pos * blendScale;
+    float3 const translation = 2.0 * ( blendReal.w * blendDual.xyz - blendDual.w * blendReal.xyz + cross( blendReal.xyz, blendDual.xyz ) );
+    blendPos = pos + 2.0 * cross( blendReal.xyz, cross( blendReal.xyz, pos ) + blendReal.w * pos ) + translation;
+    blendNormal = vsInput.m_normal + 2.0 * cross( blendReal.xyz, cross( blendReal.xyz, vsInput.m_normal ) + blendReal.w * vsInput.m_normal );
+}
+
+//-------------------------------------------------------------------------
+
+PixelShaderInput main( VertexShaderInput vsInput )
+{
+    float3 blendPos;
+    float3 blendNormal;
+
+    // The format is constant across a draw so this branch is coherent
+    [branch] if ( m_paletteHeader.x == PALETTE_FORMAT_MATRIX3X4 )
+    {
+        SkinMatrix3x4( vsInput, blendPos, blendNormal );
+    }
+    else if ( m_paletteHeader.x == PALETTE_FORMAT_DUAL_QUATERNION )
+    {
+        SkinDualQuaternion( vsInput, blendPos, blendNormal );
+    }
+    else
+    {
+        SkinMatrix4x4( vsInput, blendPos, blendNormal );
+    }
 
     // re-enable if we need support for 8 bone weights
     //for ( int j = 0; j < 4; ++j )
@@ -42,4 +130,4 @@ PixelShaderInput main( VertexShaderInput vsInput )
     //}
 
     return GeneratePixelShaderInput(blendPos, blendNormal, vsInput.m_uv0);
-}
\ No newline at end of file
+}
@@ -209,6 +209,9 @@ namespace EE::Render
 
             auto pMeshGroup = m_skeletalMeshGroups.FindOrAdd( meshID, pMesh );
             pMeshGroup->m_components.emplace_back( pMeshComponent );
+
+            // Allocate the skinning palette from the shared world buffer
+            pMeshComponent->AllocateSkinningPalette( &m_skinningPaletteBuffer );
         }
     }
 
@@ -221,6 +224,8 @@ namespace EE::Render
         // Remove component from mesh group
         if ( pMeshComponent->HasMeshResourceSet() )
         {
+            pMeshComponent->ReleaseSkinningPalette();
+
             uint32_t const meshID = pMeshComponent->GetMesh()->GetResourceID().GetPathID();
             auto pMeshGroup = m_skeletalMeshGroups.Get( meshID );
             pMeshGroup->m_components.erase_first_unsorted( pMeshComponent );
@@ -4,6 +4,7 @@
 #include "Engine/Entity/EntityWorldSystem.h"
 #include "Engine/Render/Components/Component_StaticMesh.h"
 #include "Engine/Render/Mesh/SkeletalMesh.h"
+#include "Engine/Render/Mesh/SkinningPalette.h"
 #include "System/Render/RenderDevice.h"
 #include "System/Math/AABBTree.h"
 #include "System/Types/Event.h"
@@ -114,6 +115,7 @@ namespace EE::Render
         TIDVector<ComponentID, SkeletalMeshComponent*>                  m_registeredSkeletalMeshComponents;
         TIDVector<uint32_t, SkeletalMeshGroup>                          m_skeletalMeshGroups;
         TVector<SkeletalMeshComponent const*>                           m_visibleSkeletalMeshComponents;
+        SkinningPaletteBuffer                                           m_skinningPaletteBuffer;                // The skinning palettes for all registered skeletal meshes
 
         // Lights
         TIDVector<ComponentID, DirectionalLightComponent*>              m_registeredDirectionLightComponents;
@@ -3,6 +3,7 @@
 #include "System/Resource/ResourceProviders/PackagedResourceProvider.h"
 #include "System/Network/NetworkSystem.h"
 #include "Engine/Entity/EntityLog.h"
+#include "Engine/Animation/Systems/AnimationBudgetManager.h"
 
 //-------------------------------------------------------------------------
 
@@ -127,6 +128,13 @@ namespace EE
             return false;
         }
 
+        // Animation update rate budget
+        //-------------------------------------------------------------------------
+
+        Animation::AnimationBudgetManager::Settings animationBudgetSettings;
+        animationBudgetSettings.ReadSettings( iniFile );
+        Animation::AnimationBudgetManager::SetDefaultSettings( animationBudgetSettings );
+
         // Create and initialize render device
         //-------------------------------------------------------------------------
 
@@ -320,6 +328,7 @@ namespace EE
         m_resourceSystem.RegisterResourceLoader( &m_boneMaskLoader );
         m_resourceSystem.RegisterResourceLoader( &m_animationClipLoader );
         m_resourceSystem.RegisterResourceLoader( &m_graphLoader );
+        m_resourceSystem.RegisterResourceLoader( &m_motionDatabaseLoader );
 
         //-------------------------------------------------------------------------
 
@@ -363,6 +372,7 @@ namespace EE
 
         //-------------------------------------------------------------------------
 
+        m_resourceSystem.UnregisterResourceLoader( &m_motionDatabaseLoader );
         m_resourceSystem.UnregisterResourceLoader( &m_animationClipLoader );
         m_resourceSystem.UnregisterResourceLoader( &m_graphLoader );
         m_resourceSystem.UnregisterResourceLoader( &m_boneMaskLoader );
@@ -412,7 +422,7 @@ namespace EE
     {
         m_pPhysicMaterialDB = ResourceID( g_physicsMaterialDatabaseResourceID );
         EE_ASSERT( m_pPhysicMaterialDB.IsSet() );
-        resourceSystem.LoadResource( m_pPhysicMaterialDB );
+        resourceSystem.LoadResource( m_pPhysicMaterialDB, Resource::ResourceRequesterID(), Resource::LoadPriority::Critical );
     }
 
     bool EngineModule::VerifyModuleResourceLoadingComplete()
@@ -14,6 +14,7 @@
 #include "Engine/Animation/ResourceLoaders/AnimationClipLoader.h"
 #include "Engine/Animation/ResourceLoaders/AnimationGraphLoader.h"
 #include "Engine/Animation/ResourceLoaders/AnimationBoneMaskLoader.h"
+#include "Engine/Animation/ResourceLoaders/AnimationMotionDatabaseLoader.h"
 #include "Engine/Navmesh/ResourceLoaders/ResourceLoader_Navmesh.h"
 #include "Engine/Navmesh/NavmeshSystem.h"
 #include "Engine/Render/RendererRegistry.h"
@@ -119,6 +120,7 @@ namespace EE
         Animation::BoneMaskLoader                       m_boneMaskLoader;
         Animation::AnimationClipLoader                  m_animationClipLoader;
         Animation::GraphLoader                          m_graphLoader;
+        Animation::MotionDatabaseLoader                 m_motionDatabaseLoader;
 
         // Physics
         Physics::PhysicsSystem                          m_physicsSystem;
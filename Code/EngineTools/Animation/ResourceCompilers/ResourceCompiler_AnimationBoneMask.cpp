@@ -67,7 +67,7 @@ namespace EE::Animation
         }
 
         RawAssets::ReaderContext readerCtx = { [this]( char const* pString ) { Warning( pString ); }, [this] ( char const* pString ) { Error( pString ); } };
-        auto pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, skeletonResourceDescriptor.m_skeletonRootBoneName );
+        auto pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, skeletonResourceDescriptor.m_skeletonRootBoneName, skeletonResourceDescriptor.m_highLODBones );
         if ( pRawSkeleton == nullptr || !pRawSkeleton->IsValid() )
         {
             return Error( "Failed to read skeleton file: %s", skeletonFilePath.ToString().c_str() );
@@ -21,14 +21,343 @@ namespace EE::Animation
     {
         TypeSystem::TypeDescriptorCollection            m_collection;
         TInlineVector<SyncTrack::EventMarker, 10>       m_syncEventMarkers;
+        TVector<float>                                  m_eventStartTimes;
+        TVector<float>                                  m_eventMaxEndTimes;
     };
 
+    //-------------------------------------------------------------------------
+    // Quantization
+    //-------------------------------------------------------------------------
+
+    // Get the smallest bit-width that can store a value range within the specified error tolerance, a tolerance of zero will use the full 16 bits
+    static uint8_t CalculateQuantizationBitWidth( float rangeLength, float errorTolerance )
+    {
+        static constexpr uint32_t const minBits = 4;
+        static constexpr uint32_t const maxBits = 16;
+
+        if ( errorTolerance <= 0.0f )
+        {
+            return (uint8_t) maxBits;
+        }
+
+        for ( uint32_t numBits = minBits; numBits < maxBits; numBits++ )
+        {
+            if ( Quantization::GetMaxQuantizationError( rangeLength, numBits ) <= errorTolerance )
+            {
+                return (uint8_t) numBits;
+            }
+        }
+
+        return (uint8_t) maxBits;
+    }
+
+    // Packs variable bit-width values into a stream of uint16s, see 'Quantization::ReadPackedBits'
+    class PackedBitWriter
+    {
+    public:
+
+        PackedBitWriter( TVector<uint16_t>& outData ) : m_outData( outData ) {}
+        ~PackedBitWriter() { EE_ASSERT( m_numBufferedBits == 0 ); }
+
+        void Write( uint16_t value, uint32_t numBits )
+        {
+            EE_ASSERT( numBits > 0 && numBits <= 16 && value < ( 1u << numBits ) );
+
+            m_buffer |= uint32_t( value ) << m_numBufferedBits;
+            m_numBufferedBits += numBits;
+
+            while ( m_numBufferedBits >= 16 )
+            {
+                m_outData.push_back( uint16_t( m_buffer & 0xFFFF ) );
+                m_buffer >>= 16;
+                m_numBufferedBits -= 16;
+            }
+        }
+
+        // Write out any remaining bits, padding to the next uint16 boundary
+        void Flush()
+        {
+            if ( m_numBufferedBits > 0 )
+            {
+                m_outData.push_back( uint16_t( m_buffer & 0xFFFF ) );
+                m_buffer = 0;
+                m_numBufferedBits = 0;
+            }
+        }
+
+    private:
+
+        TVector<uint16_t>&  m_outData;
+        uint32_t            m_buffer = 0;
+        uint32_t            m_numBufferedBits = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    // Key Reduction
+    //-------------------------------------------------------------------------
+
+    // Calculate the error distance for each bone i.e. the distance from the bone to the furthest bone in its sub-hierarchy (in the reference pose)
+    // Any error in a bone's transform is amplified for all its children by this distance, so this is where we measure the error for that bone
+    static void CalculateBoneErrorDistances( RawAssets::RawSkeleton const& rawSkeleton, TVector<float>& outErrorDistances )
+    {
+        // Minimum distance to measure error at, this ensures that rotation errors on leaf bones are still accounted for
+        static constexpr float const minimumErrorDistance = 0.1f;
+
+        int32_t const numBones = (int32_t) rawSkeleton.GetNumBones();
+        outErrorDistances.clear();
+        outErrorDistances.resize( numBones, minimumErrorDistance );
+
+        // Children are always stored after their parents so we can propagate the distances up the hierarchy in a single reverse pass
+        for ( int32_t boneIdx = numBones - 1; boneIdx > 0; boneIdx-- )
+        {
+            int32_t const parentIdx = rawSkeleton.GetParentBoneIndex( boneIdx );
+            EE_ASSERT( parentIdx < boneIdx );
+
+            float const boneLength = rawSkeleton.GetGlobalTransform( boneIdx ).GetTranslation().GetDistance3( rawSkeleton.GetGlobalTransform( parentIdx ).GetTranslation() );
+            outErrorDistances[parentIdx] = Math::Max( outErrorDistances[parentIdx], boneLength + outErrorDistances[boneIdx] );
+        }
+    }
+
+    // Calculate the character space error introduced by approximating a bone's local transform
+    // The error is measured at a set of points around the bone at the bone's error distance and scaled by the parent's character space scale
+    static float CalculateTransformError( Transform const& rawTransform, Transform const& approximateTransform, float errorDistance, float parentScale )
+    {
+        Vector const testPoints[6] =
+        {
+            Vector( errorDistance, 0, 0 ), Vector( -errorDistance, 0, 0 ),
+            Vector( 0, errorDistance, 0 ), Vector( 0, -errorDistance, 0 ),
+            Vector( 0, 0, errorDistance ), Vector( 0, 0, -errorDistance ),
+        };
+
+        float maxError = 0.0f;
+        for ( auto const& testPoint : testPoints )
+        {
+            float const error = rawTransform.TransformPoint( testPoint ).GetDistance3( approximateTransform.TransformPoint( testPoint ) );
+            maxError = Math::Max( maxError, error );
+        }
+
+        return maxError * Math::Abs( parentScale );
+    }
+
+    // Calculate the number of bones in the longest root-to-leaf chain that passes through each bone as well as each bone's depth in the hierarchy
+    // The key reduction error tolerance is split down these chains since the errors of all the bones in a chain accumulate at the leaf
+    static void CalculateBoneChainLengths( RawAssets::RawSkeleton const& rawSkeleton, TVector<int32_t>& outDepths, TVector<int32_t>& outChainLengths )
+    {
+        int32_t const numBones = (int32_t) rawSkeleton.GetNumBones();
+        outDepths.clear();
+        outDepths.resize( numBones, 0 );
+
+        TVector<int32_t> heights;
+        heights.resize( numBones, 0 );
+
+        for ( int32_t boneIdx = 1; boneIdx < numBones; boneIdx++ )
+        {
+            outDepths[boneIdx] = outDepths[rawSkeleton.GetParentBoneIndex( boneIdx )] + 1;
+        }
+
+        for ( int32_t boneIdx = numBones - 1; boneIdx > 0; boneIdx-- )
+        {
+            int32_t const parentIdx = rawSkeleton.GetParentBoneIndex( boneIdx );
+            heights[parentIdx] = Math::Max( heights[parentIdx], heights[boneIdx] + 1 );
+        }
+
+        outChainLengths.clear();
+        outChainLengths.resize( numBones );
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            outChainLengths[boneIdx] = outDepths[boneIdx] + heights[boneIdx] + 1;
+        }
+    }
+
+    // Find the set of key frames needed to reproduce the bone track (via interpolation) within the specified character space error tolerance
+    // The first and last frames are always kept, additional keys are added where the interpolated error is largest until the track is within tolerance
+    //
+    // For regular clips, the error is measured on the reconstructed character space pose i.e. the approximated local transform is applied to the parent's
+    // reconstructed (already reduced) global transform and compared against the raw global transform, so the error includes the error of all the ancestors
+    //
+    // For additive clips, there is no meaningful character space pose so the error is measured on the local transform only and the caller needs to split the tolerance
+    // across the chain. The stored scale is a delta (i.e. zero for no change) so we measure the error as if the delta was applied to a unit scale
+    static void ReduceTrackKeyFrames( RawAssets::RawAnimation const& rawAnimData, int32_t boneIdx, float errorDistance, float errorTolerance, bool isAdditive, TVector<Transform> const* pParentReconstructedGlobalTransforms, TVector<uint16_t>& outKeyFrameIndices )
+    {
+        EE_ASSERT( isAdditive || pParentReconstructedGlobalTransforms != nullptr || boneIdx == 0 );
+
+        auto const& rawTrackData = rawAnimData.GetTrackData();
+        auto const& localTransforms = rawTrackData[boneIdx].m_localTransforms;
+        auto const& globalTransforms = rawTrackData[boneIdx].m_globalTransforms;
+        int32_t const parentIdx = rawAnimData.GetSkeleton().GetParentBoneIndex( boneIdx );
+        int32_t const numFrames = (int32_t) rawAnimData.GetNumFrames();
+        EE_ASSERT( numFrames > 1 );
+
+        TVector<bool> isKeyFrame( numFrames, false );
+        isKeyFrame.front() = true;
+        isKeyFrame.back() = true;
+
+        TInlineVector<IntRange, 32> rangesToProcess;
+        rangesToProcess.emplace_back( IntRange( 0, numFrames - 1 ) );
+
+        while ( !rangesToProcess.empty() )
+        {
+            IntRange const range = rangesToProcess.back();
+            rangesToProcess.pop_back();
+
+            if ( ( range.m_end - range.m_begin ) < 2 )
+            {
+                continue;
+            }
+
+            // Find the frame with the largest interpolation error in this range
+            int32_t maxErrorFrameIdx = InvalidIndex;
+            float maxError = 0.0f;
+            float const rangeLength = float( range.m_end - range.m_begin );
+            for ( int32_t frameIdx = range.m_begin + 1; frameIdx < range.m_end; frameIdx++ )
+            {
+                float const t = float( frameIdx - range.m_begin ) / rangeLength;
+                Transform approximateTransform = Transform::Slerp( localTransforms[range.m_begin], localTransforms[range.m_end], t );
+
+                float error = 0.0f;
+                if ( isAdditive )
+                {
+                    Transform rawTransform = localTransforms[frameIdx];
+                    approximateTransform.SetScale( approximateTransform.GetScale() + 1.0f );
+                    rawTransform.SetScale( rawTransform.GetScale() + 1.0f );
+
+                    float const parentScale = ( parentIdx == InvalidIndex ) ? 1.0f : rawTrackData[parentIdx].m_globalTransforms[frameIdx].GetScale();
+                    error = CalculateTransformError( rawTransform, approximateTransform, errorDistance, parentScale );
+                }
+                else
+                {
+                    Transform const approximateGlobalTransform = ( parentIdx == InvalidIndex ) ? approximateTransform : approximateTransform * ( *pParentReconstructedGlobalTransforms )[frameIdx];
+                    error = CalculateTransformError( globalTransforms[frameIdx], approximateGlobalTransform, errorDistance, 1.0f );
+                }
+
+                if ( error > maxError )
+                {
+                    maxError = error;
+                    maxErrorFrameIdx = frameIdx;
+                }
+            }
+
+            // Split the range at the worst frame
+            if ( maxError > errorTolerance )
+            {
+                isKeyFrame[maxErrorFrameIdx] = true;
+                rangesToProcess.emplace_back( IntRange( range.m_begin, maxErrorFrameIdx ) );
+                rangesToProcess.emplace_back( IntRange( maxErrorFrameIdx, range.m_end ) );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        outKeyFrameIndices.clear();
+        for ( int32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+        {
+            if ( isKeyFrame[frameIdx] )
+            {
+                outKeyFrameIndices.emplace_back( (uint16_t) frameIdx );
+            }
+        }
+    }
+
+    // Reconstruct the global transforms for a bone as they will be sampled at runtime, i.e. interpolated between the kept key frames (or every frame for dense tracks)
+    static void ReconstructGlobalTransforms( RawAssets::RawAnimation const& rawAnimData, int32_t boneIdx, TVector<uint16_t> const& keyFrameIndices, TVector<Transform> const* pParentReconstructedGlobalTransforms, TVector<Transform>& outGlobalTransforms )
+    {
+        auto const& localTransforms = rawAnimData.GetTrackData()[boneIdx].m_localTransforms;
+        int32_t const numFrames = (int32_t) rawAnimData.GetNumFrames();
+
+        outGlobalTransforms.resize( numFrames );
+
+        int32_t keyIdx = 0;
+        for ( int32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+        {
+            Transform localTransform = localTransforms[frameIdx];
+
+            if ( !keyFrameIndices.empty() )
+            {
+                while ( keyFrameIndices[keyIdx + 1] < frameIdx )
+                {
+                    keyIdx++;
+                }
+
+                int32_t const startFrameIdx = keyFrameIndices[keyIdx];
+                int32_t const endFrameIdx = keyFrameIndices[keyIdx + 1];
+                float const t = float( frameIdx - startFrameIdx ) / float( endFrameIdx - startFrameIdx );
+                localTransform = Transform::Slerp( localTransforms[startFrameIdx], localTransforms[endFrameIdx], t );
+            }
+
+            outGlobalTransforms[frameIdx] = ( pParentReconstructedGlobalTransforms == nullptr ) ? localTransform : localTransform * ( *pParentReconstructedGlobalTransforms )[frameIdx];
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    // Additive
+    //-------------------------------------------------------------------------
+
+    // Convert the local transforms into additive deltas i.e. base * delta = animated, translations and scales are stored as offsets
+    static void ConvertToAdditive( AdditiveType additiveType, RawAssets::RawAnimation& rawAnimData )
+    {
+        EE_ASSERT( additiveType != AdditiveType::None );
+
+        auto& rawTrackData = rawAnimData.GetTrackData();
+        uint32_t const numBones = rawAnimData.GetNumBones();
+        uint32_t const numFrames = rawAnimData.GetNumFrames();
+
+        for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            auto& localTransforms = rawTrackData[boneIdx].m_localTransforms;
+
+            // The root track is always identity since its motion is extracted into the root motion
+            if ( boneIdx == 0 )
+            {
+                for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+                {
+                    localTransforms[frameIdx] = Transform( Quaternion::Identity, Vector::Zero, 0.0f );
+                }
+                continue;
+            }
+
+            Transform const baseTransform = ( additiveType == AdditiveType::RelativeToSkeleton ) ? rawAnimData.GetSkeleton().GetLocalTransform( boneIdx ) : localTransforms[0];
+            Quaternion const inverseBaseRotation = baseTransform.GetRotation().GetInverse();
+
+            for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+            {
+                Transform const& animatedTransform = localTransforms[frameIdx];
+                Quaternion const deltaRotation = ( inverseBaseRotation * animatedTransform.GetRotation() ).GetNormalized();
+                Vector const deltaTranslation = animatedTransform.GetTranslation() - baseTransform.GetTranslation();
+                float const deltaScale = animatedTransform.GetScale() - baseTransform.GetScale();
+                localTransforms[frameIdx] = Transform( deltaRotation, deltaTranslation, deltaScale );
+            }
+        }
+
+        rawAnimData.CalculateComponentRanges();
+    }
+
+    // Is this additive track a no-op for the whole clip, i.e. identity rotation, zero translation and zero scale offset on every frame
+    static bool IsIdentityAdditiveTrack( TVector<Transform> const& localTransforms, float translationTolerance, float rotationTolerance, float scaleTolerance )
+    {
+        float const minRotationW = Math::Cos( rotationTolerance * 0.5f );
+        for ( auto const& transform : localTransforms )
+        {
+            if ( Math::Abs( transform.GetRotation().AsVector().GetW() ) < minRotationW )
+            {
+                return false;
+            }
+
+            if ( transform.GetTranslation().GetLength3() > translationTolerance || Math::Abs( transform.GetScale() ) > scaleTolerance )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     //-------------------------------------------------------------------------
 
     AnimationClipCompiler::AnimationClipCompiler()
         : Resource::Compiler( "AnimationCompiler", s_version )
     {
         m_outputTypes.push_back( AnimationClip::GetStaticResourceTypeID() );
+        m_compressionType = Resource::CompressionType::LZ4;
     }
 
     Resource::CompilationResult AnimationClipCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -91,7 +420,7 @@ namespace EE::Animation
         }
 
         RawAssets::ReaderContext readerCtx = { [this]( char const* pString ) { Warning( pString ); }, [this] ( char const* pString ) { Error( pString ); } };
-        auto pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, skeletonResourceDescriptor.m_skeletonRootBoneName );
+        auto pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, skeletonResourceDescriptor.m_skeletonRootBoneName, skeletonResourceDescriptor.m_highLODBones );
         if ( pRawSkeleton == nullptr || !pRawSkeleton->IsValid() )
         {
             return Error( "Failed to read skeleton file: %s", skeletonFilePath.ToString().c_str() );
@@ -114,13 +443,18 @@ namespace EE::Animation
             }
         }
 
+        if ( resourceDescriptor.m_additiveType != AdditiveType::None )
+        {
+            ConvertToAdditive( resourceDescriptor.m_additiveType, *pRawAnimation );
+        }
+
         // Reflect raw animation data into runtime format
         //-------------------------------------------------------------------------
 
         AnimationClip animData;
         animData.m_skeleton = resourceDescriptor.m_skeleton;
 
-        TransferAndCompressAnimationData( *pRawAnimation, animData );
+        TransferAndCompressAnimationData( resourceDescriptor, *pRawAnimation, animData );
 
         // Handle events
         //-------------------------------------------------------------------------
@@ -131,6 +465,9 @@ namespace EE::Animation
             return CompilationFailed( ctx );
         }
 
+        animData.m_eventStartTimes = eventData.m_eventStartTimes;
+        animData.m_eventMaxEndTimes = eventData.m_eventMaxEndTimes;
+
         // Serialize animation data
         //-------------------------------------------------------------------------
 
@@ -235,7 +572,7 @@ namespace EE::Animation
         return true;
     }
 
-    void AnimationClipCompiler::TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const
+    void AnimationClipCompiler::TransferAndCompressAnimationData( AnimationClipResourceDescriptor const& resourceDescriptor, RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const
     {
         auto const& rawTrackData = rawAnimData.GetTrackData();
         uint32_t const numBones = rawAnimData.GetNumBones();
@@ -247,6 +584,23 @@ namespace EE::Animation
         animClip.m_numFrames = rawAnimData.GetNumFrames();
         animClip.m_duration = ( animClip.IsSingleFrameAnimation() ) ? 0.0f : rawAnimData.GetDuration();
         animClip.m_rootMotion.m_transforms = rawAnimData.GetRootMotion();
+        animClip.m_rootMotion.Compress();
+        animClip.m_isAdditive = ( resourceDescriptor.m_additiveType != AdditiveType::None );
+
+        // Additive clips only need to be blended for the tracks that actually do something
+        //-------------------------------------------------------------------------
+
+        animClip.m_activeAdditiveBoneIndices.clear();
+        if ( animClip.m_isAdditive )
+        {
+            for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            {
+                if ( !IsIdentityAdditiveTrack( rawTrackData[boneIdx].m_localTransforms, resourceDescriptor.m_additiveIdentityTranslationTolerance, resourceDescriptor.m_additiveIdentityRotationTolerance, resourceDescriptor.m_additiveIdentityScaleTolerance ) )
+                {
+                    animClip.m_activeAdditiveBoneIndices.emplace_back( (uint16_t) boneIdx );
+                }
+            }
+        }
 
         // Calculate root motion extra data
         //-------------------------------------------------------------------------
@@ -276,33 +630,19 @@ namespace EE::Animation
         animClip.m_rootMotion.m_averageLinearVelocity = totalDistance / animClip.GetDuration();
         animClip.m_rootMotion.m_averageAngularVelocity = totalRotation / animClip.GetDuration();
 
-        // Compress raw data
+        // Calculate track compression settings
         //-------------------------------------------------------------------------
 
         static constexpr float const defaultQuantizationRangeLength = 0.1f;
 
+        // Rotations and translations are 48bits (3 x uint16_t), scales are 16bits (1 x uint16_t)
+        static constexpr uint32_t const translationStride = 3;
+        static constexpr uint32_t const scaleStride = 1;
+
         for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
         {
             TrackCompressionSettings trackSettings;
 
-            // Record offset into data for this track
-            trackSettings.m_trackStartIndex = (uint32_t) animClip.m_compressedPoseData.size();
-
-            //-------------------------------------------------------------------------
-            // Rotation
-            //-------------------------------------------------------------------------
-
-            for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
-            {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[frameIdx];
-                Quaternion const rotation = rawBoneTransform.GetRotation();
-
-                Quantization::EncodedQuaternion const encodedQuat( rotation );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData0() );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData1() );
-                animClip.m_compressedPoseData.push_back( encodedQuat.GetData2() );
-            }
-
             //-------------------------------------------------------------------------
             // Translation
             //-------------------------------------------------------------------------
@@ -334,38 +674,6 @@ namespace EE::Animation
                 trackSettings.m_translationRangeZ = { rawTranslationValueRangeZ.m_begin, Math::IsNearZero( rawTranslationValueRangeLengthZ ) ? defaultQuantizationRangeLength : rawTranslationValueRangeLengthZ };
             }
 
-            //-------------------------------------------------------------------------
-
-            if ( trackSettings.IsTranslationTrackStatic() )
-            {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[0];
-                Vector const& translation = rawBoneTransform.GetTranslation();
-
-                uint16_t const m_x = Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength );
-                uint16_t const m_y = Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
-                uint16_t const m_z = Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
-
-                animClip.m_compressedPoseData.push_back( m_x );
-                animClip.m_compressedPoseData.push_back( m_y );
-                animClip.m_compressedPoseData.push_back( m_z );
-            }
-            else // Store all frames
-            {
-                for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
-                {
-                    Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[frameIdx];
-                    Vector const& translation = rawBoneTransform.GetTranslation();
-
-                    uint16_t const m_x = Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength );
-                    uint16_t const m_y = Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
-                    uint16_t const m_z = Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
-
-                    animClip.m_compressedPoseData.push_back( m_x );
-                    animClip.m_compressedPoseData.push_back( m_y );
-                    animClip.m_compressedPoseData.push_back( m_z );
-                }
-            }
-
             //-------------------------------------------------------------------------
             // Scale
             //-------------------------------------------------------------------------
@@ -387,26 +695,275 @@ namespace EE::Animation
             }
 
             //-------------------------------------------------------------------------
+            // Bit-widths
+            //-------------------------------------------------------------------------
+            // Use the smallest bit-width for each animated component that keeps the quantization error within tolerance
+
+            if ( !trackSettings.m_isTranslationStatic )
+            {
+                // The tolerance applies to the translation as a whole, so split it across the components
+                float const componentErrorTolerance = resourceDescriptor.m_quantizationErrorTolerance / Math::Sqrt( 3.0f );
+                trackSettings.m_translationBitsX = CalculateQuantizationBitWidth( trackSettings.m_translationRangeX.m_rangeLength, componentErrorTolerance );
+                trackSettings.m_translationBitsY = CalculateQuantizationBitWidth( trackSettings.m_translationRangeY.m_rangeLength, componentErrorTolerance );
+                trackSettings.m_translationBitsZ = CalculateQuantizationBitWidth( trackSettings.m_translationRangeZ.m_rangeLength, componentErrorTolerance );
+            }
+
+            if ( !trackSettings.m_isScaleStatic )
+            {
+                trackSettings.m_scaleBits = CalculateQuantizationBitWidth( trackSettings.m_scaleRange.m_rangeLength, resourceDescriptor.m_quantizationErrorTolerance );
+            }
+
+            //-------------------------------------------------------------------------
+
+            animClip.m_trackCompressionSettings.emplace_back( trackSettings );
+        }
+
+        // Key reduction
+        //-------------------------------------------------------------------------
+        // Remove any key frames that can be reconstructed via interpolation within the error tolerance. Tracks that benefit from this are stored sparsely.
+
+        TVector<TVector<uint16_t>> sparseTrackKeyFrameIndices;
+        sparseTrackKeyFrameIndices.resize( numBones );
+
+        if ( resourceDescriptor.m_keyReductionErrorTolerance > 0.0f && numFrames > 2 )
+        {
+            EE_ASSERT( numFrames <= 0xFFFF );
+
+            TVector<float> boneErrorDistances;
+            CalculateBoneErrorDistances( rawAnimData.GetSkeleton(), boneErrorDistances );
+
+            TVector<int32_t> boneDepths;
+            TVector<int32_t> boneChainLengths;
+            CalculateBoneChainLengths( rawAnimData.GetSkeleton(), boneDepths, boneChainLengths );
+
+            // The reconstructed global transforms for every bone, only needed for non-additive clips since we measure the error on the reconstructed pose
+            TVector<TVector<Transform>> reconstructedGlobalTransforms;
+            if ( !animClip.m_isAdditive )
+            {
+                reconstructedGlobalTransforms.resize( numBones );
+            }
+
+            TVector<uint16_t> keyFrameIndices;
+            for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            {
+                // Split the tolerance down the chain:
+                // * Additive clips measure each bone's error in isolation so each bone in a chain gets an equal share of the tolerance
+                // * Regular clips measure the accumulated error of the chain so each bone is allowed the share of its ancestors plus its own, this always leaves headroom for the children
+                float const toleranceShare = resourceDescriptor.m_keyReductionErrorTolerance / boneChainLengths[boneIdx];
+                float const boneErrorTolerance = animClip.m_isAdditive ? toleranceShare : toleranceShare * ( boneDepths[boneIdx] + 1 );
+
+                int32_t const parentIdx = rawAnimData.GetSkeleton().GetParentBoneIndex( boneIdx );
+                TVector<Transform> const* pParentReconstructedGlobalTransforms = ( animClip.m_isAdditive || parentIdx == InvalidIndex ) ? nullptr : &reconstructedGlobalTransforms[parentIdx];
+
+                ReduceTrackKeyFrames( rawAnimData, boneIdx, boneErrorDistances[boneIdx], boneErrorTolerance, animClip.m_isAdditive, pParentReconstructedGlobalTransforms, keyFrameIndices );
+
+                // Only store the track sparsely if it actually saves memory, sparse keys need to store their frame index
+                uint32_t const keyStride = animClip.m_trackCompressionSettings[boneIdx].GetKeyStride();
+                uint32_t const sparseTrackSize = (uint32_t) keyFrameIndices.size() * ( keyStride + 1 );
+                uint32_t const denseTrackSize = numFrames * keyStride;
+                if ( sparseTrackSize < denseTrackSize )
+                {
+                    sparseTrackKeyFrameIndices[boneIdx] = keyFrameIndices;
+                }
+
+                if ( !animClip.m_isAdditive )
+                {
+                    ReconstructGlobalTransforms( rawAnimData, boneIdx, sparseTrackKeyFrameIndices[boneIdx], pParentReconstructedGlobalTransforms, reconstructedGlobalTransforms[boneIdx] );
+                }
+            }
+        }
+
+        // Calculate data offsets
+        //-------------------------------------------------------------------------
+        // Static values are stored once in the static data block, dense tracks are stored in each frame block, sparse tracks are stored after the frame blocks
+
+        uint32_t staticDataSize = 0;
+        uint32_t frameDataStride = 0;
+
+        for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            TrackCompressionSettings& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+            trackSettings.m_staticDataOffset = staticDataSize;
+
+            if ( trackSettings.IsTranslationTrackStatic() )
+            {
+                staticDataSize += translationStride;
+            }
 
             if ( trackSettings.IsScaleTrackStatic() )
             {
-                Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[0];
-                uint16_t const m_x = Quantization::EncodeFloat( rawBoneTransform.GetScale(), trackSettings.m_scaleRange.m_rangeStart, trackSettings.m_scaleRange.m_rangeLength );
-                animClip.m_compressedPoseData.push_back( m_x );
+                staticDataSize += scaleStride;
             }
-            else // Store all frames
+
+            if ( sparseTrackKeyFrameIndices[boneIdx].empty() )
             {
+                trackSettings.m_frameDataOffset = frameDataStride;
+                frameDataStride += trackSettings.GetKeyStride();
+                animClip.m_denseTrackIndices.emplace_back( (uint16_t) boneIdx );
+            }
+            else
+            {
+                trackSettings.m_numSparseKeys = (uint16_t) sparseTrackKeyFrameIndices[boneIdx].size();
+                animClip.m_sparseTrackIndices.emplace_back( (uint16_t) boneIdx );
+            }
+        }
+
+        animClip.m_frameDataStartIndex = staticDataSize;
+        animClip.m_frameDataStride = frameDataStride;
+        animClip.m_compressedPoseData.reserve( staticDataSize + ( frameDataStride * numFrames ) );
+
+        // Write a single key (rotation + bit-packed animated translation/scale)
+        //-------------------------------------------------------------------------
+
+        auto WriteTranslation = [&animClip] ( TrackCompressionSettings const& trackSettings, Vector const& translation )
+        {
+            uint16_t const m_x = Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength );
+            uint16_t const m_y = Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
+            uint16_t const m_z = Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
+
+            animClip.m_compressedPoseData.push_back( m_x );
+            animClip.m_compressedPoseData.push_back( m_y );
+            animClip.m_compressedPoseData.push_back( m_z );
+        };
+
+        auto WriteScale = [&animClip] ( TrackCompressionSettings const& trackSettings, float scale )
+        {
+            uint16_t const m_x = Quantization::EncodeFloat( scale, trackSettings.m_scaleRange.m_rangeStart, trackSettings.m_scaleRange.m_rangeLength );
+            animClip.m_compressedPoseData.push_back( m_x );
+        };
+
+        auto WriteKey = [&] ( TrackCompressionSettings const& trackSettings, Transform const& rawBoneTransform )
+        {
+            Quantization::EncodedQuaternion const encodedQuat( rawBoneTransform.GetRotation() );
+            animClip.m_compressedPoseData.push_back( encodedQuat.GetData0() );
+            animClip.m_compressedPoseData.push_back( encodedQuat.GetData1() );
+            animClip.m_compressedPoseData.push_back( encodedQuat.GetData2() );
+
+            PackedBitWriter bitWriter( animClip.m_compressedPoseData );
+
+            if ( !trackSettings.IsTranslationTrackStatic() )
+            {
+                Vector const& translation = rawBoneTransform.GetTranslation();
+                bitWriter.Write( Quantization::EncodeFloat( translation.m_x, trackSettings.m_translationRangeX.m_rangeStart, trackSettings.m_translationRangeX.m_rangeLength, trackSettings.m_translationBitsX ), trackSettings.m_translationBitsX );
+                bitWriter.Write( Quantization::EncodeFloat( translation.m_y, trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength, trackSettings.m_translationBitsY ), trackSettings.m_translationBitsY );
+                bitWriter.Write( Quantization::EncodeFloat( translation.m_z, trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength, trackSettings.m_translationBitsZ ), trackSettings.m_translationBitsZ );
+            }
+
+            if ( !trackSettings.IsScaleTrackStatic() )
+            {
+                bitWriter.Write( Quantization::EncodeFloat( rawBoneTransform.GetScale(), trackSettings.m_scaleRange.m_rangeStart, trackSettings.m_scaleRange.m_rangeLength, trackSettings.m_scaleBits ), trackSettings.m_scaleBits );
+            }
+
+            bitWriter.Flush();
+        };
+
+        // Write static data block
+        //-------------------------------------------------------------------------
+
+        for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+            EE_ASSERT( trackSettings.m_staticDataOffset == animClip.m_compressedPoseData.size() );
+
+            Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[0];
+
+            if ( trackSettings.IsTranslationTrackStatic() )
+            {
+                WriteTranslation( trackSettings, rawBoneTransform.GetTranslation() );
+            }
+
+            if ( trackSettings.IsScaleTrackStatic() )
+            {
+                WriteScale( trackSettings, rawBoneTransform.GetScale() );
+            }
+        }
+
+        EE_ASSERT( animClip.m_compressedPoseData.size() == animClip.m_frameDataStartIndex );
+
+        // Write frame blocks
+        //-------------------------------------------------------------------------
+        // All the tracks for a given frame are stored together so that sampling a frame touches a single contiguous block
+
+        for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
+        {
+            for ( uint16_t const boneIdx : animClip.m_denseTrackIndices )
+            {
+                TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+                EE_ASSERT( ( animClip.m_frameDataStartIndex + ( frameIdx * frameDataStride ) + trackSettings.m_frameDataOffset ) == animClip.m_compressedPoseData.size() );
+                WriteKey( trackSettings, rawTrackData[boneIdx].m_localTransforms[frameIdx] );
+            }
+        }
+
+        // Write sparse tracks
+        //-------------------------------------------------------------------------
+        // Each sparse track stores its key frame indices followed by the key data
+
+        for ( uint16_t const boneIdx : animClip.m_sparseTrackIndices )
+        {
+            TrackCompressionSettings& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+            trackSettings.m_sparseDataOffset = (uint32_t) animClip.m_compressedPoseData.size();
+
+            TVector<uint16_t> const& keyFrameIndices = sparseTrackKeyFrameIndices[boneIdx];
+            for ( uint16_t const keyFrameIdx : keyFrameIndices )
+            {
+                animClip.m_compressedPoseData.push_back( keyFrameIdx );
+            }
+
+            for ( uint16_t const keyFrameIdx : keyFrameIndices )
+            {
+                WriteKey( trackSettings, rawTrackData[boneIdx].m_localTransforms[keyFrameIdx] );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Compression report
+        //-------------------------------------------------------------------------
+        // Compare against the raw data and a fixed 16bit encoding with no key reduction, and optionally measure the actual error for each bone
+
+        uint32_t const rawDataSize = numBones * numFrames * 8 * (uint32_t) sizeof( float );
+        uint32_t fixedQuantizationDataSize = staticDataSize;
+        for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+            fixedQuantizationDataSize += numFrames * ( 3 + ( trackSettings.IsTranslationTrackStatic() ? 0 : translationStride ) + ( trackSettings.IsScaleTrackStatic() ? 0 : scaleStride ) );
+        }
+
+        uint32_t const compressedDataSize = (uint32_t) animClip.m_compressedPoseData.size();
+        Message( "Compression report: raw %u bytes, 16bit quantized %u bytes, compressed %u bytes (%u of %u tracks key-reduced)", rawDataSize, fixedQuantizationDataSize * (uint32_t) sizeof( uint16_t ), compressedDataSize * (uint32_t) sizeof( uint16_t ), (uint32_t) animClip.m_sparseTrackIndices.size(), numBones );
+
+        if ( animClip.m_isAdditive )
+        {
+            Message( "Additive clip: %u of %u tracks active", (uint32_t) animClip.m_activeAdditiveBoneIndices.size(), numBones );
+        }
+
+        // Per-bone details are only output on request since they generate a lot of log spam for large skeletons
+        if ( resourceDescriptor.m_outputDetailedCompressionReport )
+        {
+            for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            {
+                TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+
+                float maxTranslationError = 0.0f;
+                float maxRotationError = 0.0f;
+                float maxScaleError = 0.0f;
+
+                Transform decodedTransform;
                 for ( uint32_t frameIdx = 0; frameIdx < numFrames; frameIdx++ )
                 {
                     Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[frameIdx];
-                    uint16_t const m_x = Quantization::EncodeFloat( rawBoneTransform.GetScale(), trackSettings.m_scaleRange.m_rangeStart, trackSettings.m_scaleRange.m_rangeLength );
-                    animClip.m_compressedPoseData.push_back( m_x );
-                }
-            }
+                    animClip.ReadCompressedTrackKeyFrame( trackSettings, frameIdx, decodedTransform );
 
-            //-------------------------------------------------------------------------
+                    maxTranslationError = Math::Max( maxTranslationError, rawBoneTransform.GetTranslation().GetDistance3( decodedTransform.GetTranslation() ) );
+                    maxRotationError = Math::Max( maxRotationError, Quaternion::Distance( rawBoneTransform.GetRotation(), decodedTransform.GetRotation() ).ToDegrees().ToFloat() );
+                    maxScaleError = Math::Max( maxScaleError, Math::Abs( rawBoneTransform.GetScale() - decodedTransform.GetScale() ) );
+                }
 
-            animClip.m_trackCompressionSettings.emplace_back( trackSettings );
+                Message( "    %s - bits (T: %u/%u/%u, S: %u), keys: %u, max error (T: %.6fm, R: %.4fdeg, S: %.6f)", rawAnimData.GetSkeleton().GetBoneName( boneIdx ).c_str(),
+                    trackSettings.IsTranslationTrackStatic() ? 0 : trackSettings.m_translationBitsX, trackSettings.IsTranslationTrackStatic() ? 0 : trackSettings.m_translationBitsY, trackSettings.IsTranslationTrackStatic() ? 0 : trackSettings.m_translationBitsZ,
+                    trackSettings.IsScaleTrackStatic() ? 0 : trackSettings.m_scaleBits, trackSettings.IsSparseTrack() ? trackSettings.m_numSparseKeys : numFrames,
+                    maxTranslationError, maxRotationError, maxScaleError );
+            }
         }
     }
 
@@ -548,9 +1105,16 @@ namespace EE::Animation
 
         eastl::sort( events.begin(), events.end(), sortPredicate );
 
+        float maxEndTime = 0.0f;
         for ( auto const& pEvent : events )
         {
             outEventData.m_collection.m_descriptors.emplace_back( TypeSystem::TypeDescriptor( *m_pTypeRegistry, pEvent ) );
+
+            // Build the event time index, used to speed up range queries at runtime
+            FloatRange const eventTimeRange = pEvent->GetTimeRange();
+            maxEndTime = Math::Max( maxEndTime, eventTimeRange.m_end );
+            outEventData.m_eventStartTimes.emplace_back( eventTimeRange.m_begin );
+            outEventData.m_eventMaxEndTimes.emplace_back( maxEndTime );
         }
 
         eastl::sort( outEventData.m_syncEventMarkers.begin(), outEventData.m_syncEventMarkers.end() );
@@ -20,7 +20,7 @@ namespace EE::Animation
     class AnimationClipCompiler : public Resource::Compiler
     {
         EE_REGISTER_TYPE( AnimationClipCompiler );
-        static const int32_t s_version = 31;
+        static const int32_t s_version = 38;
 
     public:
 
@@ -31,7 +31,7 @@ namespace EE::Animation
         virtual Resource::CompilationResult Compile( Resource::CompileContext const& ctx ) const final;
         virtual bool GetReferencedResources( ResourceID const& resourceID, TVector<ResourceID>& outReferencedResources ) const override;
 
-        void TransferAndCompressAnimationData( RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const;
+        void TransferAndCompressAnimationData( AnimationClipResourceDescriptor const& resourceDescriptor, RawAssets::RawAnimation const& rawAnimData, AnimationClip& animClip ) const;
 
         bool ReadEventsData( Resource::CompileContext const& ctx, rapidjson::Document const& document, RawAssets::RawAnimation const& rawAnimData, AnimationClipEventData& outEventData ) const;
 
@@ -0,0 +1,388 @@
+#include "ResourceCompiler_AnimationMotionDatabase.h"
+#include "EngineTools/Animation/ResourceDescriptors/ResourceDescriptor_AnimationMotionDatabase.h"
+#include "EngineTools/Animation/ResourceDescriptors/ResourceDescriptor_AnimationClip.h"
+#include "EngineTools/Animation/ResourceDescriptors/ResourceDescriptor_AnimationSkeleton.h"
+#include "EngineTools/RawAssets/RawAssetReader.h"
+#include "EngineTools/RawAssets/RawAnimation.h"
+#include "EngineTools/RawAssets/RawSkeleton.h"
+#include "Engine/Animation/AnimationMotionDatabase.h"
+#include "System/Resource/ResourcePtr.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Serialization/BinarySerialization.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    MotionDatabaseCompiler::MotionDatabaseCompiler()
+        : Resource::Compiler( "Animation Motion Database Compiler", s_version )
+    {
+        m_outputTypes.push_back( MotionDatabase::GetStaticResourceTypeID() );
+        m_compressionType = Resource::CompressionType::LZ4;
+    }
+
+    TUniquePtr<RawAssets::RawSkeleton> MotionDatabaseCompiler::ReadSkeleton( ResourcePath const& skeletonPath ) const
+    {
+        FileSystem::Path skeletonDescriptorFilePath;
+        if ( !ConvertResourcePathToFilePath( skeletonPath, skeletonDescriptorFilePath ) )
+        {
+            Error( "Invalid skeleton data path: %s", skeletonPath.c_str() );
+            return nullptr;
+        }
+
+        SkeletonResourceDescriptor skeletonResourceDescriptor;
+        if ( !Resource::ResourceDescriptor::TryReadFromFile( *m_pTypeRegistry, skeletonDescriptorFilePath, skeletonResourceDescriptor ) )
+        {
+            Error( "Failed to read skeleton resource descriptor from file: %s", skeletonDescriptorFilePath.c_str() );
+            return nullptr;
+        }
+
+        FileSystem::Path skeletonFilePath;
+        if ( !ConvertResourcePathToFilePath( skeletonResourceDescriptor.m_skeletonPath, skeletonFilePath ) )
+        {
+            Error( "Invalid skeleton FBX data path: %s", skeletonResourceDescriptor.m_skeletonPath.GetString().c_str() );
+            return nullptr;
+        }
+
+        RawAssets::ReaderContext readerCtx = { [this]( char const* pString ) { Warning( pString ); }, [this] ( char const* pString ) { Error( pString ); } };
+        auto pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, skeletonResourceDescriptor.m_skeletonRootBoneName, skeletonResourceDescriptor.m_highLODBones );
+        if ( pRawSkeleton == nullptr || !pRawSkeleton->IsValid() )
+        {
+            Error( "Failed to read skeleton file: %s", skeletonFilePath.ToString().c_str() );
+            return nullptr;
+        }
+
+        return pRawSkeleton;
+    }
+
+    void MotionDatabaseCompiler::NormalizeFeatures( MotionDatabaseResourceDescriptor const& resourceDescriptor, int32_t numFeatures, TVector<float>& features, MotionDatabase& database ) const
+    {
+        int32_t const numEntries = (int32_t) features.size() / numFeatures;
+        EE_ASSERT( numEntries > 0 );
+
+        // Calculate the mean and variance of each feature
+        //-------------------------------------------------------------------------
+
+        TVector<float> means( numFeatures, 0.0f );
+        TVector<float> variances( numFeatures, 0.0f );
+
+        for ( int32_t entryIdx = 0; entryIdx < numEntries; entryIdx++ )
+        {
+            float const* pEntry = &features[entryIdx * numFeatures];
+            for ( int32_t featureIdx = 0; featureIdx < numFeatures; featureIdx++ )
+            {
+                means[featureIdx] += pEntry[featureIdx];
+            }
+        }
+
+        for ( auto& mean : means )
+        {
+            mean /= numEntries;
+        }
+
+        for ( int32_t entryIdx = 0; entryIdx < numEntries; entryIdx++ )
+        {
+            float const* pEntry = &features[entryIdx * numFeatures];
+            for ( int32_t featureIdx = 0; featureIdx < numFeatures; featureIdx++ )
+            {
+                float const delta = pEntry[featureIdx] - means[featureIdx];
+                variances[featureIdx] += delta * delta;
+            }
+        }
+
+        // Each group of features (e.g. the xyz position of a bone) shares a single scale so we dont distort the relationship between the group's dimensions
+        //-------------------------------------------------------------------------
+
+        database.m_featureOffsets = means;
+        database.m_featureScales.resize( numFeatures, 1.0f );
+
+        auto NormalizeGroup = [&] ( int32_t firstFeatureIdx, int32_t numGroupFeatures, float weight )
+        {
+            float groupVariance = 0.0f;
+            for ( int32_t i = firstFeatureIdx; i < firstFeatureIdx + numGroupFeatures; i++ )
+            {
+                groupVariance += variances[i] / numEntries;
+            }
+
+            float const groupStandardDeviation = Math::Sqrt( groupVariance / numGroupFeatures );
+            float const scale = ( groupStandardDeviation > Math::Epsilon ) ? ( weight / groupStandardDeviation ) : weight;
+            for ( int32_t i = firstFeatureIdx; i < firstFeatureIdx + numGroupFeatures; i++ )
+            {
+                database.m_featureScales[i] = scale;
+            }
+        };
+
+        int32_t featureIdx = 0;
+        for ( int32_t boneIdx = 0; boneIdx < database.m_numFeatureBones; boneIdx++ )
+        {
+            NormalizeGroup( featureIdx, 3, resourceDescriptor.m_bonePositionWeight );
+            NormalizeGroup( featureIdx + 3, 3, resourceDescriptor.m_boneVelocityWeight );
+            featureIdx += MotionDatabase::s_numFeaturesPerBone;
+        }
+
+        // Trajectory positions and facings are interleaved, so normalize them across all samples
+        int32_t const numTrajectorySamples = database.GetNumTrajectorySamples();
+        for ( int32_t sampleIdx = 0; sampleIdx < numTrajectorySamples; sampleIdx++ )
+        {
+            NormalizeGroup( featureIdx, 2, resourceDescriptor.m_trajectoryPositionWeight );
+            NormalizeGroup( featureIdx + 2, 2, resourceDescriptor.m_trajectoryFacingWeight );
+            featureIdx += MotionDatabase::s_numFeaturesPerTrajectorySample;
+        }
+
+        EE_ASSERT( featureIdx == numFeatures );
+
+        // Apply
+        //-------------------------------------------------------------------------
+
+        for ( int32_t entryIdx = 0; entryIdx < numEntries; entryIdx++ )
+        {
+            float* pEntry = &features[entryIdx * numFeatures];
+            for ( int32_t i = 0; i < numFeatures; i++ )
+            {
+                pEntry[i] = ( pEntry[i] - database.m_featureOffsets[i] ) * database.m_featureScales[i];
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    Resource::CompilationResult MotionDatabaseCompiler::Compile( Resource::CompileContext const& ctx ) const
+    {
+        MotionDatabaseResourceDescriptor resourceDescriptor;
+        if ( !Resource::ResourceDescriptor::TryReadFromFile( *m_pTypeRegistry, ctx.m_inputFilePath, resourceDescriptor ) )
+        {
+            return Error( "Failed to read resource descriptor from input file: %s", ctx.m_inputFilePath.c_str() );
+        }
+
+        if ( !resourceDescriptor.IsValid() )
+        {
+            return Error( "Invalid motion database descriptor, a skeleton and at least one clip are required" );
+        }
+
+        int32_t const numTrajectorySamples = (int32_t) resourceDescriptor.m_trajectorySampleTimes.size();
+        if ( numTrajectorySamples == 0 || numTrajectorySamples > MotionDatabase::s_maxTrajectorySamples )
+        {
+            return Error( "Invalid number of trajectory samples (%d), between 1 and %d samples are supported", numTrajectorySamples, MotionDatabase::s_maxTrajectorySamples );
+        }
+
+        for ( int32_t i = 0; i < numTrajectorySamples; i++ )
+        {
+            if ( resourceDescriptor.m_trajectorySampleTimes[i] <= 0.0f || ( i > 0 && resourceDescriptor.m_trajectorySampleTimes[i] <= resourceDescriptor.m_trajectorySampleTimes[i - 1] ) )
+            {
+                return Error( "Trajectory sample times need to be positive and in ascending order" );
+            }
+        }
+
+        // Read Skeleton
+        //-------------------------------------------------------------------------
+
+        auto pRawSkeleton = ReadSkeleton( resourceDescriptor.m_skeleton.GetResourcePath() );
+        if ( pRawSkeleton == nullptr )
+        {
+            return Resource::CompilationResult::Failure;
+        }
+
+        TInlineVector<int32_t, 10> featureBoneIndices;
+        for ( auto const& boneID : resourceDescriptor.m_featureBoneIDs )
+        {
+            int32_t const boneIdx = pRawSkeleton->GetBoneIndex( boneID );
+            if ( boneIdx == InvalidIndex )
+            {
+                return Error( "Feature bone (%s) doesnt exist in the skeleton", boneID.c_str() );
+            }
+
+            featureBoneIndices.emplace_back( boneIdx );
+        }
+
+        MotionDatabase database;
+        database.m_skeleton = resourceDescriptor.m_skeleton;
+        database.m_numFeatureBones = (int32_t) featureBoneIndices.size();
+        for ( auto sampleTime : resourceDescriptor.m_trajectorySampleTimes )
+        {
+            database.m_trajectorySampleTimes.emplace_back( sampleTime );
+        }
+
+        int32_t const numFeatures = ( database.m_numFeatureBones * MotionDatabase::s_numFeaturesPerBone ) + ( numTrajectorySamples * MotionDatabase::s_numFeaturesPerTrajectorySample );
+
+        // Extract features
+        //-------------------------------------------------------------------------
+
+        bool hasWarnings = false;
+        TVector<float> features;
+        RawAssets::ReaderContext readerCtx = { [this]( char const* pString ) { Warning( pString ); }, [this] ( char const* pString ) { Error( pString ); } };
+
+        for ( auto const& clip : resourceDescriptor.m_clips )
+        {
+            if ( !clip.IsSet() )
+            {
+                continue;
+            }
+
+            FileSystem::Path clipDescriptorFilePath;
+            if ( !ConvertResourcePathToFilePath( clip.GetResourcePath(), clipDescriptorFilePath ) )
+            {
+                return Error( "Invalid animation clip path: %s", clip.GetResourcePath().c_str() );
+            }
+
+            AnimationClipResourceDescriptor clipResourceDescriptor;
+            if ( !Resource::ResourceDescriptor::TryReadFromFile( *m_pTypeRegistry, clipDescriptorFilePath, clipResourceDescriptor ) )
+            {
+                return Error( "Failed to read animation clip resource descriptor: %s", clipDescriptorFilePath.c_str() );
+            }
+
+            if ( clipResourceDescriptor.m_skeleton.GetResourceID() != resourceDescriptor.m_skeleton.GetResourceID() )
+            {
+                return Error( "Animation clip (%s) uses a different skeleton to the motion database", clip.GetResourcePath().c_str() );
+            }
+
+            if ( clipResourceDescriptor.m_regenerateRootMotion )
+            {
+                Warning( "Animation clip (%s) regenerates its root motion, the trajectory features are extracted from the source root motion and may not match", clip.GetResourcePath().c_str() );
+                hasWarnings = true;
+            }
+
+            FileSystem::Path animationFilePath;
+            if ( !ConvertResourcePathToFilePath( clipResourceDescriptor.m_animationPath, animationFilePath ) )
+            {
+                return Error( "Invalid animation data path: %s", clipResourceDescriptor.m_animationPath.c_str() );
+            }
+
+            TUniquePtr<RawAssets::RawAnimation> pRawAnimation = RawAssets::ReadAnimation( readerCtx, animationFilePath, *pRawSkeleton, clipResourceDescriptor.m_animationName );
+            if ( pRawAnimation == nullptr )
+            {
+                return Error( "Failed to read animation from source file: %s", animationFilePath.c_str() );
+            }
+
+            // We need the full trajectory for every searchable frame, so exclude all frames that would need to sample past the end of the clip
+            //-------------------------------------------------------------------------
+
+            int32_t const numFrames = (int32_t) pRawAnimation->GetNumFrames();
+            float const frameRate = pRawAnimation->GetSamplingFrameRate();
+            Seconds const excludedTime = Math::Max( resourceDescriptor.m_trajectorySampleTimes.back(), resourceDescriptor.m_clipEndExclusionTime );
+            int32_t const numSearchableFrames = numFrames - Math::CeilingToInt( excludedTime * frameRate ) - 1;
+            if ( numSearchableFrames <= 0 )
+            {
+                Warning( "Animation clip (%s) is too short to be searched and will be ignored", clip.GetResourcePath().c_str() );
+                hasWarnings = true;
+                continue;
+            }
+
+            int32_t const clipIdx = (int32_t) database.m_clips.size();
+            database.m_clips.emplace_back( clip );
+            database.m_clipFirstEntryIndices.emplace_back( (int32_t) database.m_entries.size() );
+
+            // The root bone's global transform is the character transform, so all bone features are relative to it
+            auto const& trackData = pRawAnimation->GetTrackData();
+            auto const& rootTransforms = trackData[0].m_globalTransforms;
+
+            auto GetCharacterSpacePosition = [&] ( int32_t boneIdx, int32_t frameIdx )
+            {
+                return rootTransforms[frameIdx].InverseTransformPoint( trackData[boneIdx].m_globalTransforms[frameIdx].GetTranslation() );
+            };
+
+            for ( int32_t frameIdx = 0; frameIdx < numSearchableFrames; frameIdx++ )
+            {
+                MotionDatabase::Entry& entry = database.m_entries.emplace_back();
+                entry.m_clipIdx = clipIdx;
+                entry.m_frameIdx = frameIdx;
+
+                size_t const firstFeatureIdx = features.size();
+                features.resize( firstFeatureIdx + numFeatures );
+                float* pFeatures = &features[firstFeatureIdx];
+
+                // Bones
+                for ( auto boneIdx : featureBoneIndices )
+                {
+                    Vector const position = GetCharacterSpacePosition( boneIdx, frameIdx );
+                    Vector const velocity = ( GetCharacterSpacePosition( boneIdx, frameIdx + 1 ) - position ) * frameRate;
+
+                    *pFeatures++ = position.GetX();
+                    *pFeatures++ = position.GetY();
+                    *pFeatures++ = position.GetZ();
+                    *pFeatures++ = velocity.GetX();
+                    *pFeatures++ = velocity.GetY();
+                    *pFeatures++ = velocity.GetZ();
+                }
+
+                // Trajectory
+                Transform const& currentRootTransform = rootTransforms[frameIdx];
+                for ( auto sampleTime : resourceDescriptor.m_trajectorySampleTimes )
+                {
+                    int32_t const sampleFrameIdx = Math::Min( frameIdx + (int32_t) Math::Round( sampleTime * frameRate ), numFrames - 1 );
+                    Transform const& sampleRootTransform = rootTransforms[sampleFrameIdx];
+
+                    Vector const position = currentRootTransform.InverseTransformPoint( sampleRootTransform.GetTranslation() );
+                    Vector facing = currentRootTransform.GetRotation().RotateVectorInverse( sampleRootTransform.GetForwardVector() ).Get2D();
+                    facing = facing.IsNearZero2() ? Vector::WorldForward : facing.GetNormalized2();
+
+                    *pFeatures++ = position.GetX();
+                    *pFeatures++ = position.GetY();
+                    *pFeatures++ = facing.GetX();
+                    *pFeatures++ = facing.GetY();
+                }
+            }
+        }
+
+        if ( database.m_entries.empty() )
+        {
+            return Error( "Motion database doesnt contain any searchable frames" );
+        }
+
+        database.m_clipFirstEntryIndices.emplace_back( (int32_t) database.m_entries.size() );
+
+        // Normalize and build the search index
+        //-------------------------------------------------------------------------
+
+        NormalizeFeatures( resourceDescriptor, numFeatures, features, database );
+        database.m_index.Build( numFeatures, features.data(), (int32_t) database.m_entries.size() );
+
+        // Serialize
+        //-------------------------------------------------------------------------
+
+        Resource::ResourceHeader hdr( s_version, MotionDatabase::GetStaticResourceTypeID() );
+        hdr.AddInstallDependency( database.m_skeleton.GetResourceID() );
+        for ( auto const& clip : database.m_clips )
+        {
+            hdr.AddInstallDependency( clip.GetResourceID() );
+        }
+
+        Serialization::BinaryOutputArchive archive;
+        archive << hdr << database;
+
+        if ( archive.WriteToFile( ctx.m_outputFilePath ) )
+        {
+            return hasWarnings ? CompilationSucceededWithWarnings( ctx ) : CompilationSucceeded( ctx );
+        }
+        else
+        {
+            return CompilationFailed( ctx );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool MotionDatabaseCompiler::GetReferencedResources( ResourceID const& resourceID, TVector<ResourceID>& outReferencedResources ) const
+    {
+        FileSystem::Path const filePath = resourceID.GetResourcePath().ToFileSystemPath( m_rawResourceDirectoryPath );
+        MotionDatabaseResourceDescriptor resourceDescriptor;
+        if ( !Resource::ResourceDescriptor::TryReadFromFile( *m_pTypeRegistry, filePath, resourceDescriptor ) )
+        {
+            return false;
+        }
+
+        if ( resourceDescriptor.m_skeleton.IsSet() )
+        {
+            VectorEmplaceBackUnique( outReferencedResources, resourceDescriptor.m_skeleton.GetResourceID() );
+        }
+
+        for ( auto const& clip : resourceDescriptor.m_clips )
+        {
+            if ( clip.IsSet() )
+            {
+                VectorEmplaceBackUnique( outReferencedResources, clip.GetResourceID() );
+            }
+        }
+
+        return true;
+    }
+}
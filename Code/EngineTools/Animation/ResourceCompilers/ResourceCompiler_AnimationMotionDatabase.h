@@ -0,0 +1,38 @@
+#pragma once
+
+#include "EngineTools/_Module/API.h"
+#include "EngineTools/Resource/ResourceCompiler.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::RawAssets { class RawSkeleton; }
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    class MotionDatabase;
+    struct MotionDatabaseResourceDescriptor;
+
+    //-------------------------------------------------------------------------
+
+    class MotionDatabaseCompiler : public Resource::Compiler
+    {
+        EE_REGISTER_TYPE( MotionDatabaseCompiler );
+        static const int32_t s_version = 1;
+
+    public:
+
+        MotionDatabaseCompiler();
+
+    private:
+
+        virtual Resource::CompilationResult Compile( Resource::CompileContext const& ctx ) const final;
+        virtual bool GetReferencedResources( ResourceID const& resourceID, TVector<ResourceID>& outReferencedResources ) const override;
+
+        TUniquePtr<RawAssets::RawSkeleton> ReadSkeleton( ResourcePath const& skeletonPath ) const;
+
+        // Normalize each feature group by its standard deviation and apply the group weights
+        void NormalizeFeatures( MotionDatabaseResourceDescriptor const& resourceDescriptor, int32_t numFeatures, TVector<float>& features, MotionDatabase& database ) const;
+    };
+}
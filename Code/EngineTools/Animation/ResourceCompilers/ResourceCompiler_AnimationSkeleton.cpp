@@ -34,7 +34,7 @@ namespace EE::Animation
         }
 
         RawAssets::ReaderContext readerCtx = { [this]( char const* pString ) { Warning( pString ); }, [this] ( char const* pString ) { Error( pString ); } };
-        TUniquePtr<RawAssets::RawSkeleton> pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, resourceDescriptor.m_skeletonRootBoneName );
+        TUniquePtr<RawAssets::RawSkeleton> pRawSkeleton = RawAssets::ReadSkeleton( readerCtx, skeletonFilePath, resourceDescriptor.m_skeletonRootBoneName, resourceDescriptor.m_highLODBones );
         if ( pRawSkeleton == nullptr )
         {
             return Error( "Failed to read skeleton from source file" );
@@ -54,6 +54,13 @@ namespace EE::Animation
             skeleton.m_localReferencePose.push_back( Transform( boneData.m_localTransform.GetRotation(), boneData.m_localTransform.GetTranslation(), boneData.m_localTransform.GetScale() ) );
         }
 
+        skeleton.m_numBonesToSampleAtLowLOD = pRawSkeleton->GetNumBonesToSampleAtLowLOD();
+
+        // Generate the depth ordering used to evaluate the hierarchy a level at a time
+        //-------------------------------------------------------------------------
+
+        skeleton.CalculateDepthOrderedBoneIndices();
+
         // Serialize skeleton
         //-------------------------------------------------------------------------
 
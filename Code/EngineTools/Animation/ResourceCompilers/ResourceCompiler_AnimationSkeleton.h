@@ -10,7 +10,7 @@ namespace EE::Animation
     class SkeletonCompiler : public Resource::Compiler
     {
         EE_REGISTER_TYPE( SkeletonCompiler );
-        static const int32_t s_version = 2;
+        static const int32_t s_version = 4;
 
     public:
 
@@ -9,6 +9,17 @@
 
 namespace EE::Animation
 {
+    enum class AdditiveType
+    {
+        EE_REGISTER_ENUM
+
+        None = 0,
+        RelativeToSkeleton, // The additive delta is calculated relative to the skeleton's reference pose
+        RelativeToFirstFrame, // The additive delta is calculated relative to the first frame of the animation
+    };
+
+    //-------------------------------------------------------------------------
+
     struct EE_ENGINETOOLS_API AnimationClipResourceDescriptor final : public Resource::ResourceDescriptor
     {
         EE_REGISTER_TYPE( AnimationClipResourceDescriptor );
@@ -26,5 +37,12 @@ namespace EE::Animation
         EE_EXPOSE bool                        m_rootMotionGenerationRestrictToHorizontalPlane = false; // Ensure that the root motion has no vertical motion
         EE_EXPOSE StringID                    m_rootMotionGenerationBoneID;
         EE_EXPOSE EulerAngles                 m_rootMotionGenerationPreRotation;
+        EE_EXPOSE float                       m_quantizationErrorTolerance = 0.0001f; // Max error allowed when quantizing animated translations (in meters) and scales, used to select the bit-width for each track, set to zero to always use 16 bits
+        EE_EXPOSE float                       m_keyReductionErrorTolerance = 0.001f; // Max character space error (in meters) allowed when removing key frames, set to zero to disable key reduction
+        EE_EXPOSE AdditiveType                m_additiveType = AdditiveType::None;
+        EE_EXPOSE float                       m_additiveIdentityTranslationTolerance = 0.0001f; // Max additive translation (in meters) for a track to be considered inactive, inactive tracks are skipped when blending
+        EE_EXPOSE float                       m_additiveIdentityRotationTolerance = 0.0001f; // Max additive rotation angle (in radians) for a track to be considered inactive
+        EE_EXPOSE float                       m_additiveIdentityScaleTolerance = 0.0001f; // Max additive scale offset for a track to be considered inactive
+        EE_EXPOSE bool                        m_outputDetailedCompressionReport = false; // Output the bit-widths, key count and max error for every bone when compiling, useful when tuning the tolerances
     };
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "EngineTools/_Module/API.h"
+#include "EngineTools/Resource/ResourceDescriptor.h"
+#include "Engine/Animation/AnimationMotionDatabase.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    struct EE_ENGINETOOLS_API MotionDatabaseResourceDescriptor final : public Resource::ResourceDescriptor
+    {
+        EE_REGISTER_TYPE( MotionDatabaseResourceDescriptor );
+
+        virtual bool IsValid() const override { return m_skeleton.IsSet() && !m_clips.empty(); }
+        virtual bool IsUserCreateableDescriptor() const override { return true; }
+        virtual ResourceTypeID GetCompiledResourceTypeID() const override { return MotionDatabase::GetStaticResourceTypeID(); }
+
+    public:
+
+        EE_EXPOSE TResourcePtr<Skeleton>                    m_skeleton = nullptr;
+
+        // The clips to search, all clips need to use the database skeleton
+        EE_EXPOSE TVector<TResourcePtr<AnimationClip>>      m_clips;
+
+        // The bones whose character space position and velocity are matched (e.g. feet and hips)
+        EE_EXPOSE TVector<StringID>                         m_featureBoneIDs;
+
+        // The future times at which the root trajectory is matched
+        EE_EXPOSE TVector<float>                            m_trajectorySampleTimes = { 0.33f, 0.66f, 1.0f };
+
+        // The relative weights for each feature group, each group is normalized by its standard deviation before the weight is applied
+        EE_EXPOSE float                                     m_bonePositionWeight = 1.0f;
+        EE_EXPOSE float                                     m_boneVelocityWeight = 1.0f;
+        EE_EXPOSE float                                     m_trajectoryPositionWeight = 1.0f;
+        EE_EXPOSE float                                     m_trajectoryFacingWeight = 1.0f;
+
+        // Frames this close to the end of a clip are never selected, so we always have some animation left to blend into
+        EE_EXPOSE float                                     m_clipEndExclusionTime = 0.2f;
+    };
+}
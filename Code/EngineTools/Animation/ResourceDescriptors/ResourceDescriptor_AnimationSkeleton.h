@@ -24,6 +24,9 @@ namespace EE::Animation
         // Optional value that specifies the name of the skeleton hierarchy to use, if it is unset, we use the first skeleton we find
         EE_EXPOSE String                                   m_skeletonRootBoneName;
 
+        // Bones (and all their children) that will only be sampled/blended at the high LOD e.g. fingers and facial bones
+        EE_EXPOSE TVector<StringID>                        m_highLODBones;
+
         // Editor-only preview mesh
         EE_EXPOSE TResourcePtr<Render::SkeletalMesh>       m_previewMesh;
     };
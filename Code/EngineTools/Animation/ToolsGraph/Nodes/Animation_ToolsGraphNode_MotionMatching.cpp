@@ -0,0 +1,62 @@
+#include "Animation_ToolsGraphNode_MotionMatching.h"
+#include "Engine/Animation/Graph/Nodes/Animation_RuntimeGraphNode_MotionMatching.h"
+#include "EngineTools/Animation/ToolsGraph/Animation_ToolsGraph_Compilation.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation::GraphNodes
+{
+    void MotionMatchingToolsNode::Initialize( VisualGraph::BaseGraph* pParent )
+    {
+        DataSlotToolsNode::Initialize( pParent );
+        CreateOutputPin( "Pose", GraphValueType::Pose );
+        CreateInputPin( "Desired Velocity", GraphValueType::Vector );
+        CreateInputPin( "Desired Facing", GraphValueType::Vector );
+    }
+
+    int16_t MotionMatchingToolsNode::Compile( GraphCompilationContext& context ) const
+    {
+        MotionMatchingNode::Settings* pSettings = nullptr;
+        NodeCompilationState const state = context.GetSettings<MotionMatchingNode>( this, pSettings );
+        if ( state == NodeCompilationState::NeedCompilation )
+        {
+            auto pDesiredVelocityNode = GetConnectedInputNode<FlowToolsNode>( 0 );
+            if ( pDesiredVelocityNode != nullptr )
+            {
+                auto compiledNodeIdx = pDesiredVelocityNode->Compile( context );
+                if ( compiledNodeIdx != InvalidIndex )
+                {
+                    pSettings->m_desiredVelocityValueNodeIdx = compiledNodeIdx;
+                }
+                else
+                {
+                    return InvalidIndex;
+                }
+            }
+
+            auto pDesiredFacingNode = GetConnectedInputNode<FlowToolsNode>( 1 );
+            if ( pDesiredFacingNode != nullptr )
+            {
+                auto compiledNodeIdx = pDesiredFacingNode->Compile( context );
+                if ( compiledNodeIdx != InvalidIndex )
+                {
+                    pSettings->m_desiredFacingValueNodeIdx = compiledNodeIdx;
+                }
+                else
+                {
+                    return InvalidIndex;
+                }
+            }
+
+            //-------------------------------------------------------------------------
+
+            pSettings->m_dataSlotIdx = context.RegisterDataSlotNode( GetID() );
+            pSettings->m_searchInterval = m_searchInterval;
+            pSettings->m_blendTime = m_blendTime;
+            pSettings->m_minCostImprovement = m_minCostImprovement;
+            pSettings->m_useAccelerationStructure = m_useAccelerationStructure;
+            pSettings->m_sampleRootMotion = m_sampleRootMotion;
+        }
+        return pSettings->m_nodeIdx;
+    }
+}
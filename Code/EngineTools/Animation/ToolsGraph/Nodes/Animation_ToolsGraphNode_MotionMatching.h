@@ -0,0 +1,33 @@
+#pragma once
+#include "Engine/Animation/AnimationMotionDatabase.h"
+#include "Animation_ToolsGraphNode_DataSlot.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation::GraphNodes
+{
+    class MotionMatchingToolsNode final : public DataSlotToolsNode
+    {
+        EE_REGISTER_TYPE( MotionMatchingToolsNode );
+
+    public:
+
+        virtual void Initialize( VisualGraph::BaseGraph* pParent ) override;
+
+        virtual char const* GetTypeName() const override { return "Motion Matching"; }
+        virtual char const* GetCategory() const override { return "Animation"; }
+        virtual TBitFlags<GraphType> GetAllowedParentGraphTypes() const override { return TBitFlags<GraphType>( GraphType::BlendTree ); }
+        virtual int16_t Compile( GraphCompilationContext& context ) const override;
+
+        virtual char const* const GetDefaultSlotName() const override { return "Database"; }
+        virtual ResourceTypeID GetSlotResourceTypeID() const override { return MotionDatabase::GetStaticResourceTypeID(); }
+
+    private:
+
+        EE_EXPOSE Seconds                   m_searchInterval = 0.1f;
+        EE_EXPOSE Seconds                   m_blendTime = 0.2f;
+        EE_EXPOSE float                     m_minCostImprovement = 0.1f; // How much cheaper (as a fraction of the current cost) does a match need to be for us to jump to it
+        EE_EXPOSE bool                      m_useAccelerationStructure = true;
+        EE_EXPOSE bool                      m_sampleRootMotion = true;
+    };
+}
@@ -22,6 +22,7 @@ namespace EE::Navmesh
         #endif
     {
         m_outputTypes.push_back( NavmeshData::GetStaticResourceTypeID() );
+        m_compressionType = Resource::CompressionType::LZ4HC;
     }
 
     Resource::CompilationResult NavmeshCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -46,6 +46,7 @@ namespace EE
             : Resource::Compiler( "PhysicsMeshCompiler", s_version )
         {
             m_outputTypes.push_back( PhysicsMesh::GetStaticResourceTypeID() );
+            m_compressionType = Resource::CompressionType::LZ4HC;
         }
 
         Resource::CompilationResult PhysicsMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
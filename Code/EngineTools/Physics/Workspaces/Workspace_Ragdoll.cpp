@@ -723,7 +723,7 @@ namespace EE::Physics
             bool const shouldStopPreview = !m_pRagdoll->GetPose( worldTransform, m_pPose );
 
             // Apply physics blend weight
-            Animation::Blender::Blend( m_pFinalPose, m_pPose, m_physicsBlendWeight, TBitFlags<Animation::PoseBlendOptions>(), nullptr, m_pFinalPose );
+            Animation::Blender::Blend( Animation::Skeleton::LOD::High, m_pFinalPose, m_pPose, m_physicsBlendWeight, TBitFlags<Animation::PoseBlendOptions>(), nullptr, m_pFinalPose );
 
             // Draw ragdoll pose
             if ( m_drawRagdoll )
@@ -59,9 +59,11 @@ namespace EE::RawAssets
             rootTrackData.m_globalTransforms[i] = Transform::Identity;
         }
 
-        // Calculate component ranges
-        //-------------------------------------------------------------------------
+        CalculateComponentRanges();
+    }
 
+    void RawAnimation::CalculateComponentRanges()
+    {
         for ( auto& track : m_tracks )
         {
             track.m_translationValueRangeX = FloatRange();
@@ -54,6 +54,9 @@ namespace EE::RawAssets
         // Generate local transforms from the global ones
         void RegenerateLocalTransforms();
 
+        // Recalculate the translation/scale value ranges for each track, needs to be called whenever the local transforms are modified
+        void CalculateComponentRanges();
+
     protected:
 
         RawSkeleton const                   m_skeleton;
@@ -1,4 +1,5 @@
 #include "RawAssetReader.h"
+#include "RawSkeleton.h"
 #include "Fbx/FbxSkeleton.h"
 #include "Fbx/FbxAnimation.h"
 #include "Fbx/FbxMesh.h"
@@ -100,7 +101,7 @@ namespace EE::RawAssets
         return pRawMesh;
     }
 
-    TUniquePtr<RawAssets::RawSkeleton> ReadSkeleton( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, String const& skeletonRootBoneName )
+    TUniquePtr<RawAssets::RawSkeleton> ReadSkeleton( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, String const& skeletonRootBoneName, TVector<StringID> const& highLODBones )
     {
         EE_ASSERT( sourceFilePath.IsValid() && ctx.IsValid() );
 
@@ -124,6 +125,11 @@ namespace EE::RawAssets
 
         //-------------------------------------------------------------------------
 
+        if ( pRawSkeleton != nullptr && pRawSkeleton->IsValid() )
+        {
+            pRawSkeleton->ReorderBonesForLOD( highLODBones );
+        }
+
         if ( !ValidateRawAsset( ctx, pRawSkeleton.get() ) )
         {
             pRawSkeleton = nullptr;
@@ -4,6 +4,8 @@
 #include "System/FileSystem/FileSystemPath.h"
 #include "System/Memory/Pointers.h"
 #include "System/Types/Function.h"
+#include "System/Types/StringID.h"
+#include "System/Types/Arrays.h"
 
 //-------------------------------------------------------------------------
 
@@ -28,6 +30,7 @@ namespace EE::RawAssets
     EE_ENGINETOOLS_API TUniquePtr<RawAssets::RawMesh> ReadStaticMesh( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, String const& nameOfMeshToCompile = String() );
     EE_ENGINETOOLS_API TUniquePtr<RawAssets::RawMesh> ReadSkeletalMesh( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, int32_t maxBoneInfluences = 4 );
 
-    EE_ENGINETOOLS_API TUniquePtr<RawAssets::RawSkeleton> ReadSkeleton( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, String const& skeletonRootBoneName = String() );
+    // The high LOD bones (and their children) will be moved to the end of the bone list, see 'RawSkeleton::ReorderBonesForLOD'
+    EE_ENGINETOOLS_API TUniquePtr<RawAssets::RawSkeleton> ReadSkeleton( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, String const& skeletonRootBoneName = String(), TVector<StringID> const& highLODBones = TVector<StringID>() );
     EE_ENGINETOOLS_API TUniquePtr<RawAssets::RawAnimation> ReadAnimation( ReaderContext const& ctx, FileSystem::Path const& sourceFilePath, RawAssets::RawSkeleton const& rawSkeleton, String const& animationName = String() );
 }
\ No newline at end of file
@@ -27,6 +27,84 @@ namespace EE::RawAssets
         return InvalidIndex;
     }
 
+    void RawSkeleton::ReorderBonesForLOD( TVector<StringID> const& highLODBones )
+    {
+        EE_ASSERT( !m_bones.empty() );
+        int32_t const numBones = GetNumBones();
+
+        // Flag all high LOD bones, children inherit the flag from their parents
+        //-------------------------------------------------------------------------
+
+        TVector<bool> isHighLODBone( numBones, false );
+        for ( auto const& boneID : highLODBones )
+        {
+            int32_t const boneIdx = GetBoneIndex( boneID );
+            if ( boneIdx == InvalidIndex )
+            {
+                LogWarning( "High LOD bone (%s) not found in skeleton", boneID.c_str() );
+            }
+            else if ( boneIdx == 0 )
+            {
+                LogWarning( "Root bone (%s) cannot be a high LOD bone", boneID.c_str() );
+            }
+            else
+            {
+                isHighLODBone[boneIdx] = true;
+            }
+        }
+
+        for ( int32_t boneIdx = 1; boneIdx < numBones; boneIdx++ )
+        {
+            isHighLODBone[boneIdx] = isHighLODBone[boneIdx] || isHighLODBone[m_bones[boneIdx].m_parentBoneIdx];
+        }
+
+        // Reorder bones - low LOD bones first, relative order is maintained so parents stay ahead of their children
+        //-------------------------------------------------------------------------
+
+        TVector<int32_t> newBoneOrder;
+        newBoneOrder.reserve( numBones );
+
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            if ( !isHighLODBone[boneIdx] )
+            {
+                newBoneOrder.emplace_back( boneIdx );
+            }
+        }
+
+        m_numBonesToSampleAtLowLOD = (int32_t) newBoneOrder.size();
+
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            if ( isHighLODBone[boneIdx] )
+            {
+                newBoneOrder.emplace_back( boneIdx );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        TVector<int32_t> oldToNewBoneIndices( numBones, InvalidIndex );
+        for ( int32_t newBoneIdx = 0; newBoneIdx < numBones; newBoneIdx++ )
+        {
+            oldToNewBoneIndices[newBoneOrder[newBoneIdx]] = newBoneIdx;
+        }
+
+        TVector<BoneData> reorderedBones;
+        reorderedBones.reserve( numBones );
+        for ( int32_t newBoneIdx = 0; newBoneIdx < numBones; newBoneIdx++ )
+        {
+            BoneData& boneData = reorderedBones.emplace_back( m_bones[newBoneOrder[newBoneIdx]] );
+            if ( boneData.m_parentBoneIdx != InvalidIndex )
+            {
+                boneData.m_parentBoneIdx = oldToNewBoneIndices[boneData.m_parentBoneIdx];
+                EE_ASSERT( boneData.m_parentBoneIdx < newBoneIdx );
+            }
+        }
+
+        m_bones.swap( reorderedBones );
+    }
+
     void RawSkeleton::CalculateLocalTransforms()
     {
         EE_ASSERT( !m_bones.empty() );
@@ -47,6 +47,16 @@ namespace EE::RawAssets
         inline Transform const& GetLocalTransform( int32_t boneIdx ) const { EE_ASSERT( boneIdx >= 0 && boneIdx < m_bones.size() ); return m_bones[boneIdx].m_localTransform; }
         inline Transform const& GetGlobalTransform( int32_t boneIdx ) const { EE_ASSERT( boneIdx >= 0 && boneIdx < m_bones.size() ); return m_bones[boneIdx].m_globalTransform; }
 
+        // LOD
+        //-------------------------------------------------------------------------
+
+        // Reorder the bones so that all bones needed for the low LOD come first, the specified bones (and all their children) are only needed for the high LOD
+        // Parents are still guaranteed to be stored before their children
+        void ReorderBonesForLOD( TVector<StringID> const& highLODBones );
+
+        // Get the number of bones needed for the low LOD, all high LOD bones are stored after these
+        inline int32_t GetNumBonesToSampleAtLowLOD() const { return ( m_numBonesToSampleAtLowLOD == InvalidIndex ) ? (int32_t) m_bones.size() : m_numBonesToSampleAtLowLOD; }
+
     protected:
 
         void CalculateLocalTransforms();
@@ -56,5 +66,6 @@ namespace EE::RawAssets
 
         StringID                m_name;
         TVector<BoneData>       m_bones;
+        int32_t                 m_numBonesToSampleAtLowLOD = InvalidIndex;
     };
 }
\ No newline at end of file
@@ -216,6 +216,7 @@ namespace EE::Render
         : MeshCompiler( "StaticMeshCompiler", s_version )
     {
         m_outputTypes.push_back( StaticMesh::GetStaticResourceTypeID() );
+        m_compressionType = Resource::CompressionType::LZ4HC;
     }
 
     Resource::CompilationResult StaticMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
@@ -290,6 +291,7 @@ namespace EE::Render
         : MeshCompiler( "SkeletalMeshCompiler", s_version )
     {
         m_outputTypes.push_back( SkeletalMesh::GetStaticResourceTypeID() );
+        m_compressionType = Resource::CompressionType::LZ4HC;
     }
 
     Resource::CompilationResult SkeletalMeshCompiler::Compile( Resource::CompileContext const& ctx ) const
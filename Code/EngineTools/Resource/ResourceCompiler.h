@@ -66,6 +66,9 @@ namespace EE::Resource
         // Does this compiler actually require the input file or is it optional.
         virtual bool IsInputFileRequired() const { return true; }
 
+        // The compression the resource server should apply to the compiled resources
+        inline CompressionType GetCompressionType() const { return m_compressionType; }
+
         // Get all referenced resources for a specific resource
         virtual bool GetReferencedResources( ResourceID const& resourceID, TVector<ResourceID>& outReferencedResources ) const { return true; }
 
@@ -103,5 +106,6 @@ namespace EE::Resource
         String const                                    m_name;
         TVector<ResourceTypeID>                         m_outputTypes;
         TVector<ResourceTypeID>                         m_virtualTypes;
+        CompressionType                                 m_compressionType = CompressionType::None;
     };
 }
\ No newline at end of file
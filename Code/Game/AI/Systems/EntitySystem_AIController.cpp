@@ -7,6 +7,7 @@
 #include "Engine/Physics/Systems/WorldSystem_Physics.h"
 #include "Engine/Physics/Components/Component_PhysicsCharacter.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
+#include "System/Threading/TaskSystem.h"
 #include "System/Types/ScopedValue.h"
 
 //-------------------------------------------------------------------------
@@ -139,11 +140,11 @@ namespace EE::AI
             m_behaviorContext.m_pCharacterController->TryMoveCapsule( ctx, m_behaviorContext.m_pPhysicsScene, deltaTranslation, deltaRotation );
 
             // Run animation pose tasks
-            m_pAnimGraphComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), m_pCharacterMeshComponent->GetWorldTransform() );
+            m_pAnimGraphComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), m_pCharacterMeshComponent->GetWorldTransform(), ctx.GetSystem<TaskSystem>() );
         }
         else if ( updateStage == UpdateStage::PostPhysics )
         {
-            m_pAnimGraphComponent->ExecutePostPhysicsTasks();
+            m_pAnimGraphComponent->ExecutePostPhysicsTasks( ctx.GetSystem<TaskSystem>() );
         }
         else
         {
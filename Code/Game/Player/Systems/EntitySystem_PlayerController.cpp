@@ -9,6 +9,7 @@
 #include "Engine/Camera/Components/Component_OrbitCamera.h"
 #include "Engine/Player/Components/Component_Player.h"
 #include "System/Input/InputSystem.h"
+#include "System/Threading/TaskSystem.h"
 #include "System/Types/ScopedValue.h"
 #include "System/Profiling.h"
 
@@ -196,14 +197,14 @@ namespace EE::Player
             //-------------------------------------------------------------------------
 
             // Run animation pose tasks
-            m_pAnimGraphComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), m_pCharacterMeshComponent->GetWorldTransform() );
+            m_pAnimGraphComponent->ExecutePrePhysicsTasks( ctx.GetDeltaTime(), m_pCharacterMeshComponent->GetWorldTransform(), ctx.GetSystem<TaskSystem>() );
 
             // Update camera position relative to new character position
             m_actionContext.m_pCameraController->FinalizeCamera();
         }
         else if ( updateStage == UpdateStage::PostPhysics )
         {
-            m_pAnimGraphComponent->ExecutePostPhysicsTasks();
+            m_pAnimGraphComponent->ExecutePostPhysicsTasks( ctx.GetSystem<TaskSystem>() );
         }
         else
         {
@@ -84,6 +84,69 @@ namespace EE::Quantization
         return decodedValue;
     }
 
+    // Variable bit-width float quantization
+    //-------------------------------------------------------------------------
+    // 32 bit float to N bit uint (1-16 bits)
+
+    // Get the max error introduced when quantizing a value range into the specified number of bits
+    inline float GetMaxQuantizationError( float const quantizationRangeLength, uint32_t numBits )
+    {
+        EE_ASSERT( numBits > 0 && numBits <= 16 );
+        return quantizationRangeLength / ( 2.0f * float( ( 1u << numBits ) - 1 ) );
+    }
+
+    inline uint16_t EncodeFloat( float value, float const quantizationRangeStartValue, float const quantizationRangeLength, uint32_t numBits )
+    {
+        EE_ASSERT( quantizationRangeLength != 0 );
+        EE_ASSERT( numBits > 0 && numBits <= 16 );
+
+        float const normalizedValue = Math::Clamp( ( value - quantizationRangeStartValue ) / quantizationRangeLength, 0.0f, 1.0f );
+        float const quantizedValue = normalizedValue * float( ( 1u << numBits ) - 1 ) + 0.5f;
+        return uint16_t( quantizedValue );
+    }
+
+    inline float DecodeFloat( uint16_t encodedValue, float const quantizationRangeStartValue, float const quantizationRangeLength, uint32_t numBits )
+    {
+        EE_ASSERT( quantizationRangeLength != 0 );
+        EE_ASSERT( numBits > 0 && numBits <= 16 );
+
+        float const normalizedValue = encodedValue / float( ( 1u << numBits ) - 1 );
+        float const decodedValue = ( normalizedValue * quantizationRangeLength ) + quantizationRangeStartValue;
+        return decodedValue;
+    }
+
+    // Decode four values at once, each lane has its own quantization range and max encoded value (i.e. (2^N)-1 for N bits)
+    // Produces identical results to 'DecodeFloat'
+    EE_FORCE_INLINE Vector DecodeFloat4( __m128i encodedValues, Vector const& quantizationRangeStartValues, Vector const& quantizationRangeLengths, Vector const& maxEncodedValues )
+    {
+        __m128 const normalizedValues = _mm_div_ps( _mm_cvtepi32_ps( encodedValues ), maxEncodedValues );
+        __m128 const decodedValues = _mm_add_ps( _mm_mul_ps( normalizedValues, quantizationRangeLengths ), quantizationRangeStartValues );
+        return decodedValues;
+    }
+
+    //-------------------------------------------------------------------------
+    // Bit packing
+    //-------------------------------------------------------------------------
+    // Values are packed LSB first into a stream of 16bit words, a single value can straddle two words
+
+    inline uint16_t ReadPackedBits( uint16_t const* pData, uint32_t bitOffset, uint32_t numBits )
+    {
+        EE_ASSERT( pData != nullptr );
+        EE_ASSERT( numBits > 0 && numBits <= 16 );
+
+        uint32_t const wordIdx = bitOffset >> 4;
+        uint32_t const shift = bitOffset & 0xF;
+
+        // Only touch the next word if we need to, since the value might be at the very end of the stream
+        uint32_t bits = uint32_t( pData[wordIdx] ) >> shift;
+        if ( ( shift + numBits ) > 16 )
+        {
+            bits |= uint32_t( pData[wordIdx + 1] ) << ( 16 - shift );
+        }
+
+        return uint16_t( bits & ( ( 1u << numBits ) - 1 ) );
+    }
+
     //-------------------------------------------------------------------------
     // Quaternion Encoding
     //-------------------------------------------------------------------------
@@ -237,6 +300,45 @@ namespace EE::Quantization
             }
         }
 
+        // Decode four encoded quaternions at once, each lane of the data registers contains the (zero-extended) data for a single quaternion
+        // Produces identical results to 'ToQuaternion'
+        EE_FORCE_INLINE static void ToQuaternions4( __m128i data0, __m128i data1, __m128i data2, Quaternion* pOutQuaternions )
+        {
+            EE_ASSERT( pOutQuaternions != nullptr );
+
+            __m128i const largestValueIndex = _mm_or_si128( _mm_and_si128( _mm_srli_epi32( data0, 14 ), _mm_set1_epi32( 0x0002 ) ), _mm_srli_epi32( data1, 15 ) );
+            __m128i const componentMask = _mm_set1_epi32( 0x7FFF );
+
+            static constexpr float const rangeMultiplier15Bit = s_valueRangeLength / float( 0x7FFF );
+            __m128 const vRangeMultiplier = _mm_set_ps1( rangeMultiplier15Bit );
+            __m128 const vRangeMin = _mm_set_ps1( s_valueRangeMin );
+
+            __m128 const a = _mm_add_ps( _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( data0, componentMask ) ), vRangeMultiplier ), vRangeMin );
+            __m128 const b = _mm_add_ps( _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( data1, componentMask ) ), vRangeMultiplier ), vRangeMin );
+            __m128 const c = _mm_add_ps( _mm_mul_ps( _mm_cvtepi32_ps( data2 ), vRangeMultiplier ), vRangeMin );
+
+            __m128 const sum = _mm_add_ps( _mm_add_ps( _mm_mul_ps( a, a ), _mm_mul_ps( b, b ) ), _mm_mul_ps( c, c ) );
+            __m128 const d = _mm_sqrt_ps( _mm_sub_ps( _mm_set_ps1( 1.0f ), sum ) );
+
+            // Place the reconstructed component: 0 -> (d,a,b,c), 1 -> (a,d,b,c), 2 -> (a,b,d,c), 3 -> (a,b,c,d)
+            Vector const isLargest0 = _mm_castsi128_ps( _mm_cmpeq_epi32( largestValueIndex, _mm_setzero_si128() ) );
+            Vector const isLargest1 = _mm_castsi128_ps( _mm_cmpeq_epi32( largestValueIndex, _mm_set1_epi32( 1 ) ) );
+            Vector const isLargest2 = _mm_castsi128_ps( _mm_cmpeq_epi32( largestValueIndex, _mm_set1_epi32( 2 ) ) );
+            Vector const isLargest3 = _mm_castsi128_ps( _mm_cmpeq_epi32( largestValueIndex, _mm_set1_epi32( 3 ) ) );
+
+            __m128 x = Vector::Select( a, d, isLargest0 );
+            __m128 y = Vector::Select( Vector::Select( b, d, isLargest1 ), a, isLargest0 );
+            __m128 z = Vector::Select( Vector::Select( c, d, isLargest2 ), b, _mm_or_ps( isLargest0, isLargest1 ) );
+            __m128 w = Vector::Select( c, d, isLargest3 );
+
+            // Convert from SoA to AoS
+            _MM_TRANSPOSE4_PS( x, y, z, w );
+            pOutQuaternions[0] = Quaternion( Vector( x ) );
+            pOutQuaternions[1] = Quaternion( Vector( y ) );
+            pOutQuaternions[2] = Quaternion( Vector( z ) );
+            pOutQuaternions[3] = Quaternion( Vector( w ) );
+        }
+
         inline uint16_t GetData0() const { return m_data0; }
         inline uint16_t GetData1() const { return m_data1; }
         inline uint16_t GetData2() const { return m_data2; }
@@ -61,6 +61,36 @@ namespace EE::FileSystem
 
     EE_SYSTEM_API bool LoadFile( char const* filePath, Blob& fileData );
     EE_FORCE_INLINE bool LoadFile( String const& filePath, Blob& fileData ) { return LoadFile( filePath.c_str(), fileData ); }
+
+    // Memory mapped files
+    //-------------------------------------------------------------------------
+    // Read-only mapping of an entire file into the address space, pages are only read from disk once they are accessed
+
+    class EE_SYSTEM_API MemoryMappedFile
+    {
+    public:
+
+        MemoryMappedFile() = default;
+        MemoryMappedFile( MemoryMappedFile const& ) = delete;
+        ~MemoryMappedFile() { Close(); }
+
+        MemoryMappedFile& operator=( MemoryMappedFile const& ) = delete;
+
+        bool Open( char const* pPath );
+        inline bool Open( String const& filePath ) { return Open( filePath.c_str() ); }
+        void Close();
+
+        inline bool IsOpen() const { return m_pData != nullptr; }
+        inline uint8_t const* GetData() const { return m_pData; }
+        inline size_t GetSize() const { return m_size; }
+
+    private:
+
+        void*               m_pFileHandle = nullptr;
+        void*               m_pMappingHandle = nullptr;
+        uint8_t const*      m_pData = nullptr;
+        size_t              m_size = 0;
+    };
     
     // Directory Functions
     //-------------------------------------------------------------------------
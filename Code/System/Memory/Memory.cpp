@@ -8,6 +8,10 @@
     #include <stdlib.h>
 #endif
 
+#if EE_DEVELOPMENT_TOOLS
+    #include <atomic>
+#endif
+
 //-------------------------------------------------------------------------
 // Note: We dont globally overload the new or delete operators
 //-------------------------------------------------------------------------
@@ -22,6 +26,11 @@ namespace EE
         static bool g_isMemorySystemInitialized = false;
         static rpmalloc_config_t g_rpmallocConfig;
 
+        #if EE_DEVELOPMENT_TOOLS
+        static std::atomic<bool> g_isAllocationTrackingEnabled( false );
+        static std::atomic<uint64_t> g_numAllocations( 0 );
+        #endif
+
         //-------------------------------------------------------------------------
 
         static void CustomAssert( char const* pMessage )
@@ -94,6 +103,23 @@ namespace EE
             return 0;
             #endif
         }
+
+        #if EE_DEVELOPMENT_TOOLS
+        void SetAllocationTrackingEnabled( bool isEnabled )
+        {
+            g_isAllocationTrackingEnabled.store( isEnabled, std::memory_order_relaxed );
+        }
+
+        bool IsAllocationTrackingEnabled()
+        {
+            return g_isAllocationTrackingEnabled.load( std::memory_order_relaxed );
+        }
+
+        uint64_t GetNumAllocations()
+        {
+            return g_numAllocations.load( std::memory_order_relaxed );
+        }
+        #endif
     }
 
     //-------------------------------------------------------------------------
@@ -104,6 +130,13 @@ namespace EE
 
         if ( size == 0 ) return nullptr;
 
+        #if EE_DEVELOPMENT_TOOLS
+        if ( Memory::g_isAllocationTrackingEnabled.load( std::memory_order_relaxed ) )
+        {
+            Memory::g_numAllocations.fetch_add( 1, std::memory_order_relaxed );
+        }
+        #endif
+
         void* pMemory = nullptr;
 
         #if EE_USE_CUSTOM_ALLOCATOR
@@ -120,6 +153,13 @@ namespace EE
     {
         EE_ASSERT( EE::Memory::g_isMemorySystemInitialized );
 
+        #if EE_DEVELOPMENT_TOOLS
+        if ( Memory::g_isAllocationTrackingEnabled.load( std::memory_order_relaxed ) )
+        {
+            Memory::g_numAllocations.fetch_add( 1, std::memory_order_relaxed );
+        }
+        #endif
+
         void* pReallocatedMemory = nullptr;
 
         #if EE_USE_CUSTOM_ALLOCATOR
@@ -77,6 +77,15 @@ namespace EE
 
         EE_SYSTEM_API size_t GetTotalRequestedMemory();
         EE_SYSTEM_API size_t GetTotalAllocatedMemory();
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Allocation counting is disabled by default since it adds an atomic increment to every alloc/realloc, enable it when profiling
+        EE_SYSTEM_API void SetAllocationTrackingEnabled( bool isEnabled );
+        EE_SYSTEM_API bool IsAllocationTrackingEnabled();
+
+        // Total number of allocation (and reallocation) requests made through the engine allocator while tracking was enabled
+        EE_SYSTEM_API uint64_t GetNumAllocations();
+        #endif
     }
 
     //-------------------------------------------------------------------------
@@ -0,0 +1,423 @@
+#include "ResourceCompression.h"
+#include "System/Math/Math.h"
+#include <eastl/algorithm.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource::Compression
+{
+    constexpr static uint32_t const s_uncompressedChunkFlag = 0x80000000;
+    constexpr static int32_t const s_minMatchLength = 4;
+    constexpr static int32_t const s_maxMatchOffset = 65535;
+
+    // The LZ4 block format requires the last 5 bytes to be literals and the last match to start at least 12 bytes before the end of the block
+    constexpr static int32_t const s_numLastLiterals = 5;
+    constexpr static int32_t const s_matchFindLimit = 12;
+
+    //-------------------------------------------------------------------------
+
+    char const* GetCompressionTypeName( CompressionType type )
+    {
+        switch ( type )
+        {
+            case CompressionType::None: return "None";
+            case CompressionType::LZ4: return "LZ4";
+            case CompressionType::LZ4HC: return "LZ4HC";
+        }
+
+        EE_UNREACHABLE_CODE();
+        return nullptr;
+    }
+
+    //-------------------------------------------------------------------------
+    // Decompression
+    //-------------------------------------------------------------------------
+
+    static bool DecompressBlock( uint8_t const* pSrc, size_t srcSize, uint8_t* pDst, size_t dstSize )
+    {
+        uint8_t const* pIn = pSrc;
+        uint8_t const* const pInEnd = pSrc + srcSize;
+        uint8_t* pOut = pDst;
+        uint8_t* const pOutEnd = pDst + dstSize;
+
+        auto ReadLength = [&pIn, pInEnd] ( size_t& length ) -> bool
+        {
+            uint8_t value = 255;
+            while ( value == 255 )
+            {
+                if ( pIn >= pInEnd )
+                {
+                    return false;
+                }
+
+                value = *pIn++;
+                length += value;
+            }
+
+            return true;
+        };
+
+        //-------------------------------------------------------------------------
+
+        while ( pIn < pInEnd )
+        {
+            uint8_t const token = *pIn++;
+
+            // Literals
+            size_t literalLength = token >> 4;
+            if ( literalLength == 15 && !ReadLength( literalLength ) )
+            {
+                return false;
+            }
+
+            if ( literalLength > size_t( pInEnd - pIn ) || literalLength > size_t( pOutEnd - pOut ) )
+            {
+                return false;
+            }
+
+            memcpy( pOut, pIn, literalLength );
+            pIn += literalLength;
+            pOut += literalLength;
+
+            // The last sequence only contains literals
+            if ( pIn == pInEnd )
+            {
+                break;
+            }
+
+            // Match
+            if ( ( pInEnd - pIn ) < 2 )
+            {
+                return false;
+            }
+
+            size_t const offset = size_t( pIn[0] ) | ( size_t( pIn[1] ) << 8 );
+            pIn += 2;
+
+            if ( offset == 0 || offset > size_t( pOut - pDst ) )
+            {
+                return false;
+            }
+
+            size_t matchLength = token & 0x0F;
+            if ( matchLength == 15 && !ReadLength( matchLength ) )
+            {
+                return false;
+            }
+
+            matchLength += s_minMatchLength;
+            if ( matchLength > size_t( pOutEnd - pOut ) )
+            {
+                return false;
+            }
+
+            // Matches can overlap the output so we need to copy byte by byte
+            uint8_t const* pMatch = pOut - offset;
+            for ( size_t i = 0; i < matchLength; i++ )
+            {
+                pOut[i] = pMatch[i];
+            }
+            pOut += matchLength;
+        }
+
+        return pOut == pOutEnd;
+    }
+
+    bool Decompress( uint8_t const* pCompressedData, size_t compressedDataSize, uint8_t* pOutData, size_t dataSize )
+    {
+        EE_ASSERT( ( pCompressedData != nullptr && pOutData != nullptr ) || dataSize == 0 );
+
+        uint8_t const* pIn = pCompressedData;
+        uint8_t const* const pInEnd = pCompressedData + compressedDataSize;
+        size_t outOffset = 0;
+
+        while ( outOffset < dataSize )
+        {
+            if ( size_t( pInEnd - pIn ) < sizeof( uint32_t ) )
+            {
+                return false;
+            }
+
+            uint32_t chunkHeader;
+            memcpy( &chunkHeader, pIn, sizeof( uint32_t ) );
+            pIn += sizeof( uint32_t );
+
+            size_t const storedSize = chunkHeader & ~s_uncompressedChunkFlag;
+            size_t const chunkSize = Math::Min( dataSize - outOffset, (size_t) s_chunkSize );
+            if ( storedSize > size_t( pInEnd - pIn ) )
+            {
+                return false;
+            }
+
+            if ( ( chunkHeader & s_uncompressedChunkFlag ) != 0 )
+            {
+                if ( storedSize != chunkSize )
+                {
+                    return false;
+                }
+
+                memcpy( pOutData + outOffset, pIn, chunkSize );
+            }
+            else if ( !DecompressBlock( pIn, storedSize, pOutData + outOffset, chunkSize ) )
+            {
+                return false;
+            }
+
+            pIn += storedSize;
+            outOffset += chunkSize;
+        }
+
+        return pIn == pInEnd;
+    }
+
+    //-------------------------------------------------------------------------
+    // Compression
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    class BlockCompressor
+    {
+        constexpr static int32_t const s_hashLog = 16;
+        constexpr static int32_t const s_maxChainSearchDepth = 64;
+
+    public:
+
+        BlockCompressor( bool useHashChain )
+            : m_useHashChain( useHashChain )
+        {
+            m_hashTable.resize( 1 << s_hashLog );
+            if ( m_useHashChain )
+            {
+                m_chainTable.resize( s_chunkSize );
+            }
+        }
+
+        // Returns the compressed size or 0 if the block doesnt fit in the output buffer
+        size_t Compress( uint8_t const* pSrc, int32_t srcSize, uint8_t* pDst, size_t dstCapacity )
+        {
+            m_pSrc = pSrc;
+            m_pOut = pDst;
+            m_pOutEnd = pDst + dstCapacity;
+            eastl::fill( m_hashTable.begin(), m_hashTable.end(), InvalidIndex );
+
+            //-------------------------------------------------------------------------
+
+            int32_t const matchEndLimit = srcSize - s_numLastLiterals;
+            int32_t const matchStartLimit = srcSize - s_matchFindLimit;
+
+            int32_t anchor = 0;
+            int32_t pos = 0;
+            while ( pos <= matchStartLimit )
+            {
+                int32_t matchPos = InvalidIndex;
+                int32_t const matchLength = FindMatch( pos, matchEndLimit, matchPos );
+                Insert( pos );
+
+                if ( matchLength < s_minMatchLength )
+                {
+                    pos++;
+                    continue;
+                }
+
+                if ( !WriteSequence( anchor, pos - anchor, pos - matchPos, matchLength ) )
+                {
+                    return 0;
+                }
+
+                // Keep the chains complete so later matches can reference the data we skipped
+                int32_t const matchEnd = pos + matchLength;
+                if ( m_useHashChain )
+                {
+                    for ( int32_t i = pos + 1; i < matchEnd && i <= matchStartLimit; i++ )
+                    {
+                        Insert( i );
+                    }
+                }
+
+                pos = matchEnd;
+                anchor = pos;
+            }
+
+            // Last literals
+            if ( !WriteSequence( anchor, srcSize - anchor, 0, 0 ) )
+            {
+                return 0;
+            }
+
+            return m_pOut - pDst;
+        }
+
+    private:
+
+        inline uint32_t Read32( int32_t pos ) const
+        {
+            uint32_t value;
+            memcpy( &value, m_pSrc + pos, sizeof( uint32_t ) );
+            return value;
+        }
+
+        inline uint32_t Hash( int32_t pos ) const
+        {
+            return ( Read32( pos ) * 2654435761u ) >> ( 32 - s_hashLog );
+        }
+
+        inline void Insert( int32_t pos )
+        {
+            uint32_t const hash = Hash( pos );
+            if ( m_useHashChain )
+            {
+                m_chainTable[pos] = m_hashTable[hash];
+            }
+            m_hashTable[hash] = pos;
+        }
+
+        inline int32_t GetMatchLength( int32_t pos, int32_t candidatePos, int32_t matchEndLimit ) const
+        {
+            int32_t length = 0;
+            while ( ( pos + length ) < matchEndLimit && m_pSrc[pos + length] == m_pSrc[candidatePos + length] )
+            {
+                length++;
+            }
+            return length;
+        }
+
+        int32_t FindMatch( int32_t pos, int32_t matchEndLimit, int32_t& outMatchPos ) const
+        {
+            int32_t bestLength = 0;
+            int32_t candidatePos = m_hashTable[Hash( pos )];
+            int32_t const maxDepth = m_useHashChain ? s_maxChainSearchDepth : 1;
+
+            for ( int32_t depth = 0; depth < maxDepth && candidatePos != InvalidIndex; depth++ )
+            {
+                if ( ( pos - candidatePos ) > s_maxMatchOffset )
+                {
+                    break;
+                }
+
+                if ( Read32( candidatePos ) == Read32( pos ) )
+                {
+                    int32_t const length = GetMatchLength( pos, candidatePos, matchEndLimit );
+                    if ( length > bestLength )
+                    {
+                        bestLength = length;
+                        outMatchPos = candidatePos;
+                    }
+                }
+
+                candidatePos = m_useHashChain ? m_chainTable[candidatePos] : InvalidIndex;
+            }
+
+            return bestLength;
+        }
+
+        inline bool WriteLength( size_t length )
+        {
+            while ( length >= 255 )
+            {
+                if ( m_pOut >= m_pOutEnd )
+                {
+                    return false;
+                }
+
+                *m_pOut++ = 255;
+                length -= 255;
+            }
+
+            if ( m_pOut >= m_pOutEnd )
+            {
+                return false;
+            }
+
+            *m_pOut++ = (uint8_t) length;
+            return true;
+        }
+
+        // A match length of 0 signifies the final literal only sequence
+        bool WriteSequence( int32_t literalStart, int32_t literalLength, int32_t matchOffset, int32_t matchLength )
+        {
+            if ( m_pOut >= m_pOutEnd )
+            {
+                return false;
+            }
+
+            int32_t const encodedMatchLength = ( matchLength > 0 ) ? matchLength - s_minMatchLength : 0;
+            uint8_t* pToken = m_pOut++;
+            *pToken = uint8_t( ( Math::Min( literalLength, 15 ) << 4 ) | Math::Min( encodedMatchLength, 15 ) );
+
+            if ( literalLength >= 15 && !WriteLength( literalLength - 15 ) )
+            {
+                return false;
+            }
+
+            if ( literalLength > ( m_pOutEnd - m_pOut ) )
+            {
+                return false;
+            }
+
+            memcpy( m_pOut, m_pSrc + literalStart, literalLength );
+            m_pOut += literalLength;
+
+            if ( matchLength == 0 )
+            {
+                return true;
+            }
+
+            if ( ( m_pOutEnd - m_pOut ) < 2 )
+            {
+                return false;
+            }
+
+            *m_pOut++ = uint8_t( matchOffset & 0xFF );
+            *m_pOut++ = uint8_t( matchOffset >> 8 );
+
+            if ( encodedMatchLength >= 15 && !WriteLength( encodedMatchLength - 15 ) )
+            {
+                return false;
+            }
+
+            return true;
+        }
+
+    private:
+
+        TVector<int32_t>        m_hashTable;
+        TVector<int32_t>        m_chainTable;
+        uint8_t const*          m_pSrc = nullptr;
+        uint8_t*                m_pOut = nullptr;
+        uint8_t*                m_pOutEnd = nullptr;
+        bool const              m_useHashChain = false;
+    };
+
+    //-------------------------------------------------------------------------
+
+    void Compress( CompressionType type, uint8_t const* pData, size_t dataSize, Blob& outCompressedData )
+    {
+        EE_ASSERT( type != CompressionType::None );
+        EE_ASSERT( pData != nullptr || dataSize == 0 );
+
+        outCompressedData.clear();
+        outCompressedData.reserve( dataSize + ( ( dataSize / s_chunkSize ) + 1 ) * sizeof( uint32_t ) );
+
+        BlockCompressor compressor( type == CompressionType::LZ4HC );
+
+        for ( size_t offset = 0; offset < dataSize; offset += s_chunkSize )
+        {
+            uint32_t const chunkSize = (uint32_t) Math::Min( dataSize - offset, (size_t) s_chunkSize );
+            size_t const chunkHeaderOffset = outCompressedData.size();
+            outCompressedData.resize( chunkHeaderOffset + sizeof( uint32_t ) + chunkSize );
+            uint8_t* pChunkData = outCompressedData.data() + chunkHeaderOffset + sizeof( uint32_t );
+
+            // Only keep the compressed data if it is actually smaller
+            uint32_t chunkHeader = (uint32_t) compressor.Compress( pData + offset, chunkSize, pChunkData, chunkSize - 1 );
+            if ( chunkHeader == 0 )
+            {
+                memcpy( pChunkData, pData + offset, chunkSize );
+                chunkHeader = chunkSize | s_uncompressedChunkFlag;
+            }
+
+            memcpy( outCompressedData.data() + chunkHeaderOffset, &chunkHeader, sizeof( uint32_t ) );
+            outCompressedData.resize( chunkHeaderOffset + sizeof( uint32_t ) + ( chunkHeader & ~s_uncompressedChunkFlag ) );
+        }
+    }
+    #endif
+}
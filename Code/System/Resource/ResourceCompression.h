@@ -0,0 +1,45 @@
+#pragma once
+
+#include "System/_Module/API.h"
+#include "System/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Resource Compression
+//-------------------------------------------------------------------------
+// Compiled resource data is optionally compressed by the resource server, the compression type is stored in the resource header
+// Both compression modes produce LZ4 block format data so they share a single (fast) decompressor:
+//
+// LZ4      - Greedy match search, fast to compress, use for data that is frequently recompiled (i.e. animation)
+// LZ4HC    - Exhaustive hash chain match search, slower to compress but gives a better ratio, use for large static data (i.e. meshes, navmesh)
+//
+// The data is split into independent fixed size chunks so that incompressible chunks can be stored as is
+// Note: The loader currently decompresses all chunks once the read completes, overlapping the chunk decompression with the I/O is not supported
+// Chunk layout: [uint32_t chunk size (high bit set if the chunk is stored uncompressed)][chunk data]
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    enum class CompressionType : uint8_t
+    {
+        None = 0,
+        LZ4,
+        LZ4HC,
+    };
+
+    //-------------------------------------------------------------------------
+
+    namespace Compression
+    {
+        constexpr static uint32_t const s_chunkSize = 64 * 1024;
+
+        EE_SYSTEM_API char const* GetCompressionTypeName( CompressionType type );
+
+        // Decompress all the chunks in the supplied data, the output buffer needs to be exactly the size of the uncompressed data
+        EE_SYSTEM_API bool Decompress( uint8_t const* pCompressedData, size_t compressedDataSize, uint8_t* pOutData, size_t dataSize );
+
+        #if EE_DEVELOPMENT_TOOLS
+        // Compress the supplied data, chunks that dont compress are stored uncompressed
+        EE_SYSTEM_API void Compress( CompressionType type, uint8_t const* pData, size_t dataSize, Blob& outCompressedData );
+        #endif
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ResourceID.h"
+#include "ResourceCompression.h"
 #include "System/Serialization/BinarySerialization.h"
 
 //-------------------------------------------------------------------------
@@ -10,9 +11,10 @@ namespace EE
     namespace Resource
     {
         // Describes the contents of a resource, every resource has a header
+        // If the resource is compressed, the compressed data is stored directly after the header and makes up the remainder of the file
         struct ResourceHeader
         {
-            EE_SERIALIZE( m_version, m_resourceType, m_installDependencies );
+            EE_SERIALIZE( m_version, m_resourceType, m_installDependencies, m_compressionType, m_compressedSize, m_uncompressedSize );
 
         public:
 
@@ -27,12 +29,16 @@ namespace EE
 
             ResourceTypeID GetResourceTypeID() const { return m_resourceType; }
             void AddInstallDependency( ResourceID resourceID ) { m_installDependencies.push_back( resourceID ); }
+            inline bool IsCompressed() const { return m_compressionType != CompressionType::None; }
 
         public:
 
             int32_t                     m_version;
             ResourceTypeID          m_resourceType;
             TVector<ResourceID>     m_installDependencies;
+            CompressionType         m_compressionType = CompressionType::None;
+            uint32_t                m_compressedSize = 0;
+            uint32_t                m_uncompressedSize = 0;
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "ResourceIOQueue.h"
+#include "ResourceRequest.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Memory/Memory.h"
+#include "System/Profiling.h"
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    ResourceIOQueue::~ResourceIOQueue()
+    {
+        EE_ASSERT( m_ioThreads.empty() && !IsBusy() );
+    }
+
+    void ResourceIOQueue::Initialize()
+    {
+        EE_ASSERT( m_ioThreads.empty() );
+
+        m_exitIOThreads = false;
+        for ( int32_t i = 0; i < s_numIOThreads; i++ )
+        {
+            m_ioThreads.emplace_back( [this, i] () { ProcessReads( i ); } );
+        }
+    }
+
+    void ResourceIOQueue::Shutdown()
+    {
+        EE_ASSERT( !IsBusy() );
+
+        {
+            Threading::ScopeLock lock( m_ioThreadMutex );
+            m_exitIOThreads = true;
+        }
+        m_ioThreadCondition.notify_all();
+
+        for ( auto& thread : m_ioThreads )
+        {
+            thread.join();
+        }
+        m_ioThreads.clear();
+    }
+
+    bool ResourceIOQueue::IsBusy() const
+    {
+        Threading::ScopeLock lock( m_mutex );
+        return !m_inFlightReads.empty() || !m_queuedReads.empty();
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceIOQueue::QueueRead( ResourceRequest* pRequest )
+    {
+        EE_ASSERT( pRequest != nullptr );
+
+        auto pRead = EE::New<ReadRequest>();
+        pRead->m_pRequest = pRequest;
+        pRead->m_pMappedData = pRequest->GetMappedRawResourceData();
+        pRead->m_mappedDataSize = pRequest->GetMappedRawResourceDataSize();
+
+        if ( pRead->m_pMappedData == nullptr )
+        {
+            pRead->m_filePath = pRequest->GetRawResourcePath();
+            EE_ASSERT( pRead->m_filePath.IsValid() );
+        }
+
+        Threading::ScopeLock lock( m_mutex );
+        m_queuedReads.emplace_back( pRead );
+    }
+
+    void ResourceIOQueue::CancelRead( ResourceRequest* pRequest )
+    {
+        EE_ASSERT( pRequest != nullptr );
+        Threading::ScopeLock lock( m_mutex );
+
+        // If the read hasnt been issued yet, just remove it
+        for ( int32_t i = 0; i < (int32_t) m_queuedReads.size(); i++ )
+        {
+            if ( m_queuedReads[i]->m_pRequest == pRequest )
+            {
+                EE::Delete( m_queuedReads[i] );
+                m_queuedReads.erase( m_queuedReads.begin() + i );
+                return;
+            }
+        }
+
+        // Otherwise discard the result once the read completes
+        for ( auto pRead : m_inFlightReads )
+        {
+            if ( pRead->m_pRequest == pRequest )
+            {
+                pRead->m_pRequest = nullptr;
+                return;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceIOQueue::Update()
+    {
+        EE_PROFILE_FUNCTION_IO();
+        Threading::ScopeLock lock( m_mutex );
+
+        // Hand back all completed reads immediately and free up their slots, we dont want a slow read to stall any of the other reads
+        for ( int32_t i = (int32_t) m_inFlightReads.size() - 1; i >= 0; i-- )
+        {
+            ReadRequest* pRead = m_inFlightReads[i];
+            if ( pRead->m_isComplete.load( std::memory_order_acquire ) )
+            {
+                DeliverRead( pRead );
+                EE::Delete( pRead );
+                m_inFlightReads.erase( m_inFlightReads.begin() + i );
+            }
+        }
+
+        if ( m_inFlightReads.empty() && m_stats.m_numInFlightReads > 0 )
+        {
+            m_stats.m_totalBusyTime += m_busyTimer.GetElapsedTimeMilliseconds();
+        }
+
+        IssueQueuedReads();
+
+        m_stats.m_numQueuedReads = (int32_t) m_queuedReads.size();
+        m_stats.m_numInFlightReads = (int32_t) m_inFlightReads.size();
+    }
+
+    void ResourceIOQueue::IssueQueuedReads()
+    {
+        int32_t const numReadsToIssue = Math::Min( (int32_t) m_queuedReads.size(), s_maxInFlightReads - (int32_t) m_inFlightReads.size() );
+        if ( numReadsToIssue <= 0 )
+        {
+            return;
+        }
+
+        // Sort the reads by priority, within each priority the package data is read in offset order and file reads are left in the order they were requested
+        // The priority is read from the request since it can change while the read is queued, queued reads are removed when cancelled so they always have a request
+        //-------------------------------------------------------------------------
+
+        auto Comparator = [] ( ReadRequest const* pA, ReadRequest const* pB )
+        {
+            LoadPriority const priorityA = pA->m_pRequest->GetLoadPriority();
+            LoadPriority const priorityB = pB->m_pRequest->GetLoadPriority();
+            if ( priorityA != priorityB )
+            {
+                return priorityA < priorityB;
+            }
+
+            if ( pA->m_pMappedData != nullptr && pB->m_pMappedData != nullptr )
+            {
+                return pA->m_pMappedData < pB->m_pMappedData;
+            }
+
+            return pA->m_pMappedData != nullptr && pB->m_pMappedData == nullptr;
+        };
+
+        eastl::stable_sort( m_queuedReads.begin(), m_queuedReads.end(), Comparator );
+
+        // Issue the reads to the I/O threads
+        //-------------------------------------------------------------------------
+
+        if ( m_inFlightReads.empty() )
+        {
+            m_busyTimer.Start();
+        }
+
+        m_inFlightReads.insert( m_inFlightReads.end(), m_queuedReads.begin(), m_queuedReads.begin() + numReadsToIssue );
+
+        {
+            Threading::ScopeLock ioLock( m_ioThreadMutex );
+            m_issuedReads.insert( m_issuedReads.end(), m_queuedReads.begin(), m_queuedReads.begin() + numReadsToIssue );
+        }
+        m_ioThreadCondition.notify_all();
+
+        m_queuedReads.erase( m_queuedReads.begin(), m_queuedReads.begin() + numReadsToIssue );
+    }
+
+    void ResourceIOQueue::DeliverRead( ReadRequest* pRead )
+    {
+        EE_ASSERT( !pRead->m_isDelivered );
+        pRead->m_isDelivered = true;
+
+        // Update stats
+        //-------------------------------------------------------------------------
+
+        if ( pRead->m_wasSuccessful )
+        {
+            Milliseconds const latency = pRead->m_latencyTimer.GetElapsedTimeMilliseconds();
+            m_stats.m_numCompletedReads++;
+            m_stats.m_numBytesRead += ( pRead->m_pMappedData != nullptr ) ? pRead->m_mappedDataSize : pRead->m_data.size();
+            m_stats.m_totalLatency += latency;
+            m_stats.m_maxLatency = Math::Max( m_stats.m_maxLatency.ToFloat(), latency.ToFloat() );
+        }
+        else
+        {
+            m_stats.m_numFailedReads++;
+        }
+
+        // Hand the data back to the request - cancelled requests may already have been deleted
+        //-------------------------------------------------------------------------
+
+        if ( pRead->m_pRequest != nullptr )
+        {
+            pRead->m_pRequest->OnRawResourceReadComplete( pRead->m_wasSuccessful, pRead->m_data, pRead->m_readTime );
+            pRead->m_pRequest = nullptr;
+        }
+    }
+
+    void ResourceIOQueue::ProcessReads( int32_t threadIdx )
+    {
+        Memory::InitializeThreadHeap();
+
+        char nameBuffer[100];
+        Printf( nameBuffer, 100, "EE I/O %d", threadIdx );
+        EE_PROFILE_THREAD_START( nameBuffer );
+        Threading::SetCurrentThreadName( nameBuffer );
+
+        //-------------------------------------------------------------------------
+
+        while ( true )
+        {
+            ReadRequest* pRead = nullptr;
+
+            {
+                Threading::Lock lock( m_ioThreadMutex );
+                m_ioThreadCondition.wait( lock, [this] () { return m_exitIOThreads || !m_issuedReads.empty(); } );
+
+                if ( m_exitIOThreads )
+                {
+                    break;
+                }
+
+                pRead = m_issuedReads.front();
+                m_issuedReads.erase( m_issuedReads.begin() );
+            }
+
+            ExecuteRead( pRead );
+        }
+
+        //-------------------------------------------------------------------------
+
+        EE_PROFILE_THREAD_END();
+        Memory::ShutdownThreadHeap();
+    }
+
+    void ResourceIOQueue::ExecuteRead( ReadRequest* pRead )
+    {
+        Timer<PlatformClock> timer;
+
+        if ( pRead->m_pMappedData != nullptr )
+        {
+            EE_PROFILE_SCOPE_IO( "Prefetch Mapped Data" );
+
+            // Touch each page so that the loader doesnt page fault its way through the data
+            constexpr static size_t const pageSize = 4096;
+            uint8_t volatile touch = 0;
+            for ( size_t offset = 0; offset < pRead->m_mappedDataSize; offset += pageSize )
+            {
+                touch += pRead->m_pMappedData[offset];
+            }
+
+            pRead->m_wasSuccessful = true;
+        }
+        else
+        {
+            EE_PROFILE_SCOPE_IO( "Read File" );
+            EE_PROFILE_TAG( "filename", pRead->m_filePath.GetFilename().c_str() );
+            pRead->m_wasSuccessful = FileSystem::LoadFile( pRead->m_filePath, pRead->m_data );
+        }
+
+        pRead->m_readTime = timer.GetElapsedTimeMilliseconds();
+        pRead->m_isComplete.store( true, std::memory_order_release );
+    }
+}
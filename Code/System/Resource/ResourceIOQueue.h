@@ -0,0 +1,119 @@
+#pragma once
+
+#include "System/_Module/API.h"
+#include "ResourceRecord.h"
+#include "System/FileSystem/FileSystemPath.h"
+#include "System/Threading/Threading.h"
+#include "System/Time/Timers.h"
+#include "System/Types/Arrays.h"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
+//-------------------------------------------------------------------------
+// Resource I/O Queue
+//-------------------------------------------------------------------------
+// Performs the raw data reads for all resource requests, so that a single slow read doesnt stall every other request.
+// The reads are blocking so they run on a small set of dedicated I/O threads rather than on the task system workers, where they would stall other work.
+// Queued reads are sorted by their request's current priority and then by their location (package data in offset order, then loose files) and issued to the I/O threads.
+// We keep a rolling window of in-flight reads: each read is handed back to its request as soon as it completes and its slot is refilled from the queue on the next update.
+// For memory mapped data there is nothing to read, so we just touch the mapped pages to get them resident before the loader deserializes them.
+//
+// Queue/Cancel are called from the resource system's async task, Update must only be called when that task isnt running.
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class ResourceRequest;
+
+    //-------------------------------------------------------------------------
+
+    class EE_SYSTEM_API ResourceIOQueue
+    {
+        constexpr static int32_t const s_numIOThreads = 2;
+
+        // The max number of reads issued to the I/O threads at once, reads that are still queued can be reordered by later higher priority requests
+        constexpr static int32_t const s_maxInFlightReads = 8;
+
+        struct ReadRequest
+        {
+            ResourceRequest*                    m_pRequest = nullptr; // Cleared if the request is cancelled while the read is in flight
+            FileSystem::Path                    m_filePath;
+            uint8_t const*                      m_pMappedData = nullptr;
+            size_t                              m_mappedDataSize = 0;
+            Blob                                m_data;
+            Timer<PlatformClock>                m_latencyTimer;
+            Milliseconds                        m_readTime = 0.0f;
+            std::atomic<bool>                   m_isComplete = false;
+            bool                                m_wasSuccessful = false;
+            bool                                m_isDelivered = false;
+        };
+
+    public:
+
+        struct Stats
+        {
+            uint64_t                            m_numCompletedReads = 0;
+            uint64_t                            m_numFailedReads = 0;
+            uint64_t                            m_numBytesRead = 0;
+            Milliseconds                        m_totalLatency = 0.0f;      // Time from queuing a read to handing the data back to the request
+            Milliseconds                        m_maxLatency = 0.0f;
+            Milliseconds                        m_totalBusyTime = 0.0f;     // Wall time spent with at least one read in flight
+            int32_t                             m_numQueuedReads = 0;
+            int32_t                             m_numInFlightReads = 0;
+
+            inline Milliseconds GetAverageLatency() const { return ( m_numCompletedReads > 0 ) ? Milliseconds( m_totalLatency.ToFloat() / m_numCompletedReads ) : Milliseconds( 0.0f ); }
+
+            // Throughput in MB/s
+            inline float GetThroughput() const { return ( m_totalBusyTime > 0.0f ) ? ( float( m_numBytesRead ) / ( 1024.0f * 1024.0f ) ) / m_totalBusyTime.ToSeconds().ToFloat() : 0.0f; }
+        };
+
+    public:
+
+        ResourceIOQueue() = default;
+        ~ResourceIOQueue();
+
+        // Start/stop the I/O threads, all reads need to have completed before shutting down
+        void Initialize();
+        void Shutdown();
+
+        // Do we have any queued or in-flight reads
+        bool IsBusy() const;
+
+        // Queue the raw data read for a request, the request will be notified via 'OnRawResourceReadComplete'
+        void QueueRead( ResourceRequest* pRequest );
+
+        // Cancel a queued read, if the read is already in flight the result will be discarded
+        void CancelRead( ResourceRequest* pRequest );
+
+        // Hand back completed reads and issue queued reads to fill the free in-flight slots
+        void Update();
+
+        inline Stats const& GetStats() const { return m_stats; }
+
+    private:
+
+        ResourceIOQueue( ResourceIOQueue const& ) = delete;
+        ResourceIOQueue& operator=( ResourceIOQueue const& ) = delete;
+
+        void IssueQueuedReads();
+        void DeliverRead( ReadRequest* pRead );
+        void ProcessReads( int32_t threadIdx );
+        static void ExecuteRead( ReadRequest* pRead );
+
+    private:
+
+        mutable Threading::Mutex                m_mutex;
+        TVector<ReadRequest*>                   m_queuedReads;
+        TVector<ReadRequest*>                   m_inFlightReads;
+        Timer<PlatformClock>                    m_busyTimer;
+        Stats                                   m_stats;
+
+        // I/O threads - the issued reads are consumed in order, the mutex only protects the issued reads and the exit flag
+        TVector<std::thread>                    m_ioThreads;
+        Threading::Mutex                        m_ioThreadMutex;
+        Threading::ConditionVariable            m_ioThreadCondition;
+        TVector<ReadRequest*>                   m_issuedReads;
+        bool                                    m_exitIOThreads = false;
+    };
+}
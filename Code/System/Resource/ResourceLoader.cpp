@@ -1,21 +1,50 @@
 #include "ResourceLoader.h"
 #include "ResourceHeader.h"
 #include "System/Serialization/BinarySerialization.h"
+#include "System/Profiling.h"
 #include "System/Log.h"
 
 //-------------------------------------------------------------------------
 
 namespace EE::Resource
 {
-    bool ResourceLoader::Load( ResourceID const& resourceID, Blob& rawData, ResourceRecord* pResourceRecord ) const
+    bool ResourceLoader::Load( ResourceID const& resourceID, uint8_t const* pRawData, size_t rawDataSize, ResourceRecord* pResourceRecord ) const
     {
+        EE_ASSERT( pRawData != nullptr && rawDataSize > 0 );
+
         Serialization::BinaryInputArchive archive;
-        archive.ReadFromBlob( rawData );
+        archive.ReadFromData( pRawData, rawDataSize );
 
         // Read resource header
         Resource::ResourceHeader header;
         archive << header;
 
+        // Decompress the resource data and continue reading from the decompressed data
+        Blob decompressedData;
+        if ( header.IsCompressed() )
+        {
+            EE_PROFILE_SCOPE_RESOURCE( "Decompress Resource" );
+
+            if ( header.m_compressedSize > rawDataSize )
+            {
+                EE_LOG_ERROR( "Resource", "Resource Loader", "Invalid compressed data size for resource: %s", resourceID.c_str() );
+                return false;
+            }
+
+            decompressedData.resize( header.m_uncompressedSize );
+            uint8_t const* pCompressedData = pRawData + ( rawDataSize - header.m_compressedSize );
+            if ( !Compression::Decompress( pCompressedData, header.m_compressedSize, decompressedData.data(), decompressedData.size() ) )
+            {
+                EE_LOG_ERROR( "Resource", "Resource Loader", "Failed to decompress resource: %s", resourceID.c_str() );
+                return false;
+            }
+
+            archive.ReadFromBlob( decompressedData );
+        }
+
+        // The deserialized resource is roughly the same size as its serialized data
+        pResourceRecord->m_residentSize = header.IsCompressed() ? ( rawDataSize - header.m_compressedSize + header.m_uncompressedSize ) : rawDataSize;
+
         // Set all install dependencies
         pResourceRecord->m_installDependencyResourceIDs.reserve( header.m_installDependencies.size() );
         for ( auto const& depResourceID : header.m_installDependencies )
@@ -0,0 +1,169 @@
+#include "ResourcePackage.h"
+#include "System/FileSystem/FileStreams.h"
+#include "System/Memory/Memory.h"
+#include "System/Log.h"
+#include <eastl/sort.h>
+#include <eastl/algorithm.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    bool ResourcePackage::Open( FileSystem::Path const& packagePath )
+    {
+        EE_ASSERT( !IsOpen() );
+
+        if ( !m_mappedFile.Open( packagePath.c_str() ) )
+        {
+            return false;
+        }
+
+        // Validate header
+        //-------------------------------------------------------------------------
+
+        uint8_t const* pPackageData = m_mappedFile.GetData();
+        size_t const packageSize = m_mappedFile.GetSize();
+
+        Header const* pHeader = reinterpret_cast<Header const*>( pPackageData );
+        if ( packageSize < sizeof( Header ) || pHeader->m_magic != s_magic || pHeader->m_version != s_version )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Package", "Invalid resource package: %s", packagePath.c_str() );
+            m_mappedFile.Close();
+            return false;
+        }
+
+        if ( packageSize < ( sizeof( Header ) + ( sizeof( Entry ) * pHeader->m_numEntries ) ) )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Package", "Truncated resource package: %s", packagePath.c_str() );
+            m_mappedFile.Close();
+            return false;
+        }
+
+        //-------------------------------------------------------------------------
+
+        m_pEntries = reinterpret_cast<Entry const*>( pPackageData + sizeof( Header ) );
+        m_numEntries = pHeader->m_numEntries;
+        return true;
+    }
+
+    void ResourcePackage::Close()
+    {
+        m_pEntries = nullptr;
+        m_numEntries = 0;
+        m_mappedFile.Close();
+    }
+
+    ResourcePackage::Entry const* ResourcePackage::FindEntry( ResourceID const& resourceID ) const
+    {
+        EE_ASSERT( IsOpen() );
+
+        uint32_t const pathID = resourceID.GetPathID();
+        Entry const* pEnd = m_pEntries + m_numEntries;
+        Entry const* pFoundEntry = eastl::lower_bound( m_pEntries, pEnd, pathID, [] ( Entry const& entry, uint32_t ID ) { return entry.m_pathID < ID; } );
+        if ( pFoundEntry == pEnd || pFoundEntry->m_pathID != pathID )
+        {
+            return nullptr;
+        }
+
+        return pFoundEntry;
+    }
+
+    bool ResourcePackage::TryGetResourceData( ResourceID const& resourceID, uint8_t const*& pOutData, size_t& outSize ) const
+    {
+        Entry const* pEntry = FindEntry( resourceID );
+        if ( pEntry == nullptr )
+        {
+            return false;
+        }
+
+        EE_ASSERT( ( pEntry->m_offset + pEntry->m_size ) <= m_mappedFile.GetSize() );
+        pOutData = m_mappedFile.GetData() + pEntry->m_offset;
+        outSize = pEntry->m_size;
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void ResourcePackageWriter::AddResource( ResourceID const& resourceID, FileSystem::Path const& compiledFilePath )
+    {
+        EE_ASSERT( resourceID.IsValid() && compiledFilePath.IsFilePath() );
+        m_pendingEntries.push_back( { resourceID, compiledFilePath } );
+    }
+
+    bool ResourcePackageWriter::Write( FileSystem::Path const& packagePath, String& outErrorLog )
+    {
+        EE_ASSERT( packagePath.IsFilePath() );
+
+        // Sort the entries by path ID, since that is what we search on at runtime
+        //-------------------------------------------------------------------------
+
+        auto SortPredicate = [] ( PendingEntry const& a, PendingEntry const& b ) { return a.m_resourceID.GetPathID() < b.m_resourceID.GetPathID(); };
+        eastl::sort( m_pendingEntries.begin(), m_pendingEntries.end(), SortPredicate );
+
+        uint32_t const numEntries = (uint32_t) m_pendingEntries.size();
+        for ( uint32_t i = 1; i < numEntries; i++ )
+        {
+            if ( m_pendingEntries[i].m_resourceID.GetPathID() == m_pendingEntries[i - 1].m_resourceID.GetPathID() )
+            {
+                outErrorLog.sprintf( "Resource path ID collision: %s and %s", m_pendingEntries[i - 1].m_resourceID.c_str(), m_pendingEntries[i].m_resourceID.c_str() );
+                return false;
+            }
+        }
+
+        // Write package
+        //-------------------------------------------------------------------------
+
+        FileSystem::OutputFileStream packageFile( packagePath );
+        if ( !packageFile.IsValid() )
+        {
+            outErrorLog.sprintf( "Failed to open package file for writing: %s", packagePath.c_str() );
+            return false;
+        }
+
+        Header header;
+        header.m_numEntries = numEntries;
+        packageFile.Write( &header, sizeof( Header ) );
+
+        // Reserve the table of contents, we only know the entry sizes once we've read the compiled files
+        TVector<Entry> tableOfContents;
+        tableOfContents.resize( numEntries );
+        packageFile.Write( tableOfContents.data(), sizeof( Entry ) * numEntries );
+
+        uint64_t currentOffset = sizeof( Header ) + ( sizeof( Entry ) * numEntries );
+        uint8_t const padding[s_dataAlignment] = { 0 };
+
+        Blob fileData;
+        for ( uint32_t i = 0; i < numEntries; i++ )
+        {
+            PendingEntry const& pendingEntry = m_pendingEntries[i];
+            if ( !FileSystem::LoadFile( pendingEntry.m_compiledFilePath, fileData ) || fileData.empty() )
+            {
+                outErrorLog.sprintf( "Failed to read compiled resource: %s", pendingEntry.m_compiledFilePath.c_str() );
+                return false;
+            }
+
+            size_t const paddingSize = Memory::CalculatePaddingForAlignment( (uintptr_t) currentOffset, s_dataAlignment );
+            if ( paddingSize > 0 )
+            {
+                packageFile.Write( (void*) padding, paddingSize );
+                currentOffset += paddingSize;
+            }
+
+            tableOfContents[i].m_pathID = pendingEntry.m_resourceID.GetPathID();
+            tableOfContents[i].m_size = (uint32_t) fileData.size();
+            tableOfContents[i].m_offset = currentOffset;
+
+            packageFile.Write( fileData.data(), fileData.size() );
+            currentOffset += fileData.size();
+        }
+
+        // Write the final table of contents
+        packageFile.GetStream().seekp( sizeof( Header ) );
+        packageFile.Write( tableOfContents.data(), sizeof( Entry ) * numEntries );
+        packageFile.Close();
+
+        return true;
+    }
+    #endif
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ResourceID.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/FileSystemPath.h"
+
+//-------------------------------------------------------------------------
+// Resource Package
+//-------------------------------------------------------------------------
+// A single file containing all the compiled resources for a packaged build, this avoids the cost of opening/closing thousands of loose files
+// The package is memory mapped at runtime so loaders can deserialize straight from the mapped pages
+//
+// Layout: [Header][Table of contents - sorted by resource path ID][Resource data - each entry aligned to 's_dataAlignment']
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class EE_SYSTEM_API ResourcePackage
+    {
+    public:
+
+        constexpr static char const* const s_defaultFilename = "Resources.eepak";
+        constexpr static uint32_t const s_magic = 0x4B504545; // 'EEPK'
+        constexpr static uint32_t const s_version = 1;
+        constexpr static uint32_t const s_dataAlignment = 16;
+
+        struct Header
+        {
+            uint32_t                m_magic = s_magic;
+            uint32_t                m_version = s_version;
+            uint32_t                m_numEntries = 0;
+            uint32_t                m_dataAlignment = s_dataAlignment;
+        };
+
+        struct Entry
+        {
+            uint32_t                m_pathID = 0;
+            uint32_t                m_size = 0;
+            uint64_t                m_offset = 0; // From the start of the package file
+        };
+
+        static_assert( sizeof( Header ) == 16 && sizeof( Entry ) == 16, "The package layout is read directly from the mapped file" );
+
+    public:
+
+        ResourcePackage() = default;
+        ResourcePackage( ResourcePackage const& ) = delete;
+        ResourcePackage& operator=( ResourcePackage const& ) = delete;
+
+        bool Open( FileSystem::Path const& packagePath );
+        void Close();
+
+        inline bool IsOpen() const { return m_pEntries != nullptr; }
+        inline uint32_t GetNumEntries() const { return m_numEntries; }
+
+        // Get the mapped compiled data for a resource, this data is valid for as long as the package is open
+        bool TryGetResourceData( ResourceID const& resourceID, uint8_t const*& pOutData, size_t& outSize ) const;
+
+    private:
+
+        Entry const* FindEntry( ResourceID const& resourceID ) const;
+
+    private:
+
+        FileSystem::MemoryMappedFile        m_mappedFile;
+        Entry const*                        m_pEntries = nullptr;
+        uint32_t                            m_numEntries = 0;
+    };
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    class EE_SYSTEM_API ResourcePackageWriter
+    {
+        struct PendingEntry
+        {
+            ResourceID              m_resourceID;
+            FileSystem::Path        m_compiledFilePath;
+        };
+
+    public:
+
+        // Add a compiled resource to the package, the file is only read when writing the package
+        void AddResource( ResourceID const& resourceID, FileSystem::Path const& compiledFilePath );
+
+        inline int32_t GetNumResources() const { return (int32_t) m_pendingEntries.size(); }
+
+        // Write out the package file, on failure the error log will contain the reason
+        bool Write( FileSystem::Path const& packagePath, String& outErrorLog );
+
+    private:
+
+        TVector<PendingEntry>               m_pendingEntries;
+    };
+    #endif
+}
@@ -14,11 +14,42 @@ namespace EE::Resource
 
     bool PackagedResourceProvider::Initialize()
     {
+        FileSystem::Path const packagePath = m_settings.m_compiledResourcePath + ResourcePackage::s_defaultFilename;
+        if ( FileSystem::Exists( packagePath ) )
+        {
+            if ( !m_package.Open( packagePath ) )
+            {
+                EE_LOG_ERROR( "Resource", "Packaged Resource Provider", "Failed to open resource package: %s", packagePath.c_str() );
+                return false;
+            }
+        }
+
         return true;
     }
 
+    void PackagedResourceProvider::Shutdown()
+    {
+        m_package.Close();
+    }
+
     void PackagedResourceProvider::RequestRawResource( ResourceRequest* pRequest )
     {
+        if ( m_package.IsOpen() )
+        {
+            uint8_t const* pRawData = nullptr;
+            size_t rawDataSize = 0;
+            if ( m_package.TryGetResourceData( pRequest->GetResourceID(), pRawData, rawDataSize ) )
+            {
+                pRequest->OnRawResourceRequestComplete( pRawData, rawDataSize );
+            }
+            else
+            {
+                pRequest->OnRawResourceRequestComplete( String() );
+            }
+
+            return;
+        }
+
         FileSystem::Path const resourceFilePath = pRequest->GetResourceID().GetResourcePath().ToFileSystemPath( m_settings.m_compiledResourcePath );
         pRequest->OnRawResourceRequestComplete( resourceFilePath.c_str() );
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "System/Resource/ResourceProvider.h"
+#include "System/Resource/ResourcePackage.h"
 
 //-------------------------------------------------------------------------
 
@@ -10,6 +11,7 @@ namespace EE::Resource
 
     //-------------------------------------------------------------------------
 
+    // Resolves requests from the resource package if one exists, otherwise falls back to the loose compiled files
     class EE_SYSTEM_API PackagedResourceProvider final : public ResourceProvider
     {
 
@@ -18,10 +20,18 @@ namespace EE::Resource
         using ResourceProvider::ResourceProvider;
         virtual bool IsReady() const override final;
 
+        // Are we reading from a resource package or from loose files
+        inline bool IsUsingResourcePackage() const { return m_package.IsOpen(); }
+
     private:
 
         virtual bool Initialize() override;
+        virtual void Shutdown() override;
         virtual void RequestRawResource( ResourceRequest* pRequest ) override;
         virtual void CancelRequest( ResourceRequest* pRequest ) override;
+
+    private:
+
+        ResourcePackage                         m_package;
     };
 }
\ No newline at end of file
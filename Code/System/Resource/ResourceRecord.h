@@ -11,6 +11,16 @@
 
 namespace EE::Resource
 {
+    // How urgently a resource is needed, more urgent requests are read, loaded and installed first
+    // Note: Requests have no deadline, a request only completes sooner by being more urgent than the other outstanding requests
+    enum class LoadPriority : uint8_t
+    {
+        Critical = 0,       // Needed right now, ignores the per-frame install budget
+        High,
+        Normal,
+        Background,
+    };
+
     //-------------------------------------------------------------------------
     // A unique record for each requested resource
     //-------------------------------------------------------------------------
@@ -35,6 +45,11 @@ namespace EE::Resource
         inline void SetLoadingStatus( LoadingStatus status ) { m_loadingStatus = status; }
         inline LoadingStatus GetLoadingStatus() const { return m_loadingStatus; }
 
+        inline LoadPriority GetLoadPriority() const { return m_loadPriority; }
+
+        // Get the approximate memory footprint of the loaded resource
+        inline size_t GetResidentSize() const { return m_residentSize; }
+
         inline IResource* GetResourceData() { return m_pResource; }
         inline IResource const* GetResourceData() const { return m_pResource; }
         inline void SetResourceData( IResource* pResourceData ) { m_pResource = pResourceData; }
@@ -46,16 +61,30 @@ namespace EE::Resource
 
         inline bool HasReferences() const { return !m_references.empty(); }
 
-        inline void AddReference( ResourceRequesterID const& requesterID )
+        inline void AddReference( ResourceRequesterID const& requesterID, LoadPriority priority )
         {
             m_references.emplace_back( requesterID );
+            m_referencePriorities.emplace_back( priority );
+            m_loadPriority = ( m_references.size() == 1 || priority < m_loadPriority ) ? priority : m_loadPriority;
         }
 
         inline void RemoveReference( ResourceRequesterID const& requesterID )
         {
             auto iter = eastl::find( m_references.begin(), m_references.end(), requesterID );
             EE_ASSERT( iter != m_references.end() );
+            auto const referenceIdx = iter - m_references.begin();
             m_references.erase_unsorted( iter );
+            m_referencePriorities.erase_unsorted( m_referencePriorities.begin() + referenceIdx );
+
+            // Recalculate the priority from the remaining references, if the most urgent user has released the resource the outstanding work is less urgent
+            if ( !m_referencePriorities.empty() )
+            {
+                m_loadPriority = m_referencePriorities[0];
+                for ( auto referencePriority : m_referencePriorities )
+                {
+                    m_loadPriority = ( referencePriority < m_loadPriority ) ? referencePriority : m_loadPriority;
+                }
+            }
         }
 
         //-------------------------------------------------------------------------
@@ -83,9 +112,15 @@ namespace EE::Resource
         IResource*                              m_pResource = nullptr;                          // The actual loaded resource data
         std::atomic<LoadingStatus>              m_loadingStatus = LoadingStatus::Unloaded;      // The state of this resource (atomic since it will be modify by resource requests which run across multiple frames)
         TVector<ResourceRequesterID>            m_references;                                   // The list of references to this resources
+        TVector<LoadPriority>                   m_referencePriorities;                          // The priority each reference was requested with, matches the order of the references
         TInlineVector<ResourceID, 4>            m_installDependencyResourceIDs;                 // The list of resources that need to be loaded and installed before we can install this resource
+        LoadPriority                            m_loadPriority = LoadPriority::Normal;          // The most urgent priority of all the current references
+        size_t                                  m_residentSize = 0;                             // The size of the serialized resource data, used as an estimate of the memory footprint
+        size_t                                  m_accountedSize = 0;                            // The size currently included in the resource system's memory stats
+        bool                                    m_isCached = false;                             // Is this unreferenced resource being kept loaded by the resource system's cache
 
         #if EE_DEVELOPMENT_TOOLS
+        bool                                    m_isHotReloadRequested = false;                 // Set when the compiled data changes, the resource needs to be reloaded from disk so we cant cache it
         Milliseconds                            m_fileReadTime = 0;
         Milliseconds                            m_loadTime = 0;
         Milliseconds                            m_waitForDependenciesTime = 0;
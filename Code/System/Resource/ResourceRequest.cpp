@@ -1,5 +1,4 @@
 #include "ResourceRequest.h"
-#include "System/FileSystem/FileSystem.h"
 #include "System/Profiling.h"
 #include "System/Threading/Threading.h"
 #include "System/Log.h"
@@ -56,10 +55,46 @@ namespace EE::Resource
         else // Continue the load operation
         {
             m_rawResourcePath = filePath;
-            m_stage = ResourceRequest::Stage::LoadResource;
+            m_pMappedRawResourceData = nullptr;
+            m_mappedRawResourceDataSize = 0;
+            m_stage = ResourceRequest::Stage::ReadRawResource;
         }
     }
 
+    void ResourceRequest::OnRawResourceRequestComplete( uint8_t const* pRawData, size_t rawDataSize )
+    {
+        EE_ASSERT( pRawData != nullptr && rawDataSize > 0 );
+        m_rawResourcePath.Clear();
+        m_pMappedRawResourceData = pRawData;
+        m_mappedRawResourceDataSize = rawDataSize;
+        m_stage = ResourceRequest::Stage::ReadRawResource;
+    }
+
+    void ResourceRequest::OnRawResourceReadComplete( bool wasSuccessful, Blob& rawData, Milliseconds readTime )
+    {
+        EE_ASSERT( m_stage == ResourceRequest::Stage::WaitForRawResourceRead );
+
+        if ( !wasSuccessful )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Request", "Failed to load resource file (%s)", m_pResourceRecord->GetResourceID().c_str() );
+            m_stage = ResourceRequest::Stage::Complete;
+            m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
+            return;
+        }
+
+        // Mapped data is not copied, the read only ensured it is resident
+        if ( m_pMappedRawResourceData == nullptr )
+        {
+            m_rawResourceData.swap( rawData );
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_pResourceRecord->m_fileReadTime = readTime;
+        #endif
+
+        m_stage = ResourceRequest::Stage::LoadResource;
+    }
+
     void ResourceRequest::SwitchToLoadTask()
     {
         EE_ASSERT( m_type == Type::Unload );
@@ -121,8 +156,18 @@ namespace EE::Resource
             }
             break;
 
+            case Stage::WaitForRawResourceRead:
+            {
+                m_stage = Stage::CancelRawResourceRead;
+            }
+            break;
+
+            case Stage::ReadRawResource:
             case Stage::LoadResource:
             {
+                m_rawResourceData.clear();
+                m_pMappedRawResourceData = nullptr;
+                m_mappedRawResourceDataSize = 0;
                 m_stage = Stage::Complete;
                 m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
             }
@@ -175,6 +220,19 @@ namespace EE::Resource
             }
             break;
 
+            case ResourceRequest::Stage::ReadRawResource:
+            {
+                ReadRawResource( requestContext );
+            }
+            break;
+
+            case ResourceRequest::Stage::WaitForRawResourceRead:
+            {
+                // Do Nothing
+                EE_PROFILE_SCOPE_RESOURCE( "Wait For Raw Resource Read" );
+            }
+            break;
+
             case ResourceRequest::Stage::LoadResource:
             {
                 LoadResource( requestContext );
@@ -237,6 +295,12 @@ namespace EE::Resource
             }
             break;
 
+            case ResourceRequest::Stage::CancelRawResourceRead:
+            {
+                CancelRawResourceRead( requestContext );
+            }
+            break;
+
             default:
             {
                 EE_UNREACHABLE_CODE();
@@ -265,31 +329,20 @@ namespace EE::Resource
         requestContext.m_createRawRequestRequestFunction( this );
     }
 
+    void ResourceRequest::ReadRawResource( RequestContext& requestContext )
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( m_stage == ResourceRequest::Stage::ReadRawResource );
+        EE_ASSERT( m_rawResourcePath.IsValid() || m_pMappedRawResourceData != nullptr );
+        m_stage = ResourceRequest::Stage::WaitForRawResourceRead;
+        requestContext.m_readRawResourceFunction( this );
+    }
+
     void ResourceRequest::LoadResource( RequestContext& requestContext )
     {
         EE_PROFILE_FUNCTION_RESOURCE();
         EE_ASSERT( m_stage == ResourceRequest::Stage::LoadResource );
-        EE_ASSERT( m_rawResourcePath.IsValid() );
-
-        // Read file
-        //-------------------------------------------------------------------------
-
-        {
-            EE_PROFILE_SCOPE_IO( "Read File" );
-            EE_PROFILE_TAG( "filename", m_rawResourcePath.GetFilename().c_str() );
-
-            #if EE_DEVELOPMENT_TOOLS
-            ScopedTimer<PlatformClock> timer( m_pResourceRecord->m_fileReadTime );
-            #endif
-
-            if ( !FileSystem::LoadFile( m_rawResourcePath, m_rawResourceData ) )
-            {
-                EE_LOG_ERROR( "Resource", "Resource Request", "Failed to load resource file (%s)", m_pResourceRecord->GetResourceID().c_str() );
-                m_stage = ResourceRequest::Stage::Complete;
-                m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
-                return;
-            }
-        }
+        EE_ASSERT( m_pMappedRawResourceData != nullptr || !m_rawResourceData.empty() );
 
         // Load resource
         //-------------------------------------------------------------------------
@@ -304,13 +357,22 @@ namespace EE::Resource
             #endif
 
             // Load the resource
-            EE_ASSERT( !m_rawResourceData.empty() );
+            uint8_t const* pRawData = ( m_pMappedRawResourceData != nullptr ) ? m_pMappedRawResourceData : m_rawResourceData.data();
+            size_t const rawDataSize = ( m_pMappedRawResourceData != nullptr ) ? m_mappedRawResourceDataSize : m_rawResourceData.size();
+            EE_ASSERT( rawDataSize > 0 );
 
             #if EE_DEVELOPMENT_TOOLS
             ScopedTimer<PlatformClock> timer( m_pResourceRecord->m_loadTime );
             #endif
 
-            if ( !m_pResourceLoader->Load( GetResourceID(), m_rawResourceData, m_pResourceRecord ) )
+            bool const loadSucceeded = m_pResourceLoader->Load( GetResourceID(), pRawData, rawDataSize, m_pResourceRecord );
+
+            // Release raw data
+            m_rawResourceData.clear();
+            m_pMappedRawResourceData = nullptr;
+            m_mappedRawResourceDataSize = 0;
+
+            if ( !loadSucceeded )
             {
                 EE_LOG_ERROR( "Resource", "Resource Request", "Failed to load compiled resource data (%s)", m_pResourceRecord->GetResourceID().c_str() );
                 m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
@@ -318,9 +380,6 @@ namespace EE::Resource
                 m_stage = ResourceRequest::Stage::Complete;
                 return;
             }
-
-            // Release raw data
-            m_rawResourceData.clear();
         }
 
         // Load dependencies
@@ -336,7 +395,7 @@ namespace EE::Resource
             // Do not use the requester ID for install dependencies! Since they are not explicitly loaded by a specific user!
             // Instead we create a ResourceRequesterID from the depending resource's resourceID
             m_pendingInstallDependencies[i] = ResourcePtr( m_pResourceRecord->m_installDependencyResourceIDs[i] );
-            requestContext.m_loadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i] );
+            requestContext.m_loadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i], GetLoadPriority() );
         }
 
         m_stage = ResourceRequest::Stage::WaitForLoadDependencies;
@@ -599,4 +658,15 @@ namespace EE::Resource
         m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
         m_stage = ResourceRequest::Stage::Complete;
     }
+
+    void ResourceRequest::CancelRawResourceRead( RequestContext& requestContext )
+    {
+        EE_ASSERT( m_stage == ResourceRequest::Stage::CancelRawResourceRead );
+        requestContext.m_cancelRawResourceReadFunction( this );
+        m_rawResourceData.clear();
+        m_pMappedRawResourceData = nullptr;
+        m_mappedRawResourceDataSize = 0;
+        m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
+        m_stage = ResourceRequest::Stage::Complete;
+    }
 }
\ No newline at end of file
@@ -20,6 +20,8 @@ namespace EE::Resource
             // Load Stages
             RequestRawResource,
             WaitForRawResourceRequest,
+            ReadRawResource,
+            WaitForRawResourceRead,
             LoadResource,
             WaitForLoadDependencies,
             InstallResource,
@@ -33,6 +35,7 @@ namespace EE::Resource
             // Special Cases
             CancelWaitForLoadDependencies, // This stage is needed so we can resume correctly when going from load -> unload -> load
             CancelRawResourceRequest,
+            CancelRawResourceRead,
 
             Complete,
         };
@@ -56,7 +59,9 @@ namespace EE::Resource
         {
             TFunction<void( ResourceRequest* )> m_createRawRequestRequestFunction;
             TFunction<void( ResourceRequest* )> m_cancelRawRequestRequestFunction;
-            TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_loadResourceFunction;
+            TFunction<void( ResourceRequest* )> m_readRawResourceFunction;
+            TFunction<void( ResourceRequest* )> m_cancelRawResourceReadFunction;
+            TFunction<void( ResourceRequesterID const&, ResourcePtr&, LoadPriority )> m_loadResourceFunction;
             TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_unloadResourceFunction;
         };
 
@@ -71,12 +76,23 @@ namespace EE::Resource
         inline bool IsLoadRequest() const { return m_type == Type::Load; }
         inline bool IsUnloadRequest() const { return m_type == Type::Unload; }
 
+        // Loading and installing is limited by the per-frame install budget
+        inline bool IsWaitingToLoadOrInstall() const { return m_stage == Stage::LoadResource || m_stage == Stage::InstallResource; }
+
         inline Stage GetStage() const { return m_stage; }
 
         inline ResourceRecord const* GetResourceRecord() const { return m_pResourceRecord; }
+        inline ResourceRecord* GetResourceRecord() { return m_pResourceRecord; }
         inline ResourceID const& GetResourceID() const { return m_pResourceRecord->GetResourceID(); }
         inline ResourceTypeID GetResourceTypeID() const { return m_pResourceRecord->GetResourceTypeID(); }
         inline LoadingStatus GetLoadingStatus() const { return m_pResourceRecord->GetLoadingStatus(); }
+        inline LoadPriority GetLoadPriority() const { return m_pResourceRecord->GetLoadPriority(); }
+
+        // The location of the raw data, only valid once the raw resource request has completed
+        inline FileSystem::Path const& GetRawResourcePath() const { return m_rawResourcePath; }
+        inline uint8_t const* GetMappedRawResourceData() const { return m_pMappedRawResourceData; }
+        inline size_t GetMappedRawResourceDataSize() const { return m_mappedRawResourceDataSize; }
+        inline size_t GetRawResourceDataSize() const { return ( m_pMappedRawResourceData != nullptr ) ? m_mappedRawResourceDataSize : m_rawResourceData.size(); }
 
         inline bool operator==( ResourceRequest const& other ) const { return GetResourceID() == other.GetResourceID(); }
         inline bool operator!=( ResourceRequest const& other ) const { return GetResourceID() != other.GetResourceID(); }
@@ -89,6 +105,13 @@ namespace EE::Resource
         // Called by the resource provider once the request operation completes and provides the raw resource data
         void OnRawResourceRequestComplete( String const& filePath );
 
+        // Called by the resource provider once the request operation completes, when the compiled data is already resident in memory (i.e. a memory mapped package)
+        // The data needs to remain valid until the resource has been loaded
+        void OnRawResourceRequestComplete( uint8_t const* pRawData, size_t rawDataSize );
+
+        // Called by the I/O queue once the raw data has been read, the data will be moved out of the supplied blob
+        void OnRawResourceReadComplete( bool wasSuccessful, Blob& rawData, Milliseconds readTime );
+
         // This will interrupt a load task and convert it into an unload task
         void SwitchToLoadTask();
 
@@ -98,6 +121,7 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         void RequestRawResource( RequestContext& requestContext );
+        void ReadRawResource( RequestContext& requestContext );
         void LoadResource( RequestContext& requestContext );
         void WaitForLoadDependencies( RequestContext& requestContext );
         void InstallResource( RequestContext& requestContext );
@@ -106,6 +130,7 @@ namespace EE::Resource
         void UnloadResource( RequestContext& requestContext );
         void UnloadFailedResource( RequestContext& requestContext );
         void CancelRawRequestRequest( RequestContext& requestContext );
+        void CancelRawResourceRead( RequestContext& requestContext );
 
     private:
 
@@ -114,6 +139,8 @@ namespace EE::Resource
         ResourceLoader*                         m_pResourceLoader = nullptr;
         FileSystem::Path                        m_rawResourcePath;
         Blob                                    m_rawResourceData;
+        uint8_t const*                          m_pMappedRawResourceData = nullptr;
+        size_t                                  m_mappedRawResourceDataSize = 0;
         InstallDependencyList                   m_pendingInstallDependencies;
         InstallDependencyList                   m_installDependencies;
         Type                                    m_type = Type::Invalid;
@@ -34,6 +34,26 @@ namespace EE::Resource
             return false;
         }
 
+        // Streaming budget - optional, unlimited if not set
+        float maxInstallTime = 0.0f;
+        if ( ini.TryGetFloat( "Resource:MaxInstallTimePerFrame", maxInstallTime ) )
+        {
+            m_maxInstallTimePerFrame = Math::Max( maxInstallTime, 0.0f );
+        }
+
+        uint32_t maxInstallKB = 0;
+        if ( ini.TryGetUInt( "Resource:MaxInstallKBPerFrame", maxInstallKB ) )
+        {
+            m_maxInstallBytesPerFrame = maxInstallKB * 1024;
+        }
+
+        // Unreferenced resource cache - optional, disabled if not set
+        uint32_t unreferencedCacheBudgetMB = 0;
+        if ( ini.TryGetUInt( "Resource:UnreferencedCacheBudgetMB", unreferencedCacheBudgetMB ) )
+        {
+            m_unreferencedCacheBudget = size_t( unreferencedCacheBudgetMB ) * 1024 * 1024;
+        }
+
         // Development only settings
         //-------------------------------------------------------------------------
 
@@ -3,6 +3,7 @@
 #include "System/_Module/API.h"
 #include "System/Math/Math.h"
 #include "System/FileSystem/FileSystemPath.h"
+#include "System/Time/Time.h"
 
 //-------------------------------------------------------------------------
 
@@ -22,6 +23,9 @@ namespace EE::Resource
 
         FileSystem::Path        m_workingDirectoryPath;
         FileSystem::Path        m_compiledResourcePath;
+        Milliseconds            m_maxInstallTimePerFrame = 0.0f;       // The max time spent loading and installing resources per update, 0 means unlimited
+        uint32_t                m_maxInstallBytesPerFrame = 0;         // The max amount of compiled data loaded per update, 0 means unlimited
+        size_t                  m_unreferencedCacheBudget = 0;         // The max size of unreferenced resources kept loaded in case they are requested again, 0 disables the cache
 
         #if EE_DEVELOPMENT_TOOLS
         FileSystem::Path        m_packagedBuildCompiledResourcePath;
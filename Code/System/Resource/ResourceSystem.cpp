@@ -1,7 +1,9 @@
 #include "ResourceSystem.h"
 #include "ResourceProvider.h"
 #include "ResourceRequest.h"
+#include "ResourceSettings.h"
 #include "System/Profiling.h"
+#include <eastl/sort.h>
 
 //-------------------------------------------------------------------------
 
@@ -26,11 +28,22 @@ namespace EE::Resource
     {
         EE_ASSERT( pResourceProvider != nullptr && pResourceProvider->IsReady() );
         m_pResourceProvider = pResourceProvider;
+        m_unreferencedCacheBudget = GetSettings().m_unreferencedCacheBudget;
+        m_ioQueue.Initialize();
     }
 
     void ResourceSystem::Shutdown()
     {
+        // Disable the cache and release everything in it, this ensures that any install dependencies released by the evicted resources are unloaded immediately
+        {
+            Threading::RecursiveScopeLock lock( m_accessLock );
+            m_unreferencedCacheBudget = 0;
+            EvictUnreferencedResources( true );
+        }
+
         WaitForAllRequestsToComplete();
+        EE_ASSERT( m_unreferencedResources.empty() );
+        m_ioQueue.Shutdown();
         m_pResourceProvider = nullptr;
     }
 
@@ -51,6 +64,11 @@ namespace EE::Resource
             return true;
         }
 
+        if ( m_ioQueue.IsBusy() )
+        {
+            return true;
+        }
+
         return false;
     }
 
@@ -146,7 +164,7 @@ namespace EE::Resource
         return recordIter->second;
     }
 
-    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID )
+    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID, LoadPriority priority )
     {
         Threading::RecursiveScopeLock lock( m_accessLock );
 
@@ -158,10 +176,18 @@ namespace EE::Resource
 
         if ( !pRecord->HasReferences() )
         {
+            // The resource is still loaded, so there is nothing to do other than take it out of the cache
+            if ( pRecord->m_isCached )
+            {
+                RemoveFromUnreferencedCache( pRecord );
+                m_numCacheHits++;
+            }
+
             AddPendingRequest( PendingRequest( PendingRequest::Type::Load, pRecord, requesterID ) );
         }
 
-        pRecord->AddReference( requesterID );
+        // This will raise the priority of the record if this request is more urgent than the existing ones
+        pRecord->AddReference( requesterID, priority );
     }
 
     void ResourceSystem::UnloadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID )
@@ -178,7 +204,15 @@ namespace EE::Resource
 
         if ( !pRecord->HasReferences() )
         {
-            AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+            // Rather than unloading immediately, keep the resource loaded for as long as the cache budget allows since it is likely to be requested again
+            if ( CanCacheUnreferencedResource( pRecord ) )
+            {
+                AddToUnreferencedCache( pRecord );
+            }
+            else
+            {
+                AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+            }
         }
     }
 
@@ -218,6 +252,144 @@ namespace EE::Resource
         return nullptr;
     }
 
+    #if EE_DEVELOPMENT_TOOLS
+    void ResourceSystem::FlagResourceForHotReload( ResourceRecord* pResourceRecord )
+    {
+        EE_ASSERT( pResourceRecord != nullptr );
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        pResourceRecord->m_isHotReloadRequested = true;
+
+        // Any resource that installed with the old data also needs to be reloaded
+        for ( auto const& requesterID : pResourceRecord->m_references )
+        {
+            if ( requesterID.IsInstallDependencyRequest() )
+            {
+                uint32_t const resourcePathID( requesterID.GetInstallDependencyResourcePathID() );
+                auto const recordIter = m_resourceRecords.find_as( resourcePathID );
+                EE_ASSERT( recordIter != m_resourceRecords.end() );
+                FlagResourceForHotReload( recordIter->second );
+            }
+        }
+    }
+    #endif
+
+    //-------------------------------------------------------------------------
+
+    bool ResourceSystem::CanCacheUnreferencedResource( ResourceRecord const* pResourceRecord ) const
+    {
+        EE_ASSERT( pResourceRecord != nullptr && !pResourceRecord->HasReferences() && !pResourceRecord->m_isCached );
+
+        // Only fully loaded resources can be cached, anything else needs to go through the normal unload path to cancel/clean up the request
+        if ( m_unreferencedCacheBudget == 0 || !pResourceRecord->IsLoaded() )
+        {
+            return false;
+        }
+
+        // A resource larger than the whole budget would just evict everything else
+        if ( pResourceRecord->m_residentSize > m_unreferencedCacheBudget )
+        {
+            return false;
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        if ( pResourceRecord->m_isHotReloadRequested )
+        {
+            return false;
+        }
+        #endif
+
+        return true;
+    }
+
+    void ResourceSystem::AddToUnreferencedCache( ResourceRecord* pResourceRecord )
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+        EE_ASSERT( pResourceRecord != nullptr && !pResourceRecord->m_isCached );
+
+        pResourceRecord->m_isCached = true;
+        m_unreferencedResources.emplace_back( pResourceRecord );
+        m_unreferencedCacheSize += pResourceRecord->m_residentSize;
+
+        auto& stats = m_residentMemoryStats[pResourceRecord->GetResourceTypeID()];
+        stats.m_cachedBytes += pResourceRecord->m_residentSize;
+        stats.m_numCached++;
+    }
+
+    void ResourceSystem::RemoveFromUnreferencedCache( ResourceRecord* pResourceRecord )
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+        EE_ASSERT( pResourceRecord != nullptr && pResourceRecord->m_isCached );
+
+        auto iter = eastl::find( m_unreferencedResources.begin(), m_unreferencedResources.end(), pResourceRecord );
+        EE_ASSERT( iter != m_unreferencedResources.end() );
+        m_unreferencedResources.erase( iter );
+
+        pResourceRecord->m_isCached = false;
+        EE_ASSERT( m_unreferencedCacheSize >= pResourceRecord->m_residentSize );
+        m_unreferencedCacheSize -= pResourceRecord->m_residentSize;
+
+        auto& stats = m_residentMemoryStats[pResourceRecord->GetResourceTypeID()];
+        stats.m_cachedBytes -= pResourceRecord->m_residentSize;
+        stats.m_numCached--;
+    }
+
+    void ResourceSystem::EvictUnreferencedResources( bool evictAll )
+    {
+        Threading::RecursiveScopeLock lock( m_accessLock );
+
+        // The cache is ordered by release time, so we always evict from the front
+        int32_t numToEvict = 0;
+        size_t remainingCacheSize = m_unreferencedCacheSize;
+        while ( numToEvict < (int32_t) m_unreferencedResources.size() && ( evictAll || remainingCacheSize > m_unreferencedCacheBudget ) )
+        {
+            remainingCacheSize -= m_unreferencedResources[numToEvict]->m_residentSize;
+            numToEvict++;
+        }
+
+        for ( int32_t i = 0; i < numToEvict; i++ )
+        {
+            ResourceRecord* pRecord = m_unreferencedResources[i];
+            pRecord->m_isCached = false;
+
+            auto& stats = m_residentMemoryStats[pRecord->GetResourceTypeID()];
+            stats.m_cachedBytes -= pRecord->m_residentSize;
+            stats.m_numCached--;
+
+            AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, ResourceRequesterID() ) );
+        }
+
+        m_unreferencedResources.erase( m_unreferencedResources.begin(), m_unreferencedResources.begin() + numToEvict );
+        m_unreferencedCacheSize = remainingCacheSize;
+        m_numCacheEvictions += numToEvict;
+    }
+
+    void ResourceSystem::UpdateMemoryAccounting( ResourceRecord* pResourceRecord )
+    {
+        EE_ASSERT( pResourceRecord != nullptr );
+
+        size_t const residentSize = pResourceRecord->IsLoaded() ? pResourceRecord->m_residentSize : 0;
+        if ( residentSize == pResourceRecord->m_accountedSize )
+        {
+            return;
+        }
+
+        auto& stats = m_residentMemoryStats[pResourceRecord->GetResourceTypeID()];
+        EE_ASSERT( stats.m_residentBytes >= pResourceRecord->m_accountedSize );
+        stats.m_residentBytes = stats.m_residentBytes - pResourceRecord->m_accountedSize + residentSize;
+
+        if ( pResourceRecord->m_accountedSize == 0 )
+        {
+            stats.m_numResident++;
+        }
+        else if ( residentSize == 0 )
+        {
+            stats.m_numResident--;
+        }
+
+        pResourceRecord->m_accountedSize = residentSize;
+    }
+
     //-------------------------------------------------------------------------
 
     void ResourceSystem::UpdateResourceProvider()
@@ -269,6 +441,16 @@ namespace EE::Resource
         {
             Threading::RecursiveScopeLock lock( m_accessLock );
 
+            // Hand completed reads back to their requests and issue any newly queued reads
+            // This needs to happen before we process the pending requests, since delivering a read changes the request stage
+            m_ioQueue.Update();
+
+            // Release the least recently used unreferenced resources if we are over budget, this queues pending unload requests so needs to happen before we process them
+            if ( m_unreferencedCacheSize > m_unreferencedCacheBudget )
+            {
+                EvictUnreferencedResources();
+            }
+
             for ( auto& pendingRequest : m_pendingRequests )
             {
                 // Get existing active request
@@ -290,6 +472,11 @@ namespace EE::Resource
                     }
                     else // Create new request
                     {
+                        // We are reading the resource from disk again, so any hot-reload has now been handled
+                        #if EE_DEVELOPMENT_TOOLS
+                        pendingRequest.m_pRecord->m_isHotReloadRequested = false;
+                        #endif
+
                         auto loaderIter = m_resourceLoaders.find( pendingRequest.m_pRecord->GetResourceTypeID() );
                         EE_ASSERT( loaderIter != m_resourceLoaders.end() );
                         m_activeRequests.emplace_back( EE::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Load, pendingRequest.m_pRecord, loaderIter->second ) );
@@ -311,6 +498,7 @@ namespace EE::Resource
                             auto recordIter = m_resourceRecords.find( pendingRequest.m_pRecord->m_resourceID );
                             EE_ASSERT( recordIter != m_resourceRecords.end() );
                             EE_ASSERT( recordIter->second == pendingRequest.m_pRecord );
+                            EE_ASSERT( !pendingRequest.m_pRecord->m_isCached );
 
                             EE::Delete( pendingRequest.m_pRecord );
                             m_resourceRecords.erase( recordIter );
@@ -339,6 +527,8 @@ namespace EE::Resource
                 m_history.emplace_back( CompletedRequestLog( pCompletedRequest->IsLoadRequest() ? PendingRequest::Type::Load : PendingRequest::Type::Unload, resourceID ) );
                 #endif
 
+                UpdateMemoryAccounting( pCompletedRequest->GetResourceRecord() );
+
                 if ( pCompletedRequest->IsUnloadRequest() )
                 {
                     // Check if we can remove the record, we may have had a load request for it in the meantime
@@ -347,6 +537,7 @@ namespace EE::Resource
                         auto recordIter = m_resourceRecords.find( resourceID );
                         EE_ASSERT( recordIter != m_resourceRecords.end() );
                         EE_ASSERT( recordIter->second == pCompletedRequest->GetResourceRecord() );
+                        EE_ASSERT( !recordIter->second->m_isCached );
 
                         EE::Delete( recordIter->second );
                         m_resourceRecords.erase( recordIter );
@@ -382,25 +573,57 @@ namespace EE::Resource
     {
         EE_PROFILE_FUNCTION_RESOURCE();
 
+        ResourceRequest::RequestContext context;
+        context.m_createRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->RequestRawResource( pRequest ); };
+        context.m_cancelRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->CancelRequest( pRequest ); };
+        context.m_readRawResourceFunction = [this] ( ResourceRequest* pRequest ) { m_ioQueue.QueueRead( pRequest ); };
+        context.m_cancelRawResourceReadFunction = [this] ( ResourceRequest* pRequest ) { m_ioQueue.CancelRead( pRequest ); };
+        context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr, LoadPriority priority ) { LoadResource( resourcePtr, requesterID, priority ); };
+        context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
+
+        // Process the most urgent requests first so that they get the install budget, requests of the same priority are processed in the order they were made
         //-------------------------------------------------------------------------
 
-        // We dont have to worry about this loop even if the m_activeRequests array is modified from another thread since we only access the array in 2 places and both use locks
-        for ( int32_t i = (int32_t) m_activeRequests.size() - 1; i >= 0; i-- )
-        {
-            ResourceRequest::RequestContext context;
-            context.m_createRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->RequestRawResource( pRequest ); };
-            context.m_cancelRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->CancelRequest( pRequest ); };
-            context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { LoadResource( resourcePtr, requesterID ); };
-            context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
+        auto Comparator = [] ( ResourceRequest const* pA, ResourceRequest const* pB ) { return pA->GetLoadPriority() < pB->GetLoadPriority(); };
+        eastl::stable_sort( m_activeRequests.begin(), m_activeRequests.end(), Comparator );
 
-            //-------------------------------------------------------------------------
+        ResourceSettings const& settings = GetSettings();
+        Milliseconds installTime = 0.0f;
+        size_t installBytes = 0;
+        m_numDeferredInstalls = 0;
+
+        //-------------------------------------------------------------------------
 
+        // We dont have to worry about this loop even if the m_activeRequests array is modified from another thread since we only access the array in 2 places and both use locks
+        for ( int32_t i = 0; i < (int32_t) m_activeRequests.size(); i++ )
+        {
             bool isRequestComplete = false;
 
             ResourceRequest* pRequest = m_activeRequests[i];
             if ( pRequest->IsActive() )
             {
-                isRequestComplete = pRequest->Update( context );
+                if ( pRequest->IsWaitingToLoadOrInstall() )
+                {
+                    // Defer the remaining loads/installs to the next update once we have exhausted the budget, critical requests are never deferred
+                    bool const isOverTimeBudget = settings.m_maxInstallTimePerFrame > 0.0f && installTime >= settings.m_maxInstallTimePerFrame;
+                    bool const isOverByteBudget = settings.m_maxInstallBytesPerFrame > 0 && installBytes >= settings.m_maxInstallBytesPerFrame;
+                    if ( ( isOverTimeBudget || isOverByteBudget ) && pRequest->GetLoadPriority() != LoadPriority::Critical )
+                    {
+                        m_numDeferredInstalls++;
+                        continue;
+                    }
+
+                    // The raw data is released once the resource is loaded, so for installs we use the size of the loaded data
+                    installBytes += ( pRequest->GetStage() == ResourceRequest::Stage::LoadResource ) ? pRequest->GetRawResourceDataSize() : pRequest->GetResourceRecord()->GetResidentSize();
+
+                    Timer<PlatformClock> timer;
+                    isRequestComplete = pRequest->Update( context );
+                    installTime += timer.GetElapsedTimeMilliseconds();
+                }
+                else
+                {
+                    isRequestComplete = pRequest->Update( context );
+                }
             }
             else
             {
@@ -413,7 +636,8 @@ namespace EE::Resource
             {
                 // We need to process and remove completed requests at the next update stage since unload task may have queued unload requests which refer to the request's allocated memory
                 m_completedRequests.emplace_back( pRequest );
-                m_activeRequests.erase_unsorted( m_activeRequests.begin() + i );
+                m_activeRequests.erase( m_activeRequests.begin() + i );
+                i--;
             }
         }
     }
@@ -436,6 +660,11 @@ namespace EE::Resource
         ResourceRecord* pRecord = recordIter->second;
         GetUsersForResource( pRecord, m_usersThatRequireReload );
 
+        // Flush the cache, since the unreferenced resources may have been using the old data either directly or via an install dependency
+        // The updated resource and everything that depends on it is flagged so that it doesnt get cached again once its users release it
+        FlagResourceForHotReload( pRecord );
+        EvictUnreferencedResources( true );
+
         // Add to list of resources to be reloaded
         m_externallyUpdatedResources.emplace_back( resourceID );
     }
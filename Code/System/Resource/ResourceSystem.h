@@ -2,6 +2,7 @@
 
 #include "System/_Module/API.h"
 #include "ResourcePtr.h"
+#include "ResourceIOQueue.h"
 #include "System/Threading/Threading.h"
 #include "System/Threading/TaskSystem.h"
 #include "System/Systems.h"
@@ -64,6 +65,15 @@ namespace EE::Resource
 
         EE_SYSTEM_ID( ResourceSystem );
 
+        // Memory accounting for a single resource type
+        struct ResidentMemoryStats
+        {
+            size_t                  m_residentBytes = 0;    // The size of all loaded resources of this type (including cached ones)
+            size_t                  m_cachedBytes = 0;      // The size of all unreferenced resources of this type that are kept loaded by the cache
+            int32_t                 m_numResident = 0;
+            int32_t                 m_numCached = 0;
+        };
+
     public:
 
         ResourceSystem( TaskSystem& taskSystem );
@@ -93,13 +103,14 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         // Request a load of a resource, can optionally provide a ResourceRequesterID for identification of the request source
-        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
+        // If the resource is already requested, the request will be upgraded to the supplied priority if it is more urgent
+        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), LoadPriority priority = LoadPriority::Normal );
 
         // Request an unload of a resource, can optionally provide a ResourceRequesterID for identification of the request source
         void UnloadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
 
         template<typename T>
-        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID ); }
+        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), LoadPriority priority = LoadPriority::Normal ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID, priority ); }
 
         template<typename T>
         inline void UnloadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { UnloadResource( (ResourcePtr&) resourcePtr, requesterID ); }
@@ -134,9 +145,25 @@ namespace EE::Resource
         // Returns a list of all unique external references for the given resource
         void GetUsersForResource( ResourceRecord const* pResourceRecord, TVector<ResourceRequesterID>& requesterIDs ) const;
 
+        #if EE_DEVELOPMENT_TOOLS
+        // Flag the resource and every resource that depends on it (via install dependencies) as needing to be reloaded, flagged resources are not cached
+        void FlagResourceForHotReload( ResourceRecord* pResourceRecord );
+        #endif
+
         // Process all queued resource requests
         void ProcessResourceRequests();
 
+        // Unreferenced resource cache
+        bool CanCacheUnreferencedResource( ResourceRecord const* pResourceRecord ) const;
+        void AddToUnreferencedCache( ResourceRecord* pResourceRecord );
+        void RemoveFromUnreferencedCache( ResourceRecord* pResourceRecord );
+
+        // Queue unloads for the least recently released resources until the cache is within budget (or empty if 'evictAll' is set)
+        void EvictUnreferencedResources( bool evictAll = false );
+
+        // Update the per-type memory stats to reflect the current state of the record
+        void UpdateMemoryAccounting( ResourceRecord* pResourceRecord );
+
     private:
 
         TaskSystem&                                             m_taskSystem;
@@ -153,6 +180,16 @@ namespace EE::Resource
         // ASync
         AsyncTask                                               m_asyncProcessingTask;
         std::atomic<bool>                                       m_isAsyncTaskRunning = false;
+        ResourceIOQueue                                         m_ioQueue;
+        int32_t                                                 m_numDeferredInstalls = 0;  // The number of loads/installs deferred to the next update due to the install budget
+
+        // Memory
+        THashMap<ResourceTypeID, ResidentMemoryStats>           m_residentMemoryStats;
+        TVector<ResourceRecord*>                                m_unreferencedResources;    // Loaded resources without any references, ordered from least to most recently released
+        size_t                                                  m_unreferencedCacheBudget = 0;     // Only counts the cached resources themselves, not the install dependencies they keep loaded
+        size_t                                                  m_unreferencedCacheSize = 0;
+        uint32_t                                                m_numCacheHits = 0;
+        uint32_t                                                m_numCacheEvictions = 0;
 
         #if EE_DEVELOPMENT_TOOLS
         TVector<ResourceRequesterID>                            m_usersThatRequireReload;